@@ -16,12 +16,18 @@
 #include "panels/AtmosphericPanel.hpp"
 #include "panels/SensorPanel.hpp"
 #include "panels/DisplayEnhancementPanel.hpp"
+#include "panels/FrameStatsPanel.hpp"
 #include "config/ConfigManager.hpp"
 #include "editing/SelectionManager.hpp"
 #include "editing/TransformGizmo.hpp"
 #include "editing/UndoStack.hpp"
 #include "editing/Commands.hpp"
+#include "editing/ScenePicker.hpp"
 #include "dialogs/SettingsDialog.hpp"
+#include "export/ImageExportQueue.hpp"
+#include "export/SequenceCapture.hpp"
+#include "dialogs/SequenceCaptureDialog.hpp"
+#include "StartupTrace.hpp"
 
 #include <QApplication>
 #include <QGuiApplication>
@@ -33,6 +39,7 @@
 #include <QTabWidget>
 #include <QStatusBar>
 #include <QProgressBar>
+#include <QToolButton>
 #include <QLabel>
 #include <QFileDialog>
 #include <QMessageBox>
@@ -41,14 +48,16 @@
 #include <QVBoxLayout>
 #include <QFileInfo>
 #include <QSettings>
+#include <QSignalBlocker>
 #include <QDebug>
 #include <QDateTime>
 #include <QDir>
 #include <QStandardPaths>
+#include <QTimer>
+#include <QPointer>
 
 #include <core/Types.hpp>
 #include <core/Image.hpp>
-#include <io/ImageIO.hpp>
 #include <scene/Material.hpp>
 #include <scene/Scene.hpp>
 #include <renderer/LightingParams.hpp>
@@ -56,6 +65,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <cmath>
+#include <algorithm>
 
 MainWindow::MainWindow(QVulkanInstance* vulkanInstance, QWidget* parent)
     : QMainWindow(parent)
@@ -68,6 +78,18 @@ MainWindow::MainWindow(QVulkanInstance* vulkanInstance, QWidget* parent)
     // Create configuration manager
     m_configManager = new ConfigManager(this);
 
+    // Background image export
+    m_exportQueue = new ImageExportQueue(this);
+    connect(m_exportQueue, &ImageExportQueue::exportFinished,
+            this, [this](quint64 jobId, const QString& label,
+                         const QStringList& written, const QStringList& failed) {
+                // Sequence frames report through their own progress
+                if (!m_sequenceCapture || label != m_sequenceCapture->exportLabel()) {
+                    onImageExportFinished(jobId, label, written, failed);
+                }
+            });
+    m_sequenceCapture = new SequenceCapture(m_exportQueue, this);
+
     setupUi();
     setupMenus();
     setupDockWidgets();
@@ -140,6 +162,7 @@ void MainWindow::setupMenus() {
 
     // View menu
     QMenu* viewMenu = menuBar()->addMenu(tr("&View"));
+    m_viewMenu = viewMenu;
     viewMenu->addAction(tr("&Reset Camera"), this, &MainWindow::onResetCamera);
     viewMenu->addSeparator();
 
@@ -147,8 +170,13 @@ void MainWindow::setupMenus() {
     QAction* screenshotAction = viewMenu->addAction(tr("Take &Screenshot"), this, &MainWindow::onTakeScreenshot);
     screenshotAction->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_S));
 
+    // PNG of the presented frame via async readback (does not stall the viewport)
+    QAction* quickCaptureAction = viewMenu->addAction(tr("&Quick Capture (PNG)"), this, &MainWindow::onQuickCapture);
+    quickCaptureAction->setShortcut(QKeySequence(Qt::Key_F12));
+
     viewMenu->addSeparator();
     viewMenu->addAction(tr("&Parameter Panel"))->setCheckable(true);
+    // Frame statistics toggle is added with its dock in setupDockWidgets()
 
     // Render menu
     QMenu* renderMenu = menuBar()->addMenu(tr("&Render"));
@@ -159,6 +187,18 @@ void MainWindow::setupMenus() {
     QAction* stopRenderAction = renderMenu->addAction(tr("S&top Render"), this, &MainWindow::onStopRender);
     stopRenderAction->setShortcut(QKeySequence(Qt::Key_Escape));
 
+    m_pauseRenderAction = renderMenu->addAction(tr("&Pause Render"));
+    m_pauseRenderAction->setShortcut(QKeySequence(Qt::Key_F6));
+    m_pauseRenderAction->setCheckable(true);
+    m_pauseRenderAction->setEnabled(false);
+    connect(m_pauseRenderAction, &QAction::toggled, this, &MainWindow::onPauseRender);
+
+    renderMenu->addSeparator();
+    m_recordSequenceAction = renderMenu->addAction(tr("Record Image &Sequence..."));
+    m_recordSequenceAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_R));
+    m_recordSequenceAction->setCheckable(true);
+    connect(m_recordSequenceAction, &QAction::triggered, this, &MainWindow::onRecordSequence);
+
     // Settings menu
     QMenu* settingsMenu = menuBar()->addMenu(tr("&Settings"));
 
@@ -200,6 +240,13 @@ void MainWindow::setupMenus() {
     // Help menu
     QMenu* helpMenu = menuBar()->addMenu(tr("&Help"));
     helpMenu->addAction(tr("&About"), this, &MainWindow::onAbout);
+    helpMenu->addAction(tr("&Startup Timing"), this, [this]() {
+        const QString report = StartupTrace::report();
+        QMessageBox::information(this, tr("Startup Timing"),
+            report.isEmpty() ? tr("No startup trace recorded.")
+                             : tr("Time since launch (set QUANTILOOM_STARTUP_TRACE to a file "
+                                  "path to save it as a Chrome trace):\n\n%1").arg(report));
+    });
     helpMenu->addAction(tr("About &Qt"), qApp, &QApplication::aboutQt);
 }
 
@@ -212,94 +259,293 @@ void MainWindow::setupDockWidgets() {
     // Create tabbed widget for different parameter categories
     m_parameterTabs = new QTabWidget();
 
-    // Create panel instances
-    m_sceneTreePanel = new SceneTreePanel();
-    m_materialEditorPanel = new MaterialEditorPanel();
-    m_lightingPanel = new LightingPanel();
-    m_renderSettingsPanel = new RenderSettingsPanel();
-    m_spectralConfigPanel = new SpectralConfigPanel();
-    m_debugVisualizationPanel = new DebugVisualizationPanel();
-    m_atmosphericPanel = new AtmosphericPanel();
-    m_sensorPanel = new SensorPanel();
-    m_displayEnhancementPanel = new DisplayEnhancementPanel();
-
-    // Add panels to tabs
-    m_parameterTabs->addTab(m_sceneTreePanel, tr("Scene"));
-    m_parameterTabs->addTab(m_materialEditorPanel, tr("Material"));
-    m_parameterTabs->addTab(m_lightingPanel, tr("Lighting"));
-    m_parameterTabs->addTab(m_atmosphericPanel, tr("Atmosphere"));
-    m_parameterTabs->addTab(m_sensorPanel, tr("Sensor"));
-    m_parameterTabs->addTab(m_renderSettingsPanel, tr("Render"));
-    m_parameterTabs->addTab(m_spectralConfigPanel, tr("Spectral"));
-    m_parameterTabs->addTab(m_displayEnhancementPanel, tr("Display"));
-    m_parameterTabs->addTab(m_debugVisualizationPanel, tr("Debug"));
+    // Only the current tab's panel is built now; the others on first use
+    // (tab switch, config import, ...) or once the first frame is on screen
+    addPanelTab(PanelTab::Scene, tr("Scene"));
+    addPanelTab(PanelTab::Material, tr("Material"));
+    addPanelTab(PanelTab::Lighting, tr("Lighting"));
+    addPanelTab(PanelTab::Atmosphere, tr("Atmosphere"));
+    addPanelTab(PanelTab::Sensor, tr("Sensor"));
+    addPanelTab(PanelTab::Render, tr("Render"));
+    addPanelTab(PanelTab::Spectral, tr("Spectral"));
+    addPanelTab(PanelTab::Display, tr("Display"));
+    addPanelTab(PanelTab::Debug, tr("Debug"));
+    connect(m_parameterTabs, &QTabWidget::currentChanged, this, [this](int index) {
+        if (index >= 0) {
+            ensurePanel(static_cast<PanelTab>(index));
+        }
+    });
+    ensurePanel(static_cast<PanelTab>(m_parameterTabs->currentIndex()));
 
     m_parameterDock->setWidget(m_parameterTabs);
     addDockWidget(Qt::LeftDockWidgetArea, m_parameterDock);
 
-    // Connect panel signals
-    connect(m_sceneTreePanel, &SceneTreePanel::nodeSelected,
-            this, [this](int nodeIndex) {
-                // Sync with selection manager
-                bool addToSelection = QGuiApplication::keyboardModifiers() & Qt::ControlModifier;
-                m_selectionManager->select(nodeIndex, addToSelection);
-            });
-    connect(m_sceneTreePanel, &SceneTreePanel::materialSelected,
-            this, &MainWindow::onMaterialSelected);
+    // Frame statistics dock: hidden by default, polled only while visible
+    m_frameStatsDock = new QDockWidget(tr("Frame Statistics"), this);
+    m_frameStatsDock->setObjectName("FrameStatsDock");
+    m_frameStatsDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+    m_frameStatsPanel = new FrameStatsPanel();
+    m_frameStatsDock->setWidget(m_frameStatsPanel);
+    addDockWidget(Qt::RightDockWidgetArea, m_frameStatsDock);
+    m_frameStatsDock->hide();
+
+    QAction* frameStatsAction = m_frameStatsDock->toggleViewAction();
+    frameStatsAction->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_F));
+    m_viewMenu->addAction(frameStatsAction);
+
+    m_frameStatsTimer = new QTimer(this);
+    m_frameStatsTimer->setInterval(250);
+    connect(m_frameStatsTimer, &QTimer::timeout, this, [this]() {
+        m_frameStatsPanel->setStats(m_vulkanWindow->frameTimingSummary(),
+                                    m_vulkanWindow->parameterQueueStats(),
+                                    m_vulkanWindow->frameSchedulerStats());
+    });
+    connect(m_frameStatsDock, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        if (visible) {
+            m_frameStatsTimer->start();
+        } else {
+            m_frameStatsTimer->stop();
+        }
+    });
+    connect(m_frameStatsPanel, &FrameStatsPanel::resetRequested, this, [this]() {
+        m_vulkanWindow->resetFrameTimings();
+    });
+    connect(m_frameStatsPanel, &FrameStatsPanel::exportRequested,
+            this, &MainWindow::onExportFrameStats);
+}
+
+// ============================================================================
+// Parameter Panels
+// ============================================================================
+
+void MainWindow::addPanelTab(PanelTab tab, const QString& label) {
+    // Placeholder page; the panel is inserted by ensurePanel()
+    auto* page = new QWidget();
+    auto* layout = new QVBoxLayout(page);
+    layout->setContentsMargins(0, 0, 0, 0);
+    m_panelPages[static_cast<size_t>(tab)] = page;
+    m_parameterTabs->insertTab(static_cast<int>(tab), page, label);
+}
+
+void MainWindow::ensurePanel(PanelTab tab) {
+    const auto index = static_cast<size_t>(tab);
+    if (index >= m_panelPages.size() || m_panelBuilt[index]) {
+        return;
+    }
+    m_panelBuilt[index] = true;
+
+    QWidget* panel = nullptr;
+    {
+        StartupTrace::Scope trace(QStringLiteral("Panel: %1")
+            .arg(m_parameterTabs->tabText(static_cast<int>(tab))));
+        panel = createPanel(tab);
+    }
+    m_panelPages[index]->layout()->addWidget(panel);
+}
 
-    connect(m_materialEditorPanel, &MaterialEditorPanel::materialChanged,
-            this, &MainWindow::onMaterialChanged);
+void MainWindow::buildDeferredPanels() {
+    // One panel per event loop pass so input stays responsive
+    for (size_t i = 0; i < m_panelBuilt.size(); ++i) {
+        if (!m_panelBuilt[i]) {
+            ensurePanel(static_cast<PanelTab>(i));
+            QTimer::singleShot(0, this, &MainWindow::buildDeferredPanels);
+            return;
+        }
+    }
+}
+
+QWidget* MainWindow::createPanel(PanelTab tab) {
+    switch (tab) {
+        case PanelTab::Scene:
+            m_sceneTreePanel = new SceneTreePanel();
+            connect(m_sceneTreePanel, &SceneTreePanel::nodeSelected,
+                    this, [this](int nodeIndex) {
+                        // Sync with selection manager
+                        bool addToSelection = QGuiApplication::keyboardModifiers() & Qt::ControlModifier;
+                        m_selectionManager->select(nodeIndex, addToSelection);
+                    });
+            connect(m_sceneTreePanel, &SceneTreePanel::materialSelected,
+                    this, &MainWindow::onMaterialSelected);
+            return m_sceneTreePanel;
+
+        case PanelTab::Material:
+            m_materialEditorPanel = new MaterialEditorPanel();
+            connect(m_materialEditorPanel, &MaterialEditorPanel::materialChanged,
+                    this, &MainWindow::onMaterialChanged);
+            connect(m_materialEditorPanel, &MaterialEditorPanel::editStarted,
+                    this, [this]() { m_undoStack->beginGesture(); });
+            connect(m_materialEditorPanel, &MaterialEditorPanel::editFinished,
+                    this, [this]() { m_undoStack->endGesture(); });
+            return m_materialEditorPanel;
+
+        case PanelTab::Lighting:
+            m_lightingPanel = new LightingPanel();
+            connect(m_lightingPanel, &LightingPanel::lightingChanged,
+                    this, &MainWindow::onLightingChanged);
+            connect(m_lightingPanel, &LightingPanel::editStarted,
+                    this, [this]() { m_undoStack->beginGesture(); });
+            connect(m_lightingPanel, &LightingPanel::editFinished,
+                    this, [this]() { m_undoStack->endGesture(); });
+            return m_lightingPanel;
+
+        case PanelTab::Atmosphere:
+            m_atmosphericPanel = new AtmosphericPanel();
+            connect(m_atmosphericPanel, &AtmosphericPanel::presetChanged,
+                    this, [this](const QString& preset) {
+                        m_vulkanWindow->setAtmosphericPreset(preset);
+                        m_statusLabel->setText(tr("Atmospheric preset: %1").arg(preset));
+                    });
+            return m_atmosphericPanel;
+
+        case PanelTab::Sensor:
+            m_sensorPanel = new SensorPanel();
+            connect(m_sensorPanel, &SensorPanel::enabledChanged,
+                    this, [this](bool enabled) {
+                        m_vulkanWindow->setSensorEnabled(enabled);
+                        m_statusLabel->setText(enabled ? tr("Sensor simulation enabled")
+                                                       : tr("Sensor simulation disabled"));
+                    });
+            connect(m_sensorPanel, &SensorPanel::paramsChanged,
+                    this, [this](const quantiloom::SensorParams& params) {
+                        m_vulkanWindow->setSensorParams(params);
+                        m_statusLabel->setText(tr("Sensor params updated"));
+                    });
+            return m_sensorPanel;
+
+        case PanelTab::Render:
+            m_renderSettingsPanel = new RenderSettingsPanel();
+            connect(m_renderSettingsPanel, &RenderSettingsPanel::sppChanged,
+                    this, &MainWindow::onSppChanged);
+            connect(m_renderSettingsPanel, &RenderSettingsPanel::adaptiveSppChanged,
+                    this, [this](bool enabled, double budgetMs) {
+                        m_vulkanWindow->setAdaptiveSpp(enabled, static_cast<float>(budgetMs));
+                        m_statusLabel->setText(enabled
+                            ? tr("Adaptive SPP: %1 ms budget, up to %2 SPP")
+                                .arg(budgetMs, 0, 'f', 1).arg(m_renderSettingsPanel->spp())
+                            : tr("Adaptive SPP disabled"));
+                    });
+            connect(m_renderSettingsPanel, &RenderSettingsPanel::resetAccumulationRequested,
+                    this, &MainWindow::onResetAccumulation);
+            connect(m_renderSettingsPanel, &RenderSettingsPanel::viewportResolutionChanged,
+                    this, [this](double scale, int fixedHeight) {
+                        RenderResolutionSettings settings;
+                        settings.scale = scale;
+                        settings.fixedHeight = fixedHeight;
+                        m_vulkanWindow->setRenderResolution(settings);
+                    });
+            connect(m_vulkanWindow, &QuantiloomVulkanWindow::renderSizeChanged,
+                    m_renderSettingsPanel, &RenderSettingsPanel::setViewportRenderSize);
+            m_renderSettingsPanel->setViewportRenderSize(m_vulkanWindow->renderSize());
+            connect(m_renderSettingsPanel, &RenderSettingsPanel::convergenceSettingsChanged,
+                    this, [this](bool enabled, double threshold, uint32_t maxSamples) {
+                        ConvergenceSettings settings;
+                        settings.enabled = enabled;
+                        settings.threshold = threshold;
+                        settings.maxSamples = maxSamples;
+                        m_vulkanWindow->setConvergenceSettings(settings);
+                        m_statusLabel->setText(enabled
+                            ? tr("Auto-stop at %1% noise or %2 samples")
+                                .arg(threshold * 100.0, 0, 'f', 2).arg(maxSamples)
+                            : tr("Auto-stop disabled, stopping at %1 samples").arg(maxSamples));
+                    });
+            return m_renderSettingsPanel;
+
+        case PanelTab::Spectral:
+            m_spectralConfigPanel = new SpectralConfigPanel();
+            connect(m_spectralConfigPanel, &SpectralConfigPanel::spectralModeChanged,
+                    this, &MainWindow::onSpectralModeChanged);
+            connect(m_spectralConfigPanel, &SpectralConfigPanel::wavelengthChanged,
+                    this, &MainWindow::onWavelengthChanged);
+            return m_spectralConfigPanel;
+
+        case PanelTab::Display:
+            m_displayEnhancementPanel = new DisplayEnhancementPanel();
+            connect(m_displayEnhancementPanel, &DisplayEnhancementPanel::enhancementChanged,
+                    this, [this](bool enabled, float clipLimit, int tileSize, bool luminanceOnly) {
+                        m_displayEnhancementEnabled = enabled;
+                        m_claheClipLimit = clipLimit;
+                        m_claheTileSize = tileSize;
+                        m_claheLuminanceOnly = luminanceOnly;
+                        // Update renderer with CLAHE settings
+                        m_vulkanWindow->setDisplayEnhancement(enabled, clipLimit, tileSize, luminanceOnly);
+                        m_statusLabel->setText(enabled
+                            ? tr("Display enhancement enabled (CLAHE: clip=%1, tiles=%2x%2)")
+                                .arg(clipLimit, 0, 'f', 1).arg(tileSize)
+                            : tr("Display enhancement disabled"));
+                    });
+            return m_displayEnhancementPanel;
+
+        case PanelTab::Debug:
+            m_debugVisualizationPanel = new DebugVisualizationPanel();
+            connect(m_debugVisualizationPanel, &DebugVisualizationPanel::debugModeChanged,
+                    this, &MainWindow::onDebugModeChanged);
+            connect(m_debugVisualizationPanel, &DebugVisualizationPanel::probeSizeChanged,
+                    m_vulkanWindow, &QuantiloomVulkanWindow::setHoverProbeSize);
+            connect(m_debugVisualizationPanel, &DebugVisualizationPanel::roiSelectRequested,
+                    m_vulkanWindow, &QuantiloomVulkanWindow::setRoiSelectMode);
+            connect(m_debugVisualizationPanel, &DebugVisualizationPanel::roiCleared,
+                    this, [this]() { m_vulkanWindow->setRoi(QRect()); });
+            connect(m_debugVisualizationPanel, &DebugVisualizationPanel::roiChannelChanged,
+                    m_vulkanWindow, &QuantiloomVulkanWindow::setRoiChannel);
+
+            // Region statistics (selection is armed from the debug panel)
+            connect(m_vulkanWindow, &QuantiloomVulkanWindow::roiSelectModeChanged,
+                    m_debugVisualizationPanel, &DebugVisualizationPanel::setRoiSelecting);
+            connect(m_vulkanWindow, &QuantiloomVulkanWindow::roiChanged,
+                    m_debugVisualizationPanel, &DebugVisualizationPanel::setRoiRegion);
+            connect(m_vulkanWindow, &QuantiloomVulkanWindow::roiStatisticsUpdated,
+                    m_debugVisualizationPanel, &DebugVisualizationPanel::setRoiStats);
+            return m_debugVisualizationPanel;
+
+        case PanelTab::Count:
+            break;
+    }
+    return nullptr;
+}
 
-    connect(m_lightingPanel, &LightingPanel::lightingChanged,
-            this, &MainWindow::onLightingChanged);
+SceneTreePanel* MainWindow::sceneTreePanel() {
+    ensurePanel(PanelTab::Scene);
+    return m_sceneTreePanel;
+}
 
-    connect(m_renderSettingsPanel, &RenderSettingsPanel::sppChanged,
-            this, &MainWindow::onSppChanged);
-    connect(m_renderSettingsPanel, &RenderSettingsPanel::resetAccumulationRequested,
-            this, &MainWindow::onResetAccumulation);
+MaterialEditorPanel* MainWindow::materialEditorPanel() {
+    ensurePanel(PanelTab::Material);
+    return m_materialEditorPanel;
+}
 
-    connect(m_spectralConfigPanel, &SpectralConfigPanel::spectralModeChanged,
-            this, &MainWindow::onSpectralModeChanged);
-    connect(m_spectralConfigPanel, &SpectralConfigPanel::wavelengthChanged,
-            this, &MainWindow::onWavelengthChanged);
+LightingPanel* MainWindow::lightingPanel() {
+    ensurePanel(PanelTab::Lighting);
+    return m_lightingPanel;
+}
 
-    connect(m_debugVisualizationPanel, &DebugVisualizationPanel::debugModeChanged,
-            this, &MainWindow::onDebugModeChanged);
+AtmosphericPanel* MainWindow::atmosphericPanel() {
+    ensurePanel(PanelTab::Atmosphere);
+    return m_atmosphericPanel;
+}
 
-    // Atmospheric panel signals
-    connect(m_atmosphericPanel, &AtmosphericPanel::presetChanged,
-            this, [this](const QString& preset) {
-                m_vulkanWindow->setAtmosphericPreset(preset);
-                m_statusLabel->setText(tr("Atmospheric preset: %1").arg(preset));
-            });
+SensorPanel* MainWindow::sensorPanel() {
+    ensurePanel(PanelTab::Sensor);
+    return m_sensorPanel;
+}
 
-    // Sensor panel signals
-    connect(m_sensorPanel, &SensorPanel::enabledChanged,
-            this, [this](bool enabled) {
-                m_vulkanWindow->setSensorEnabled(enabled);
-                m_statusLabel->setText(enabled ? tr("Sensor simulation enabled")
-                                               : tr("Sensor simulation disabled"));
-            });
-    connect(m_sensorPanel, &SensorPanel::paramsChanged,
-            this, [this](const quantiloom::SensorParams& params) {
-                m_vulkanWindow->setSensorParams(params);
-                m_statusLabel->setText(tr("Sensor params updated"));
-            });
+RenderSettingsPanel* MainWindow::renderSettingsPanel() {
+    ensurePanel(PanelTab::Render);
+    return m_renderSettingsPanel;
+}
 
-    // Display enhancement panel signals
-    connect(m_displayEnhancementPanel, &DisplayEnhancementPanel::enhancementChanged,
-            this, [this](bool enabled, float clipLimit, int tileSize, bool luminanceOnly) {
-                m_displayEnhancementEnabled = enabled;
-                m_claheClipLimit = clipLimit;
-                m_claheTileSize = tileSize;
-                m_claheLuminanceOnly = luminanceOnly;
-                // Update renderer with CLAHE settings
-                m_vulkanWindow->setDisplayEnhancement(enabled, clipLimit, tileSize, luminanceOnly);
-                m_statusLabel->setText(enabled
-                    ? tr("Display enhancement enabled (CLAHE: clip=%1, tiles=%2x%2)")
-                        .arg(clipLimit, 0, 'f', 1).arg(tileSize)
-                    : tr("Display enhancement disabled"));
-            });
+SpectralConfigPanel* MainWindow::spectralConfigPanel() {
+    ensurePanel(PanelTab::Spectral);
+    return m_spectralConfigPanel;
+}
+
+DisplayEnhancementPanel* MainWindow::displayEnhancementPanel() {
+    ensurePanel(PanelTab::Display);
+    return m_displayEnhancementPanel;
+}
+
+DebugVisualizationPanel* MainWindow::debugVisualizationPanel() {
+    ensurePanel(PanelTab::Debug);
+    return m_debugVisualizationPanel;
 }
 
 void MainWindow::setupStatusBar() {
@@ -314,6 +560,11 @@ void MainWindow::setupStatusBar() {
     m_renderProgress = new QProgressBar();
     m_renderProgress->setMaximumWidth(200);
     m_renderProgress->setVisible(false);
+    m_cancelLoadButton = new QToolButton();
+    m_cancelLoadButton->setText(tr("Cancel"));
+    m_cancelLoadButton->setToolTip(tr("Cancel scene loading"));
+    m_cancelLoadButton->setAutoRaise(true);
+    m_cancelLoadButton->setVisible(false);
 
     statusBar()->addWidget(m_statusLabel, 1);
     statusBar()->addPermanentWidget(m_debugValueLabel);
@@ -321,19 +572,141 @@ void MainWindow::setupStatusBar() {
     statusBar()->addPermanentWidget(m_sampleCountLabel);
     statusBar()->addPermanentWidget(m_fpsLabel);
     statusBar()->addPermanentWidget(m_renderProgress);
+    statusBar()->addPermanentWidget(m_cancelLoadButton);
 }
 
 void MainWindow::setupConnections() {
+    // Image sequence recording is polled by the renderer every frame
+    m_vulkanWindow->setSequenceCapture(m_sequenceCapture);
+    connect(m_sequenceCapture, &SequenceCapture::statsChanged,
+            this, [this](const SequenceCaptureStats& stats) {
+                if (!stats.active) {
+                    return;  // finished() reports the result
+                }
+                m_statusLabel->setText(tr("Recording sequence: %1 written, %2 pending, "
+                                          "%3 dropped, %4 throttled")
+                    .arg(stats.written).arg(stats.captured - stats.written - stats.failed - stats.dropped)
+                    .arg(stats.dropped).arg(stats.throttled));
+            });
+    connect(m_sequenceCapture, &SequenceCapture::finished,
+            this, [this](const SequenceCaptureStats& stats) {
+                m_recordSequenceAction->setChecked(false);
+                m_statusLabel->setText(tr("Sequence saved: %1 frame(s) (%2 MB) to %3%4")
+                    .arg(stats.written)
+                    .arg(stats.bytesWritten / 1.0e6, 0, 'f', 1)
+                    .arg(m_sequenceCapture->settings().directory)
+                    .arg(stats.failed + stats.dropped > 0
+                         ? tr(", %1 lost").arg(stats.failed + stats.dropped) : QString()));
+            });
+
     // Connect Vulkan window signals
     connect(m_vulkanWindow, &QuantiloomVulkanWindow::frameRendered,
             this, &MainWindow::onFrameRendered);
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::accumulationConverged,
+            this, [this](uint32_t samples, double relativeChange) {
+                m_fpsLabel->setText(tr("FPS: idle"));
+                m_statusLabel->setText(relativeChange >= 0.0
+                    ? tr("Converged at %1 samples (%2% change), rendering paused")
+                        .arg(samples).arg(relativeChange * 100.0, 0, 'f', 2)
+                    : tr("Sample limit reached (%1), rendering paused").arg(samples));
+            });
+
+    // Scene loading progress (loads run on a worker thread)
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::sceneLoadStarted,
+            this, [this](const QString& filePath) {
+                m_statusLabel->setText(tr("Loading: %1").arg(QFileInfo(filePath).fileName()));
+                m_renderProgress->setRange(0, 100);
+                m_renderProgress->setValue(0);
+                m_renderProgress->setVisible(true);
+                m_cancelLoadButton->setEnabled(true);
+                m_cancelLoadButton->setVisible(true);
+            });
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::sceneLoadProgress,
+            this, [this](int percent, const QString& status) {
+                m_renderProgress->setValue(percent);
+                if (!status.isEmpty()) {
+                    m_statusLabel->setText(status);
+                }
+            });
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::sceneLoadCanceled,
+            this, [this]() {
+                m_renderProgress->setVisible(false);
+                m_cancelLoadButton->setVisible(false);
+                m_statusLabel->setText(tr("Scene loading canceled"));
+            });
+
+    // Pipeline cache: on a miss the shaders compile in the background at startup
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::pipelineWarmupStarted,
+            this, [this]() {
+                m_statusLabel->setText(tr("Compiling shaders in the background "
+                                          "(first run for this GPU/driver)..."));
+                m_renderProgress->setRange(0, 0);
+                m_renderProgress->setVisible(true);
+            });
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::pipelineCacheReady,
+            this, [this](const PipelineCacheStats& stats) {
+                m_renderProgress->setVisible(false);
+                const QString counters = tr("%1 hits / %2 misses").arg(stats.hits).arg(stats.misses);
+                if (stats.isHit()) {
+                    m_statusLabel->setText(tr("Pipeline cache hit (%1 MB, %2)")
+                        .arg(stats.cacheBytes / (1024.0 * 1024.0), 0, 'f', 1).arg(counters));
+                } else {
+                    m_statusLabel->setText(tr("Shaders compiled in %1 s, pipeline cache %2 (%3)")
+                        .arg(stats.warmupMs / 1000.0, 0, 'f', 1)
+                        .arg(PipelineCacheManager::stateName(stats.state), counters));
+                }
+            });
+    connect(m_cancelLoadButton, &QToolButton::clicked, this, [this]() {
+        m_cancelLoadButton->setEnabled(false);
+        m_statusLabel->setText(tr("Canceling scene load..."));
+        m_vulkanWindow->cancelSceneLoad();
+    });
+
+    // Final render job (offscreen, independent of the viewport size)
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::finalRenderStatus,
+            this, [this](const QString& status) {
+                m_statusLabel->setText(status);
+            });
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::finalRenderProgress,
+            this, [this](uint32_t samples, uint32_t targetSpp, double samplesPerSecond) {
+                m_renderProgress->setRange(0, static_cast<int>(targetSpp));
+                m_renderProgress->setValue(static_cast<int>(std::min(samples, targetSpp)));
+                m_statusLabel->setText(tr("Final render: %1 / %2 SPP (%3 samples/s)")
+                    .arg(samples).arg(targetSpp).arg(samplesPerSecond, 0, 'f', 1));
+            });
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::finalRenderPaused,
+            this, [this](bool paused) {
+                QSignalBlocker blocker(m_pauseRenderAction);
+                m_pauseRenderAction->setChecked(paused);
+                if (paused) {
+                    m_statusLabel->setText(tr("Final render paused"));
+                }
+            });
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::finalRenderFinished,
+            this, [this](bool success, const QString& message) {
+                m_renderProgress->setVisible(false);
+                {
+                    QSignalBlocker blocker(m_pauseRenderAction);
+                    m_pauseRenderAction->setChecked(false);
+                }
+                m_pauseRenderAction->setEnabled(false);
+                m_statusLabel->setText(message);
+                if (!success) {
+                    qWarning() << "Final render did not complete:" << message;
+                }
+            });
 
     // Connect scene loaded signal to update panels
     connect(m_vulkanWindow, &QuantiloomVulkanWindow::sceneLoaded,
             this, [this](bool success, const QString& message) {
+                if (!m_vulkanWindow->isFinalRenderActive()) {
+                    m_renderProgress->setVisible(false);
+                }
+                m_cancelLoadButton->setVisible(false);
                 if (success) {
                     updatePanelsFromScene();
                     applyPendingMaterialConfigs();
+                    m_scenePicker->rebuild(m_vulkanWindow->getScene());
                     m_statusLabel->setText(message);
                 } else {
                     QMessageBox::warning(this, tr("Scene Load Failed"), message);
@@ -348,6 +721,14 @@ void MainWindow::setupConnections() {
     // Connect viewport hover for debug value display
     connect(m_vulkanWindow, &QuantiloomVulkanWindow::mouseHovered,
             this, &MainWindow::onViewportHovered);
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::hoverProbed,
+            this, &MainWindow::onHoverProbed);
+
+    // Startup ends at the first presented frame; fill in the remaining panels then
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::firstFramePresented,
+            this, [this]() {
+                QTimer::singleShot(0, this, &MainWindow::buildDeferredPanels);
+            });
 }
 
 void MainWindow::rememberConfigPath(const QString& filePath) const {
@@ -363,17 +744,28 @@ void MainWindow::setupEditingSystem() {
     m_selectionManager = new SelectionManager(this);
     m_transformGizmo = new TransformGizmo(this);
     m_undoStack = new UndoStack(this);
+    m_undoStack->setByteBudget(
+        QSettings().value("undo/budget_mb", 64).toULongLong() * 1024 * 1024);
+    m_scenePicker = new ScenePicker(this);
 
     // Pass to Vulkan window
     m_vulkanWindow->setEditingComponents(m_selectionManager, m_transformGizmo, m_undoStack);
 
     // Connect undo/redo actions
-    connect(m_undoAction, &QAction::triggered, m_undoStack, &UndoStack::undo);
-    connect(m_redoAction, &QAction::triggered, m_undoStack, &UndoStack::redo);
+    // Replayed edits are applied together when the batch closes
+    connect(m_undoAction, &QAction::triggered, this, [this]() {
+        SceneEditBatch batch(m_vulkanWindow);
+        m_undoStack->undo();
+    });
+    connect(m_redoAction, &QAction::triggered, this, [this]() {
+        SceneEditBatch batch(m_vulkanWindow);
+        m_undoStack->redo();
+    });
 
     // Connect undo stack state changes
     connect(m_undoStack, &UndoStack::canUndoChanged, this, &MainWindow::onUndoRedoChanged);
     connect(m_undoStack, &UndoStack::canRedoChanged, this, &MainWindow::onUndoRedoChanged);
+    connect(m_undoStack, &UndoStack::historyNavigated, this, &MainWindow::syncEditorPanels);
 
     // Connect selection changes
     connect(m_selectionManager, &SelectionManager::selectionChanged,
@@ -404,12 +796,16 @@ void MainWindow::setupEditingSystem() {
                 m_statusLabel->setText(tr("Mode: %1").arg(modeText));
             });
 
+    // Keep picking BVH in sync with edited transforms (TLAS refit only)
+    connect(m_vulkanWindow, &QuantiloomVulkanWindow::nodeTransformChanged,
+            m_scenePicker, &ScenePicker::updateNodeTransform);
+
     // Sync selection with scene tree panel (highlight selected items)
     connect(m_selectionManager, &SelectionManager::selectionChanged,
-            m_sceneTreePanel, &SceneTreePanel::setSelectedNodes);
+            sceneTreePanel(), &SceneTreePanel::setSelectedNodes);
 
     connect(m_selectionManager, &SelectionManager::selectionCleared,
-            m_sceneTreePanel, &SceneTreePanel::clearSelectionHighlight);
+            sceneTreePanel(), &SceneTreePanel::clearSelectionHighlight);
 }
 
 void MainWindow::closeEvent(QCloseEvent* event) {
@@ -515,39 +911,98 @@ void MainWindow::onExportImage() {
         return;
     }
 
-    bool success = false;
-    if (fileName.endsWith(".exr", Qt::CaseInsensitive)) {
-        success = quantiloom::ImageIO::WriteEXR(fileName.toStdString(), *image);
-    } else if (fileName.endsWith(".png", Qt::CaseInsensitive)) {
-        success = quantiloom::ImageIO::WritePNG(fileName.toStdString(), *image);
-    } else {
-        // Default to EXR
-        if (!fileName.contains('.')) {
-            fileName += ".exr";
-        }
-        success = quantiloom::ImageIO::WriteEXR(fileName.toStdString(), *image);
+    if (!fileName.contains('.')) {
+        fileName += ".exr";  // Default to EXR
     }
 
-    if (success) {
-        m_statusLabel->setText(tr("Exported: %1").arg(fileName));
-    } else {
-        QMessageBox::warning(this, tr("Export Failed"),
-            tr("Failed to save image:\n%1").arg(fileName));
+    QString error;
+    const QList<ImageExportTarget> targets = {
+        {fileName, ImageExportQueue::formatForPath(fileName)}
+    };
+    if (!m_exportQueue->enqueue(std::move(image), targets, tr("Export"), &error)) {
+        QMessageBox::warning(this, tr("Export Failed"), error);
         m_statusLabel->setText(tr("Export failed"));
+        return;
     }
+    m_statusLabel->setText(tr("Exporting: %1...").arg(fileName));
 }
 
 void MainWindow::onStartRender() {
-    m_renderProgress->setVisible(true);
+    if (m_vulkanWindow->isFinalRenderActive()) {
+        m_statusLabel->setText(tr("A final render is already running"));
+        return;
+    }
+
+    QSettings settings;
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Final Render Output"),
+        settings.value("last_render_output", "render.exr").toString(),
+        tr("EXR Image (*.exr)")
+    );
+
+    if (fileName.isEmpty()) return;
+    if (!fileName.endsWith(".exr", Qt::CaseInsensitive)) {
+        fileName += ".exr";
+    }
+    settings.setValue("last_render_output", fileName);
+
+    const uint32_t width = renderSettingsPanel()->width();
+    const uint32_t height = renderSettingsPanel()->height();
+    const uint32_t spp = renderSettingsPanel()->spp();
+
+    QString error;
+    if (!m_vulkanWindow->startFinalRender(fileName, width, height, spp, &error)) {
+        QMessageBox::warning(this, tr("Final Render"),
+            tr("Cannot start final render:\n%1").arg(error));
+        m_statusLabel->setText(tr("Final render not started"));
+        return;
+    }
+
+    m_renderProgress->setRange(0, static_cast<int>(spp));
     m_renderProgress->setValue(0);
-    m_statusLabel->setText(tr("Rendering..."));
-    // TODO: Start high-quality render
+    m_renderProgress->setVisible(true);
+    m_pauseRenderAction->setEnabled(true);
+    m_statusLabel->setText(tr("Final render: %1x%2 @ %3 SPP").arg(width).arg(height).arg(spp));
 }
 
 void MainWindow::onStopRender() {
-    m_renderProgress->setVisible(false);
-    m_statusLabel->setText(tr("Render stopped"));
-    // TODO: Stop render
+    if (!m_vulkanWindow->isFinalRenderActive()) {
+        return;
+    }
+    // Progress bar and actions are reset by finalRenderFinished
+    m_statusLabel->setText(tr("Stopping final render..."));
+    m_vulkanWindow->stopFinalRender();
+}
+
+void MainWindow::onPauseRender(bool paused) {
+    m_vulkanWindow->setFinalRenderPaused(paused);
+    if (!paused && m_vulkanWindow->isFinalRenderActive()) {
+        m_statusLabel->setText(tr("Final render resumed"));
+    }
+}
+
+void MainWindow::onRecordSequence(bool checked) {
+    if (!checked) {
+        // Queued frames are still written; finished() reports the result
+        m_sequenceCapture->stop();
+        m_statusLabel->setText(tr("Stopping sequence recording..."));
+        return;
+    }
+
+    SequenceCaptureDialog dialog(this);
+    if (dialog.exec() != QDialog::Accepted) {
+        m_recordSequenceAction->setChecked(false);
+        return;
+    }
+
+    QString error;
+    if (!m_sequenceCapture->start(dialog.settings(), &error)) {
+        m_recordSequenceAction->setChecked(false);
+        QMessageBox::warning(this, tr("Sequence Recording"), error);
+        return;
+    }
+    m_statusLabel->setText(tr("Recording sequence to %1").arg(dialog.settings().directory));
 }
 
 void MainWindow::onResetCamera() {
@@ -570,6 +1025,58 @@ void MainWindow::onTakeScreenshot() {
     qDebug() << "Screenshot captured:" << image->width << "x" << image->height
              << "CLAHE enabled:" << m_displayEnhancementEnabled;
 
+    QString error;
+    const QString baseFilename = screenshotBasePath(&error);
+    if (baseFilename.isEmpty()) {
+        QMessageBox::warning(this, tr("Screenshot Failed"), error);
+        m_statusLabel->setText(tr("Screenshot failed"));
+        return;
+    }
+
+    QString exrPath = baseFilename + ".exr";
+    QString pngPath = baseFilename + ".png";
+
+    // EXR (HDR) and PNG (LDR preview) are encoded in parallel in the background;
+    // the screenshot reflects the display (includes CLAHE if enabled)
+    const QList<ImageExportTarget> targets = {
+        {exrPath, ImageExportFormat::EXR},
+        {pngPath, ImageExportFormat::PNG}
+    };
+    if (!m_exportQueue->enqueue(std::move(image), targets, tr("Screenshot"), &error)) {
+        m_statusLabel->setText(tr("Screenshot skipped: %1").arg(error));
+        return;
+    }
+    m_statusLabel->setText(tr("Saving screenshot: %1.{exr,png}...").arg(baseFilename));
+}
+
+void MainWindow::onQuickCapture() {
+    QString error;
+    const QString baseFilename = screenshotBasePath(&error);
+    if (baseFilename.isEmpty()) {
+        m_statusLabel->setText(tr("Capture failed: %1").arg(error));
+        return;
+    }
+
+    // Copied with the next frame and read back a frame or two later; no stall
+    const QString pngPath = baseFilename + ".png";
+    QPointer<MainWindow> self(this);
+    m_vulkanWindow->captureDisplayImageAsync([self, pngPath](const QImage& image) {
+        if (!self) {
+            return;  // Window torn down before the frame came back
+        }
+        if (image.isNull()) {
+            self->m_statusLabel->setText(tr("Capture failed"));
+            return;
+        }
+        QString error;
+        if (!self->m_exportQueue->enqueue(image, {{pngPath, ImageExportFormat::PNG}},
+                                          tr("Capture"), &error)) {
+            self->m_statusLabel->setText(tr("Capture skipped: %1").arg(error));
+        }
+    });
+}
+
+QString MainWindow::screenshotBasePath(QString* error) const {
     // Get screenshot save path from settings
     QSettings settings;
     QString screenshotDir = settings.value("screenshot_path", "").toString();
@@ -586,47 +1093,39 @@ void MainWindow::onTakeScreenshot() {
 
     // Create directory if doesn't exist
     QDir dir(screenshotDir);
-    if (!dir.exists()) {
-        if (!dir.mkpath(".")) {
-            QMessageBox::warning(this, tr("Screenshot Failed"),
-                tr("Failed to create screenshot directory:\n%1").arg(screenshotDir));
-            m_statusLabel->setText(tr("Screenshot failed"));
-            return;
+    if (!dir.exists() && !dir.mkpath(".")) {
+        if (error) {
+            *error = tr("Failed to create screenshot directory:\n%1").arg(screenshotDir);
         }
+        return QString();
     }
 
-    // Generate filename with millisecond timestamp
-    QDateTime now = QDateTime::currentDateTime();
-    QString timestamp = now.toString("yyyy-MM-dd_HH-mm-ss-zzz");
-    QString baseFilename = dir.filePath(timestamp);
-    QString exrPath = baseFilename + ".exr";
-    QString pngPath = baseFilename + ".png";
+    // Filename with millisecond timestamp
+    const QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_HH-mm-ss-zzz");
+    return dir.filePath(timestamp);
+}
 
-    // Save EXR (HDR) — screenshot reflects display (includes CLAHE if enabled)
-    bool exrSuccess = quantiloom::ImageIO::WriteEXR(exrPath.toStdString(), *image);
-    if (!exrSuccess) {
-        QMessageBox::warning(this, tr("Screenshot Failed"),
-            tr("Failed to save EXR file:\n%1").arg(exrPath));
-        m_statusLabel->setText(tr("Screenshot failed (EXR)"));
-        return;
-    }
+void MainWindow::onImageExportFinished(quint64 jobId, const QString& label,
+                                       const QStringList& written, const QStringList& failed) {
+    Q_UNUSED(jobId)
 
-    // Save PNG (LDR preview)
-    bool pngSuccess = quantiloom::ImageIO::WritePNG(pngPath.toStdString(), *image);
-    if (!pngSuccess) {
-        QMessageBox::warning(this, tr("Screenshot Warning"),
-            tr("EXR saved successfully, but PNG save failed:\n%1").arg(pngPath));
-        m_statusLabel->setText(tr("Screenshot saved (EXR only): %1").arg(exrPath));
+    if (failed.isEmpty()) {
+        m_statusLabel->setText(tr("%1 saved: %2").arg(label, written.join(", ")));
         return;
     }
 
-    // Success
-    m_statusLabel->setText(tr("Screenshot saved: %1.{exr,png}").arg(baseFilename));
+    m_statusLabel->setText(tr("%1 failed").arg(label));
 
-    // Optional: Show success message
-    QMessageBox::information(this, tr("Screenshot Saved"),
-        tr("Screenshot saved successfully:\n\nEXR: %1\nPNG: %2")
-        .arg(exrPath).arg(pngPath));
+    // Non-modal: the viewport keeps running while the message is shown
+    QString text = tr("Failed to save:\n%1").arg(failed.join("\n"));
+    if (!written.isEmpty()) {
+        text += tr("\n\nSaved:\n%1").arg(written.join("\n"));
+    }
+    auto* box = new QMessageBox(QMessageBox::Warning, tr("%1 Failed").arg(label),
+                                text, QMessageBox::Ok, this);
+    box->setAttribute(Qt::WA_DeleteOnClose);
+    box->setModal(false);
+    box->show();
 }
 
 void MainWindow::onAbout() {
@@ -683,13 +1182,42 @@ void MainWindow::onSettings() {
     }
 }
 
+void MainWindow::onExportFrameStats() {
+    QSettings settings;
+    QString lastPath = settings.value("last_frame_stats_output").toString();
+    if (lastPath.isEmpty()) {
+        lastPath = QDir(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation))
+            .filePath(QString("frame_stats_%1.csv")
+                .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")));
+    }
+
+    QString filePath = QFileDialog::getSaveFileName(
+        this, tr("Export Frame Statistics"), lastPath,
+        tr("CSV Files (*.csv);;JSON Files (*.json);;All Files (*)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    settings.setValue("last_frame_stats_output", filePath);
+
+    QString error;
+    if (m_vulkanWindow->exportFrameTimings(filePath, &error)) {
+        m_statusLabel->setText(tr("Frame statistics saved: %1").arg(filePath));
+    } else {
+        QMessageBox::warning(this, tr("Export Failed"),
+            tr("Failed to write frame statistics:\n%1").arg(error));
+    }
+}
+
 void MainWindow::onFrameRendered(float frameTimeMs, uint32_t sampleCount) {
     float fps = (frameTimeMs > 0.0f) ? (1000.0f / frameTimeMs) : 0.0f;
     m_fpsLabel->setText(tr("FPS: %1").arg(fps, 0, 'f', 1));
     m_sampleCountLabel->setText(tr("Samples: %1").arg(sampleCount));
 
-    // Update render settings panel
-    m_renderSettingsPanel->setSampleCount(sampleCount);
+    // Update render settings panel (display only; skipped until it is built)
+    if (m_renderSettingsPanel) {
+        m_renderSettingsPanel->setSampleCount(sampleCount);
+        m_renderSettingsPanel->setFrameSpp(m_vulkanWindow->currentFrameSpp());
+    }
 }
 
 // ============================================================================
@@ -701,24 +1229,48 @@ void MainWindow::onMaterialSelected(int materialIndex) {
     const quantiloom::Scene* scene = m_vulkanWindow->getScene();
     if (scene && materialIndex >= 0 && static_cast<size_t>(materialIndex) < scene->materials.size()) {
         const auto& material = scene->materials[static_cast<size_t>(materialIndex)];
-        m_materialEditorPanel->setMaterial(materialIndex, &material);
-        m_parameterTabs->setCurrentWidget(m_materialEditorPanel);
+        materialEditorPanel()->setMaterial(materialIndex, &material);
+        m_parameterTabs->setCurrentIndex(static_cast<int>(PanelTab::Material));
         m_statusLabel->setText(tr("Material '%1' selected").arg(
             QString::fromStdString(material.name)));
     }
 }
 
-void MainWindow::onMaterialChanged(int index, const quantiloom::Material& material) {
-    m_vulkanWindow->updateMaterial(index, material);
+void MainWindow::onMaterialChanged(int index, const MaterialFieldValues& values, uint32_t fields) {
+    const quantiloom::Material* current = m_vulkanWindow->material(index);
+    if (!current) {
+        return;
+    }
+    MaterialDelta delta = MaterialDelta::fromEdit(*current, values, fields);
+    if (delta.isEmpty()) {
+        return;
+    }
+
+    // Edits of one material within the merge window (or one drag) form one undo step
+    m_undoStack->push(std::make_unique<MaterialDeltaCommand>(m_vulkanWindow, index, delta));
     m_sceneModified = true;
     m_statusLabel->setText(tr("Material modified"));
 }
 
 void MainWindow::onLightingChanged(const quantiloom::LightingParams& params) {
-    m_vulkanWindow->setLightingParams(params);
+    m_undoStack->push(std::make_unique<ModifyLightingCommand>(
+        m_vulkanWindow, m_vulkanWindow->lightingParams(), params));
     m_statusLabel->setText(tr("Lighting updated"));
 }
 
+void MainWindow::syncEditorPanels() {
+    // Undo/redo changed values behind the panels' backs
+    if (m_lightingPanel) {
+        m_lightingPanel->setLightingParams(m_vulkanWindow->lightingParams());
+    }
+    if (m_materialEditorPanel && m_materialEditorPanel->currentIndex() >= 0) {
+        const int index = m_materialEditorPanel->currentIndex();
+        if (const quantiloom::Material* material = m_vulkanWindow->material(index)) {
+            m_materialEditorPanel->setMaterial(index, material);
+        }
+    }
+}
+
 void MainWindow::onSppChanged(uint32_t spp) {
     m_vulkanWindow->setSPP(spp);
     m_statusLabel->setText(tr("SPP set to %1").arg(spp));
@@ -807,17 +1359,21 @@ void MainWindow::updatePanelsFromScene() {
     const quantiloom::Scene* scene = m_vulkanWindow->getScene();
 
     // Update scene tree
-    m_sceneTreePanel->setScene(scene);
+    sceneTreePanel()->setScene(scene);
 
-    // Clear material editor
-    m_materialEditorPanel->clear();
+    // Clear material editor (one not built yet starts out clear)
+    if (m_materialEditorPanel) {
+        m_materialEditorPanel->clear();
+    }
 
     // Update lighting panel with current params
     if (scene) {
-        m_lightingPanel->setLightingParams(quantiloom::CreateDefaultLightingParams());
+        if (m_lightingPanel) {
+            m_lightingPanel->setLightingParams(quantiloom::CreateDefaultLightingParams());
+        }
 
         // Update spectral config
-        m_spectralConfigPanel->setWavelengthRange(
+        spectralConfigPanel()->setWavelengthRange(
             scene->lambda_min, scene->lambda_max, scene->delta_lambda);
 
         // Show helpful hint in status bar
@@ -875,32 +1431,32 @@ void MainWindow::onExportConfig() {
 
 void MainWindow::applyConfig(const SceneConfig& config) {
     // Apply render settings
-    m_renderSettingsPanel->setResolution(config.width, config.height);
-    m_renderSettingsPanel->setTargetSPP(config.spp);
+    renderSettingsPanel()->setResolution(config.width, config.height);
+    renderSettingsPanel()->setTargetSPP(config.spp);
     m_vulkanWindow->setSPP(config.spp);
 
     // Apply spectral settings
-    m_spectralConfigPanel->setSpectralMode(config.spectralMode);
-    m_spectralConfigPanel->setWavelength(config.wavelength_nm);
-    m_spectralConfigPanel->setWavelengthRange(config.lambda_min, config.lambda_max, config.delta_lambda);
+    spectralConfigPanel()->setSpectralMode(config.spectralMode);
+    spectralConfigPanel()->setWavelength(config.wavelength_nm);
+    spectralConfigPanel()->setWavelengthRange(config.lambda_min, config.lambda_max, config.delta_lambda);
     m_vulkanWindow->setSpectralMode(config.spectralMode);
     m_vulkanWindow->setWavelength(config.wavelength_nm);
 
     // Apply lighting settings
-    m_lightingPanel->setLightingParams(config.lighting);
+    lightingPanel()->setLightingParams(config.lighting);
     m_vulkanWindow->setLightingParams(config.lighting);
 
     // Apply atmospheric configuration
-    m_atmosphericPanel->setPreset(config.atmosphericPreset);
+    atmosphericPanel()->setPreset(config.atmosphericPreset);
     m_vulkanWindow->setAtmosphericPreset(config.atmosphericPreset);
     if (config.atmosphericEnabled) {
         qDebug() << "Atmospheric preset applied:" << config.atmosphericPreset;
     }
 
     // Apply sensor configuration
-    m_sensorPanel->setEnabled(config.sensorEnabled);
+    sensorPanel()->setEnabled(config.sensorEnabled);
     if (config.sensorEnabled) {
-        m_sensorPanel->setSensorParams(config.sensorParams);
+        sensorPanel()->setSensorParams(config.sensorParams);
     }
     m_vulkanWindow->setSensorEnabled(config.sensorEnabled);
     if (config.sensorEnabled) {
@@ -909,21 +1465,7 @@ void MainWindow::applyConfig(const SceneConfig& config) {
     }
 
     // Load scene file (glTF or USD)
-    QString scenePath;
-    if (!config.usdPath.isEmpty()) {
-        // USD file specified
-        scenePath = config.usdPath;
-        if (!QFileInfo(scenePath).isAbsolute() && !config.baseDir.isEmpty()) {
-            scenePath = config.baseDir + "/" + config.usdPath;
-        }
-    } else if (!config.gltfPath.isEmpty()) {
-        // glTF file specified
-        scenePath = config.gltfPath;
-        if (!QFileInfo(scenePath).isAbsolute() && !config.baseDir.isEmpty()) {
-            scenePath = config.baseDir + "/" + config.gltfPath;
-        }
-    }
-
+    QString scenePath = config.scenePath();
     if (!scenePath.isEmpty()) {
         m_currentSceneFile = scenePath;
         m_vulkanWindow->loadScene(scenePath);
@@ -931,12 +1473,9 @@ void MainWindow::applyConfig(const SceneConfig& config) {
 
     // Apply environment map (IBL) - do this after scene load starts
     if (!config.environmentMap.isEmpty()) {
-        QString envPath = config.environmentMap;
-        if (!QFileInfo(envPath).isAbsolute() && !config.baseDir.isEmpty()) {
-            envPath = config.baseDir + "/" + config.environmentMap;
-        }
-        // Note: loadEnvironmentMap will be called after scene is loaded
-        // For now, store the path and attempt loading
+        QString envPath = config.resolvePath(config.environmentMap);
+        // Note: while the scene is loading the renderer defers this until the
+        // load completes and applies it to the resulting context
         qDebug() << "Environment map path:" << envPath;
         if (!m_vulkanWindow->loadEnvironmentMap(envPath)) {
             qWarning() << "Failed to load environment map:" << envPath;
@@ -955,9 +1494,9 @@ void MainWindow::applyConfig(const SceneConfig& config) {
 
 void MainWindow::collectCurrentConfig(SceneConfig& config) {
     // Collect render settings
-    config.width = m_renderSettingsPanel->width();
-    config.height = m_renderSettingsPanel->height();
-    config.spp = m_renderSettingsPanel->spp();
+    config.width = renderSettingsPanel()->width();
+    config.height = renderSettingsPanel()->height();
+    config.spp = renderSettingsPanel()->spp();
 
     // Collect spectral settings from panel
     // These are tracked in the panel's internal state
@@ -994,32 +1533,7 @@ void MainWindow::applyPendingMaterialConfigs() {
             if (QString::fromStdString(material.name) == matConfig.name) {
                 // Create modified material with IR properties
                 quantiloom::Material modified = material;
-
-                // Set IR curves with constant values across IR bands
-                const float mwir_nm = 4000.0f;
-                const float lwir_nm = 10000.0f;
-
-                if (matConfig.irEmissivity > 0.0f) {
-                    modified.irEmissivityCurve.clear();
-                    modified.irEmissivityCurve.push_back({mwir_nm, matConfig.irEmissivity});
-                    modified.irEmissivityCurve.push_back({lwir_nm, matConfig.irEmissivity});
-                }
-
-                if (matConfig.irTransmittance > 0.0f) {
-                    modified.irTransmittanceCurve.clear();
-                    modified.irTransmittanceCurve.push_back({mwir_nm, matConfig.irTransmittance});
-                    modified.irTransmittanceCurve.push_back({lwir_nm, matConfig.irTransmittance});
-                }
-
-                // Compute and set reflectance from energy conservation
-                float reflectance = 1.0f - matConfig.irEmissivity - matConfig.irTransmittance;
-                if (reflectance > 0.0f) {
-                    modified.irReflectanceCurve.clear();
-                    modified.irReflectanceCurve.push_back({mwir_nm, reflectance});
-                    modified.irReflectanceCurve.push_back({lwir_nm, reflectance});
-                }
-
-                modified.irTemperature_K = matConfig.irTemperature_K;
+                ConfigManager::applyMaterialConfig(matConfig, modified);
 
                 // Apply the modified material
                 m_vulkanWindow->updateMaterial(static_cast<int>(i), modified);
@@ -1041,23 +1555,44 @@ void MainWindow::applyPendingMaterialConfigs() {
 // ============================================================================
 
 void MainWindow::onViewportClicked(const QPointF& screenPos) {
-    // Simple selection: for now, cycle through nodes based on click
-    // A proper implementation would do ray casting
-    // For MVP, we select from scene tree instead
+    if (!m_scenePicker->isReady()) {
+        m_statusLabel->setText(m_scenePicker->isBuilding()
+            ? tr("Picking data is still being built - select in Scene panel")
+            : tr("Click in Scene panel to select objects"));
+        return;
+    }
+
+    glm::vec3 camPos, camFwd, camRight, camUp;
+    m_vulkanWindow->getCameraInfo(camPos, camFwd, camRight, camUp);
 
-    Q_UNUSED(screenPos);
+    PickHit hit = m_scenePicker->pickFromCamera(
+        screenPos, QSizeF(m_vulkanWindow->size()),
+        camPos, camFwd, camRight, camUp, m_vulkanWindow->cameraFovY());
 
-    // Clear selection on empty click
-    // Note: Real picking would cast a ray and find intersecting geometry
-    // For now, users select via the scene tree panel
-    m_statusLabel->setText(tr("Click in Scene panel to select objects"));
+    // Ctrl+click toggles, plain click replaces the selection
+    const bool toggle = QGuiApplication::keyboardModifiers().testFlag(Qt::ControlModifier);
+    if (!hit.isValid()) {
+        if (!toggle) {
+            m_selectionManager->clearSelection();
+        }
+        return;
+    }
+
+    if (toggle) {
+        m_selectionManager->toggleSelection(hit.nodeIndex);
+    } else {
+        m_selectionManager->select(hit.nodeIndex);
+    }
 }
 
 void MainWindow::onSelectionChanged(const QSet<int>& selectedNodes) {
     qDebug() << "Selection changed:" << selectedNodes.size() << "nodes";
 
+    // Start states are read from the scene; include transforms still queued (undo/redo)
+    m_vulkanWindow->flushNodeTransforms();
+
     if (selectedNodes.isEmpty()) {
-        m_statusLabel->setText(tr("Selection cleared - click a node in Scene panel to select"));
+        m_statusLabel->setText(tr("Selection cleared - click an object in the viewport or Scene panel to select"));
         m_transformStartStates.clear();
     } else if (selectedNodes.size() == 1) {
         int nodeIndex = *selectedNodes.constBegin();
@@ -1121,13 +1656,15 @@ void MainWindow::onGizmoTransformChanged(const glm::vec3& translation,
     for (const auto& state : m_transformStartStates) {
         glm::mat4 newTransform = m_transformGizmo->applyDelta(state.originalTransform);
         m_vulkanWindow->setNodeTransform(state.nodeIndex, newTransform);
-        qDebug() << "  Applied transform to node" << state.nodeIndex;
     }
 
     m_sceneModified = true;
 }
 
 void MainWindow::onGizmoTransformFinished() {
+    // Drag updates are batched per frame; apply the final one before reading back
+    m_vulkanWindow->flushNodeTransforms();
+
     // Create undo command for the transform
     const auto* scene = m_vulkanWindow->getScene();
     if (!scene || m_transformStartStates.empty()) {
@@ -1193,12 +1730,28 @@ void MainWindow::onViewportHovered(int x, int y) {
         return;
     }
 
-    // Read pixel value from render output
-    glm::vec4 pixelValue;
-    if (m_vulkanWindow->readDebugPixel(x, y, pixelValue)) {
-        QString formatted = m_vulkanWindow->formatDebugValue(pixelValue);
-        m_debugValueLabel->setText(QString("(%1,%2) %3").arg(x).arg(y).arg(formatted));
+    // Read on the next frame; bursts of mouse events collapse into one read
+    m_vulkanWindow->requestHoverProbe(x, y);
+}
+
+void MainWindow::onHoverProbed(const HoverProbeResult& result) {
+    if (m_vulkanWindow->getDebugMode() == quantiloom::DebugVisualizationMode::None) {
+        return;  // Mode switched off while the probe was in flight
+    }
+
+    QString text = QString("(%1,%2) %3").arg(result.x).arg(result.y)
+        .arg(m_vulkanWindow->formatDebugValue(result.center));
+    if (result.size > 1) {
+        text += tr(" | %1x%1 mean %2").arg(result.size)
+            .arg(m_vulkanWindow->formatDebugValue(result.mean));
+        if (!result.isComplete()) {
+            text += QString(" [%1/%2]").arg(result.pixelsRead).arg(result.size * result.size);
+        }
+        m_debugValueLabel->setToolTip(tr("Min: %1\nMax: %2")
+            .arg(m_vulkanWindow->formatDebugValue(result.min))
+            .arg(m_vulkanWindow->formatDebugValue(result.max)));
     } else {
-        m_debugValueLabel->setText(QString("(%1,%2) read failed").arg(x).arg(y));
+        m_debugValueLabel->setToolTip(QString());
     }
+    m_debugValueLabel->setText(text);
 }
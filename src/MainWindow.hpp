@@ -10,6 +10,7 @@
 #include <QMainWindow>
 #include <QVulkanInstance>
 #include <QSet>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -24,6 +25,9 @@ class QStatusBar;
 class QProgressBar;
 class QLabel;
 class QAction;
+class QToolButton;
+class QMenu;
+class QTimer;
 QT_END_NAMESPACE
 
 namespace quantiloom {
@@ -42,11 +46,17 @@ class DebugVisualizationPanel;
 class AtmosphericPanel;
 class SensorPanel;
 class DisplayEnhancementPanel;
+class FrameStatsPanel;
 class ConfigManager;
 class SelectionManager;
 class TransformGizmo;
 class UndoStack;
+struct MaterialFieldValues;
+class ScenePicker;
+class ImageExportQueue;
+class SequenceCapture;
 struct SceneConfig;
+struct HoverProbeResult;
 
 /**
  * @class MainWindow
@@ -55,6 +65,7 @@ struct SceneConfig;
  * Layout:
  * - Center: Vulkan 3D viewport (QuantiloomVulkanWindow)
  * - Left: Parameter panels in tabbed dock widget
+ * - Right: Frame statistics dock (hidden by default)
  * - Bottom: Status bar with render info
  */
 class MainWindow : public QMainWindow {
@@ -80,10 +91,13 @@ private slots:
     // Render menu actions
     void onStartRender();
     void onStopRender();
+    void onPauseRender(bool paused);
+    void onRecordSequence(bool checked);
 
     // View menu actions
     void onResetCamera();
     void onTakeScreenshot();
+    void onQuickCapture();
 
     // Help menu actions
     void onAbout();
@@ -94,10 +108,13 @@ private slots:
 
     // Status updates
     void onFrameRendered(float frameTimeMs, uint32_t sampleCount);
+    void onExportFrameStats();
+    void onImageExportFinished(quint64 jobId, const QString& label,
+                               const QStringList& written, const QStringList& failed);
 
     // Panel signals
     void onMaterialSelected(int materialIndex);
-    void onMaterialChanged(int index, const quantiloom::Material& material);
+    void onMaterialChanged(int index, const MaterialFieldValues& values, uint32_t fields);
     void onLightingChanged(const quantiloom::LightingParams& params);
     void onSppChanged(uint32_t spp);
     void onSpectralModeChanged(quantiloom::SpectralMode mode);
@@ -113,9 +130,11 @@ private slots:
                                   const glm::vec3& scale);
     void onGizmoTransformFinished();
     void onUndoRedoChanged();
+    void syncEditorPanels();
 
     // Debug hover slot
     void onViewportHovered(int x, int y);
+    void onHoverProbed(const HoverProbeResult& result);
 
 private:
     void setupUi();
@@ -125,7 +144,29 @@ private:
     void setupConnections();
     void setupEditingSystem();
     void updatePanelsFromScene();
+
+    // Parameter tabs, in tab order. Panels are built on first use
+    enum class PanelTab {
+        Scene, Material, Lighting, Atmosphere, Sensor, Render, Spectral, Display, Debug, Count
+    };
+    static constexpr size_t kPanelTabCount = static_cast<size_t>(PanelTab::Count);
+    void addPanelTab(PanelTab tab, const QString& label);
+    void ensurePanel(PanelTab tab);
+    QWidget* createPanel(PanelTab tab);
+    void buildDeferredPanels();
+
+    // Accessors that build the panel if needed
+    SceneTreePanel* sceneTreePanel();
+    MaterialEditorPanel* materialEditorPanel();
+    LightingPanel* lightingPanel();
+    AtmosphericPanel* atmosphericPanel();
+    SensorPanel* sensorPanel();
+    RenderSettingsPanel* renderSettingsPanel();
+    SpectralConfigPanel* spectralConfigPanel();
+    DisplayEnhancementPanel* displayEnhancementPanel();
+    DebugVisualizationPanel* debugVisualizationPanel();
     void rememberConfigPath(const QString& filePath) const;
+    QString screenshotBasePath(QString* error) const;
 
     // Vulkan instance (owned by main())
     QVulkanInstance* m_vulkanInstance = nullptr;
@@ -138,7 +179,9 @@ private:
     QDockWidget* m_parameterDock = nullptr;
     QTabWidget* m_parameterTabs = nullptr;
 
-    // Parameter panels
+    // Parameter panels (null until built, see ensurePanel())
+    std::array<QWidget*, kPanelTabCount> m_panelPages{};
+    std::array<bool, kPanelTabCount> m_panelBuilt{};
     SceneTreePanel* m_sceneTreePanel = nullptr;
     MaterialEditorPanel* m_materialEditorPanel = nullptr;
     LightingPanel* m_lightingPanel = nullptr;
@@ -149,6 +192,12 @@ private:
     SensorPanel* m_sensorPanel = nullptr;
     DisplayEnhancementPanel* m_displayEnhancementPanel = nullptr;
 
+    // Frame statistics dock (refreshed by timer while visible)
+    QDockWidget* m_frameStatsDock = nullptr;
+    FrameStatsPanel* m_frameStatsPanel = nullptr;
+    QTimer* m_frameStatsTimer = nullptr;
+    QMenu* m_viewMenu = nullptr;
+
     // Display enhancement (CLAHE) settings
     bool m_displayEnhancementEnabled = false;
     float m_claheClipLimit = 2.0f;
@@ -162,6 +211,15 @@ private:
     QLabel* m_editModeLabel = nullptr;  // Shows current transform mode
     QLabel* m_debugValueLabel = nullptr;  // Shows debug value at mouse position
     QProgressBar* m_renderProgress = nullptr;
+    QToolButton* m_cancelLoadButton = nullptr;  // Visible while a scene loads
+
+    // Render menu
+    QAction* m_pauseRenderAction = nullptr;  // Enabled while a final render runs
+
+    // Screenshots and Export Image are encoded off the GUI thread
+    ImageExportQueue* m_exportQueue = nullptr;
+    SequenceCapture* m_sequenceCapture = nullptr;
+    QAction* m_recordSequenceAction = nullptr;
 
     // Configuration manager
     ConfigManager* m_configManager = nullptr;
@@ -179,6 +237,7 @@ private:
     SelectionManager* m_selectionManager = nullptr;
     TransformGizmo* m_transformGizmo = nullptr;
     UndoStack* m_undoStack = nullptr;
+    ScenePicker* m_scenePicker = nullptr;  // CPU BVH for viewport clicks
 
     // Menu actions for undo/redo
     QAction* m_undoAction = nullptr;
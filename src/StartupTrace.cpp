@@ -0,0 +1,158 @@
+/**
+ * @file StartupTrace.cpp
+ * @brief Startup timeline implementation
+ *
+ * @author wtflmao
+ */
+
+#include "StartupTrace.hpp"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+
+struct TraceState {
+    QElapsedTimer clock;
+    QVector<StartupTrace::Event> events;
+    QHash<QString, qsizetype> open;   // Span name -> index in events
+    bool active = false;
+};
+
+TraceState& state() {
+    static TraceState s;
+    return s;
+}
+
+void writeChromeTrace(const QString& path) {
+    QJsonArray traceEvents;
+    for (const StartupTrace::Event& event : state().events) {
+        QJsonObject json;
+        json["name"] = event.name;
+        json["pid"] = static_cast<qint64>(QCoreApplication::applicationPid());
+        json["tid"] = 0;
+        json["ts"] = static_cast<double>(event.startNs) / 1000.0;   // Microseconds
+        if (event.durationNs >= 0) {
+            json["ph"] = "X";
+            json["dur"] = static_cast<double>(event.durationNs) / 1000.0;
+        } else {
+            json["ph"] = "i";
+            json["s"] = "g";
+        }
+        traceEvents.append(json);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "StartupTrace: Cannot write" << path << "-" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject{{"traceEvents", traceEvents}}).toJson());
+    qDebug() << "StartupTrace: Written to" << path;
+}
+
+} // namespace
+
+StartupTrace::Scope::Scope(const QString& name)
+    : m_name(name)
+{
+    StartupTrace::begin(m_name);
+}
+
+StartupTrace::Scope::~Scope() {
+    StartupTrace::end(m_name);
+}
+
+void StartupTrace::start() {
+    TraceState& s = state();
+    s.clock.start();
+    s.events.clear();
+    s.open.clear();
+    s.active = true;
+    mark(QStringLiteral("main()"));
+}
+
+void StartupTrace::begin(const QString& name) {
+    TraceState& s = state();
+    if (!s.active) {
+        return;
+    }
+    s.open.insert(name, s.events.size());
+    s.events.append({name, s.clock.nsecsElapsed(), 0});
+}
+
+void StartupTrace::end(const QString& name) {
+    TraceState& s = state();
+    if (!s.active) {
+        return;
+    }
+    const auto it = s.open.find(name);
+    if (it == s.open.end()) {
+        return;
+    }
+    Event& event = s.events[it.value()];
+    event.durationNs = s.clock.nsecsElapsed() - event.startNs;
+    s.open.erase(it);
+}
+
+void StartupTrace::mark(const QString& name) {
+    TraceState& s = state();
+    if (!s.active) {
+        return;
+    }
+    s.events.append({name, s.clock.nsecsElapsed(), -1});
+}
+
+void StartupTrace::finish(const QString& name) {
+    TraceState& s = state();
+    if (!s.active) {
+        return;
+    }
+    mark(name);
+    s.active = false;
+
+    // Spans still open (e.g. a background pipeline warm-up) end here
+    for (auto it = s.open.cbegin(); it != s.open.cend(); ++it) {
+        Event& event = s.events[it.value()];
+        event.durationNs = s.clock.nsecsElapsed() - event.startNs;
+        event.name += QStringLiteral(" (still running)");
+    }
+    s.open.clear();
+
+    qDebug().noquote() << "Startup trace:\n" + report();
+
+    const QString path = qEnvironmentVariable("QUANTILOOM_STARTUP_TRACE");
+    if (!path.isEmpty()) {
+        writeChromeTrace(path);
+    }
+}
+
+bool StartupTrace::isActive() {
+    return state().active;
+}
+
+QVector<StartupTrace::Event> StartupTrace::events() {
+    return state().events;
+}
+
+QString StartupTrace::report() {
+    QString text;
+    for (const Event& event : state().events) {
+        const double startMs = static_cast<double>(event.startNs) / 1.0e6;
+        if (event.durationNs >= 0) {
+            text += QStringLiteral("%1 ms  %2 (%3 ms)\n")
+                .arg(startMs, 9, 'f', 1)
+                .arg(event.name)
+                .arg(static_cast<double>(event.durationNs) / 1.0e6, 0, 'f', 1);
+        } else {
+            text += QStringLiteral("%1 ms  %2\n").arg(startMs, 9, 'f', 1).arg(event.name);
+        }
+    }
+    return text;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file StartupTrace.hpp
+ * @brief Cold-start timeline from main() to the first presented frame
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @class StartupTrace
+ * @brief Process-wide startup timeline (GUI thread only)
+ *
+ * start() is called first thing in main(); spans and marks are recorded
+ * relative to it until finish() is called for the first presented frame.
+ * finish() logs the timeline and, if QUANTILOOM_STARTUP_TRACE names a file,
+ * writes it there in Chrome trace event format (chrome://tracing, Perfetto).
+ * Everything after finish() is ignored, so instrumentation left in code
+ * that also runs later (e.g. panels built on demand) costs nothing then.
+ */
+class StartupTrace {
+public:
+    struct Event {
+        QString name;
+        qint64 startNs = 0;       // Since start()
+        qint64 durationNs = -1;   // -1: instant mark
+    };
+
+    /**
+     * @brief RAII span
+     */
+    class Scope {
+    public:
+        explicit Scope(const QString& name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        QString m_name;
+    };
+
+    static void start();
+
+    /// Spans that open and close in different functions (matched by name)
+    static void begin(const QString& name);
+    static void end(const QString& name);
+
+    static void mark(const QString& name);
+
+    /**
+     * @brief Record the final mark, log the timeline and stop recording
+     */
+    static void finish(const QString& name);
+
+    [[nodiscard]] static bool isActive();
+    [[nodiscard]] static QVector<Event> events();
+
+    /**
+     * @brief Human-readable timeline (one event per line)
+     */
+    [[nodiscard]] static QString report();
+};
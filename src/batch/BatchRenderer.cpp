@@ -0,0 +1,561 @@
+/**
+ * @file BatchRenderer.cpp
+ * @brief Headless batch rendering implementation
+ *
+ * @author wtflmao
+ */
+
+#include "BatchRenderer.hpp"
+#include "config/ConfigManager.hpp"
+#include "vulkan/PipelineCacheManager.hpp"
+
+#include <renderer/ExternalRenderContext.hpp>
+#include <scene/Material.hpp>
+#include <scene/Scene.hpp>
+#include <core/Image.hpp>
+#include <io/ImageIO.hpp>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDebug>
+#include <cstring>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+namespace {
+
+// Abort a scene if this many frames in a row add no samples
+constexpr int kMaxStalledFrames = 64;
+
+bool isUsdFile(const QString& path) {
+    return path.endsWith(".usd", Qt::CaseInsensitive) ||
+           path.endsWith(".usda", Qt::CaseInsensitive) ||
+           path.endsWith(".usdc", Qt::CaseInsensitive) ||
+           path.endsWith(".usdz", Qt::CaseInsensitive);
+}
+
+bool supportsExtensions(VkPhysicalDevice device, const std::vector<const char*>& required,
+                        QStringList* missing) {
+    uint32_t count = 0;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> available(count);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &count, available.data());
+
+    bool ok = true;
+    for (const char* name : required) {
+        bool found = false;
+        for (const auto& ext : available) {
+            if (std::strcmp(ext.extensionName, name) == 0) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            ok = false;
+            if (missing) {
+                missing->append(QString::fromLatin1(name));
+            }
+        }
+    }
+    return ok;
+}
+
+int findGraphicsQueueFamily(VkPhysicalDevice device) {
+    uint32_t count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, nullptr);
+    std::vector<VkQueueFamilyProperties> families(count);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, families.data());
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int deviceTypeScore(VkPhysicalDeviceType type, bool preferSoftware) {
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+        return preferSoftware ? 2 : 4;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+        return preferSoftware ? 1 : 3;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+        return preferSoftware ? 4 : 1;
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+BatchRenderer::BatchRenderer(BatchOptions options)
+    : m_options(std::move(options))
+{
+}
+
+BatchRenderer::~BatchRenderer() {
+    shutdown();
+}
+
+// ============================================================================
+// Batch Loop
+// ============================================================================
+
+int BatchRenderer::run() {
+    if (m_options.configPaths.isEmpty()) {
+        qCritical() << "Batch mode: no config files given";
+        return 2;
+    }
+
+    QString error;
+    if (!createInstance(&error) || !selectPhysicalDevice(&error) || !createDevice(&error)) {
+        qCritical() << "Batch mode: Vulkan initialization failed:" << error;
+        shutdown();
+        return 3;
+    }
+
+    qInfo() << "Batch mode: rendering" << m_options.configPaths.size()
+            << "config(s) on" << m_deviceName;
+
+    bool allSucceeded = true;
+    for (const QString& configPath : m_options.configPaths) {
+        BatchSceneResult result = renderConfig(configPath);
+        m_results.append(result);
+
+        if (result.success) {
+            qInfo().noquote() << QString("[%1/%2] %3 -> %4: %5 spp in %6 s (%7 samples/s, wall %8 s)")
+                .arg(m_results.size()).arg(m_options.configPaths.size())
+                .arg(configPath, result.outputPath)
+                .arg(result.samples)
+                .arg(result.renderSeconds, 0, 'f', 2)
+                .arg(result.samplesPerSecond(), 0, 'f', 1)
+                .arg(result.wallSeconds, 0, 'f', 2);
+        } else {
+            allSucceeded = false;
+            qCritical().noquote() << QString("[%1/%2] %3 FAILED: %4")
+                .arg(m_results.size()).arg(m_options.configPaths.size())
+                .arg(configPath, result.error);
+            if (!m_options.continueOnError) {
+                break;
+            }
+        }
+    }
+
+    printSummary();
+    shutdown();
+    return allSucceeded ? 0 : 1;
+}
+
+BatchSceneResult BatchRenderer::renderConfig(const QString& configPath) {
+    BatchSceneResult result;
+    result.configPath = configPath;
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+
+    ConfigManager configManager;
+    SceneConfig config;
+    if (!configManager.loadConfig(configPath, config)) {
+        result.error = QString("Failed to parse config: %1").arg(configManager.lastError());
+        return result;
+    }
+
+    if (config.scenePath().isEmpty()) {
+        result.error = "Config specifies no scene (scene.gltf or scene.usd)";
+        return result;
+    }
+    if (config.spp == 0) {
+        result.error = "renderer.spp must be greater than zero";
+        return result;
+    }
+
+    result.outputPath = config.resolvePath(config.outputPath);
+
+    // A context that still holds an environment map from a previous scene cannot
+    // drop it, so start from a fresh one when this scene has none.
+    if (m_hasEnvironmentMap && config.environmentMap.isEmpty()) {
+        destroyRenderContext();
+    }
+
+    QString error;
+    if (!ensureRenderContext(config.width, config.height, &error)) {
+        result.error = error;
+        return result;
+    }
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    if (!loadScene(config, &error)) {
+        result.error = error;
+        return result;
+    }
+    result.loadSeconds = loadTimer.elapsed() / 1000.0;
+
+    applySceneConfig(config);
+
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+    if (!accumulate(config.spp, &error)) {
+        result.error = error;
+        return result;
+    }
+    result.renderSeconds = renderTimer.nsecsElapsed() / 1e9;
+    result.samples = m_renderContext->GetAccumulatedSamples();
+
+    auto capture = m_renderContext->CaptureScreenshot();
+    if (!capture.has_value()) {
+        result.error = QString("Capture failed: %1").arg(QString::fromStdString(capture.error()));
+        return result;
+    }
+
+    QDir().mkpath(QFileInfo(result.outputPath).absolutePath());
+    if (!quantiloom::ImageIO::WriteEXR(result.outputPath.toStdString(), capture.value())) {
+        result.error = QString("Failed to write %1").arg(result.outputPath);
+        return result;
+    }
+
+    result.wallSeconds = wallTimer.elapsed() / 1000.0;
+    result.success = true;
+    return result;
+}
+
+bool BatchRenderer::loadScene(const SceneConfig& config, QString* error) {
+    const QString scenePath = config.scenePath();
+    if (!QFileInfo::exists(scenePath)) {
+        *error = QString("Scene file not found: %1").arg(scenePath);
+        return false;
+    }
+
+    std::string path = scenePath.toStdString();
+    quantiloom::Result<void, quantiloom::String> result;
+    if (isUsdFile(scenePath)) {
+        result = m_renderContext->LoadSceneFromUsd(path);
+    } else {
+        result = m_renderContext->LoadSceneFromGltf(path);
+    }
+
+    if (!result) {
+        *error = QString("Failed to load scene: %1").arg(QString::fromStdString(result.error()));
+        return false;
+    }
+
+    if (!config.environmentMap.isEmpty()) {
+        const QString envPath = config.resolvePath(config.environmentMap);
+        auto envResult = m_renderContext->LoadEnvironmentMap(envPath.toStdString());
+        if (!envResult.has_value()) {
+            *error = QString("Failed to load environment map %1: %2")
+                .arg(envPath, QString::fromStdString(envResult.error()));
+            return false;
+        }
+        m_hasEnvironmentMap = true;
+    }
+
+    return true;
+}
+
+void BatchRenderer::applySceneConfig(const SceneConfig& config) {
+    // Same order as MainWindow::applyConfig
+    m_renderContext->SetSPP(config.spp);
+    m_renderContext->SetSpectralMode(config.spectralMode);
+    m_renderContext->SetWavelength(config.wavelength_nm);
+    m_renderContext->SetLightingParams(config.lighting);
+    m_renderContext->SetAtmosphericConfig(
+        ConfigManager::atmosphericConfigForPreset(config.atmosphericPreset));
+
+    glm::vec3 camPos(config.cameraPosition[0], config.cameraPosition[1], config.cameraPosition[2]);
+    glm::vec3 camLookAt(config.cameraLookAt[0], config.cameraLookAt[1], config.cameraLookAt[2]);
+    glm::vec3 camUp(config.cameraUp[0], config.cameraUp[1], config.cameraUp[2]);
+    m_renderContext->SetCameraLookAt(camPos, camLookAt, camUp);
+    m_renderContext->SetCameraFOV(config.cameraFovY);
+
+    // [[materials]] IR overrides
+    if (const auto* scene = m_renderContext->GetScene()) {
+        for (const auto& matConfig : config.materialConfigs) {
+            for (size_t i = 0; i < scene->materials.size(); ++i) {
+                if (QString::fromStdString(scene->materials[i].name) == matConfig.name) {
+                    quantiloom::Material modified = scene->materials[i];
+                    ConfigManager::applyMaterialConfig(matConfig, modified);
+                    m_renderContext->UpdateMaterial(static_cast<quantiloom::u32>(i), modified);
+                    break;
+                }
+            }
+        }
+    }
+
+    m_renderContext->ResetAccumulation();
+}
+
+bool BatchRenderer::accumulate(uint32_t targetSpp, QString* error) {
+    const auto record = [this](VkCommandBuffer cmd, VkImage target, uint32_t width, uint32_t height) {
+        m_renderContext->RenderFrame(cmd, target, VK_IMAGE_LAYOUT_UNDEFINED,
+                                     static_cast<quantiloom::u32>(width),
+                                     static_cast<quantiloom::u32>(height));
+    };
+
+    uint32_t lastSamples = m_renderContext->GetAccumulatedSamples();
+    int stalledFrames = 0;
+
+    while (m_renderContext->GetAccumulatedSamples() < targetSpp) {
+        if (!m_frameRunner.submitFrame(record)) {
+            *error = "Frame submission failed";
+            return false;
+        }
+
+        uint32_t samples = m_renderContext->GetAccumulatedSamples();
+        if (samples == lastSamples) {
+            if (++stalledFrames >= kMaxStalledFrames) {
+                *error = QString("Accumulation stalled at %1/%2 samples").arg(samples).arg(targetSpp);
+                return false;
+            }
+        } else {
+            stalledFrames = 0;
+            lastSamples = samples;
+        }
+    }
+
+    // Capture reads the accumulation buffer; all frames must have landed
+    if (!m_frameRunner.waitIdle()) {
+        *error = "Waiting for GPU completion failed";
+        return false;
+    }
+    return true;
+}
+
+void BatchRenderer::printSummary() const {
+    QTextStream out(stdout);
+
+    int succeeded = 0;
+    double totalWall = 0.0;
+    out << "\nBatch summary\n";
+    out << QString("%1  %2  %3  %4  %5\n")
+        .arg("status", -6).arg("samples", 8).arg("render s", 9).arg("samples/s", 10).arg("wall s", 8);
+    for (const auto& result : m_results) {
+        totalWall += result.wallSeconds;
+        if (result.success) {
+            ++succeeded;
+        }
+        out << QString("%1  %2  %3  %4  %5  %6\n")
+            .arg(result.success ? "ok" : "FAIL", -6)
+            .arg(result.samples, 8)
+            .arg(result.renderSeconds, 9, 'f', 2)
+            .arg(result.samplesPerSecond(), 10, 'f', 1)
+            .arg(result.wallSeconds, 8, 'f', 2)
+            .arg(result.configPath);
+    }
+    out << QString("%1/%2 scene(s) succeeded, %3 s total\n")
+        .arg(succeeded).arg(m_results.size()).arg(totalWall, 0, 'f', 2);
+    out.flush();
+}
+
+// ============================================================================
+// Vulkan Setup
+// ============================================================================
+
+bool BatchRenderer::createInstance(QString* error) {
+    VkApplicationInfo appInfo{};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = "Quantiloom Batch";
+    appInfo.applicationVersion = VK_MAKE_VERSION(0, 0, 3);
+    appInfo.pEngineName = "Quantiloom";
+    appInfo.engineVersion = VK_MAKE_VERSION(0, 0, 3);
+    // Vulkan 1.3 required for ray tracing
+    appInfo.apiVersion = VK_API_VERSION_1_3;
+
+    std::vector<const char*> layers;
+#ifdef QT_DEBUG
+    uint32_t layerCount = 0;
+    vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+    std::vector<VkLayerProperties> availableLayers(layerCount);
+    vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
+    for (const auto& layer : availableLayers) {
+        if (std::strcmp(layer.layerName, "VK_LAYER_KHRONOS_validation") == 0) {
+            layers.push_back("VK_LAYER_KHRONOS_validation");
+            break;
+        }
+    }
+#endif
+
+    const char* extensions[] = {VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME};
+
+    VkInstanceCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    createInfo.pApplicationInfo = &appInfo;
+    createInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+    createInfo.ppEnabledLayerNames = layers.data();
+    createInfo.enabledExtensionCount = 1;
+    createInfo.ppEnabledExtensionNames = extensions;
+
+    VkResult res = vkCreateInstance(&createInfo, nullptr, &m_instance);
+    if (res != VK_SUCCESS) {
+        *error = QString("vkCreateInstance failed: %1").arg(static_cast<int>(res));
+        m_instance = VK_NULL_HANDLE;
+        return false;
+    }
+    return true;
+}
+
+bool BatchRenderer::selectPhysicalDevice(QString* error) {
+    uint32_t count = 0;
+    vkEnumeratePhysicalDevices(m_instance, &count, nullptr);
+    std::vector<VkPhysicalDevice> devices(count);
+    vkEnumeratePhysicalDevices(m_instance, &count, devices.data());
+
+    const auto& required = requiredRayTracingDeviceExtensions();
+    int bestScore = -1;
+    QStringList rejected;
+
+    for (VkPhysicalDevice device : devices) {
+        VkPhysicalDeviceProperties props{};
+        vkGetPhysicalDeviceProperties(device, &props);
+        const QString name = QString::fromUtf8(props.deviceName);
+
+        if (props.apiVersion < VK_API_VERSION_1_3) {
+            rejected.append(QString("%1: Vulkan 1.3 not supported").arg(name));
+            continue;
+        }
+
+        QStringList missing;
+        if (!supportsExtensions(device, required, &missing)) {
+            rejected.append(QString("%1: missing %2").arg(name, missing.join(", ")));
+            continue;
+        }
+
+        int queueFamily = findGraphicsQueueFamily(device);
+        if (queueFamily < 0) {
+            rejected.append(QString("%1: no graphics queue").arg(name));
+            continue;
+        }
+
+        int score = deviceTypeScore(props.deviceType, m_options.preferSoftware);
+        if (score > bestScore) {
+            bestScore = score;
+            m_physicalDevice = device;
+            m_queueFamily = static_cast<uint32_t>(queueFamily);
+            m_deviceName = name;
+        }
+    }
+
+    if (m_physicalDevice == VK_NULL_HANDLE) {
+        *error = devices.empty()
+            ? QString("No Vulkan devices found")
+            : QString("No ray tracing capable device (%1)").arg(rejected.join("; "));
+        return false;
+    }
+    return true;
+}
+
+bool BatchRenderer::createDevice(QString* error) {
+    float queuePriority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo{};
+    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo.queueFamilyIndex = m_queueFamily;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &queuePriority;
+
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    m_rayTracingFeatures.enable(features);
+
+    const auto& extensions = requiredRayTracingDeviceExtensions();
+
+    VkDeviceCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = &features;
+    createInfo.queueCreateInfoCount = 1;
+    createInfo.pQueueCreateInfos = &queueInfo;
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
+
+    VkResult res = vkCreateDevice(m_physicalDevice, &createInfo, nullptr, &m_device);
+    if (res != VK_SUCCESS) {
+        *error = QString("vkCreateDevice failed on %1: %2").arg(m_deviceName).arg(static_cast<int>(res));
+        m_device = VK_NULL_HANDLE;
+        return false;
+    }
+
+    vkGetDeviceQueue(m_device, m_queueFamily, 0, &m_queue);
+    return true;
+}
+
+bool BatchRenderer::ensureRenderContext(uint32_t width, uint32_t height, QString* error) {
+    if (width == 0 || height == 0) {
+        *error = QString("Invalid resolution %1x%2").arg(width).arg(height);
+        return false;
+    }
+
+    if (m_renderContext) {
+        if (!m_frameRunner.resize(width, height, error)) {
+            return false;
+        }
+        m_renderContext->Resize(static_cast<quantiloom::u32>(width),
+                                static_cast<quantiloom::u32>(height));
+        return true;
+    }
+
+    if (!m_frameRunner.isValid() &&
+        !m_frameRunner.create(m_physicalDevice, m_device, m_queue, m_queueFamily,
+                              kTargetFormat, width, height, error)) {
+        return false;
+    }
+    if (!m_frameRunner.resize(width, height, error)) {
+        return false;
+    }
+
+    quantiloom::ExternalRenderContext::InitParams params{};
+    params.instance = m_instance;
+    params.physicalDevice = m_physicalDevice;
+    params.device = m_device;
+    params.graphicsQueue = m_queue;
+    params.graphicsQueueFamily = static_cast<quantiloom::u32>(m_queueFamily);
+    params.targetColorFormat = kTargetFormat;
+    params.width = static_cast<quantiloom::u32>(width);
+    params.height = static_cast<quantiloom::u32>(height);
+
+    // Same keyed, header-validated cache as the GUI
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_physicalDevice, &properties);
+    PipelineCacheManager pipelineCache;
+    pipelineCache.open(properties);
+    params.pipelineCacheDir = pipelineCache.directory().toStdString();
+
+    auto result = quantiloom::ExternalRenderContext::Create(params);
+    if (!result) {
+        *error = QString("Failed to create ExternalRenderContext: %1")
+            .arg(QString::fromStdString(result.error()));
+        return false;
+    }
+
+    m_renderContext = std::move(result.value());
+    m_hasEnvironmentMap = false;
+    return true;
+}
+
+void BatchRenderer::destroyRenderContext() {
+    m_frameRunner.waitIdle();
+    m_renderContext.reset();
+    m_hasEnvironmentMap = false;
+}
+
+void BatchRenderer::shutdown() {
+    if (m_device != VK_NULL_HANDLE) {
+        vkDeviceWaitIdle(m_device);
+    }
+
+    destroyRenderContext();
+    m_frameRunner.destroy();
+
+    if (m_device != VK_NULL_HANDLE) {
+        vkDestroyDevice(m_device, nullptr);
+        m_device = VK_NULL_HANDLE;
+    }
+    if (m_instance != VK_NULL_HANDLE) {
+        vkDestroyInstance(m_instance, nullptr);
+        m_instance = VK_NULL_HANDLE;
+    }
+    m_physicalDevice = VK_NULL_HANDLE;
+    m_queue = VK_NULL_HANDLE;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file BatchRenderer.hpp
+ * @brief Headless batch rendering of TOML scene configs
+ *
+ * Renders configs without MainWindow or QVulkanWindow: a private Vulkan
+ * instance/device, an offscreen target, and no present or vsync throttling.
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include "vulkan/OffscreenFrameRunner.hpp"
+#include "vulkan/RayTracingDeviceRequirements.hpp"
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+#include <vulkan/vulkan.h>
+
+struct SceneConfig;
+
+namespace quantiloom {
+class ExternalRenderContext;
+}
+
+/**
+ * @struct BatchOptions
+ * @brief Command line options for batch mode
+ */
+struct BatchOptions {
+    QStringList configPaths;      // TOML configs, rendered in order
+    bool preferSoftware = false;  // Prefer CPU (lavapipe) devices over GPUs
+    bool continueOnError = true;  // Keep going after a failed scene
+};
+
+/**
+ * @struct BatchSceneResult
+ * @brief Outcome and timing of a single batch scene
+ */
+struct BatchSceneResult {
+    QString configPath;
+    QString outputPath;
+    bool success = false;
+    QString error;
+    uint32_t samples = 0;
+    double loadSeconds = 0.0;     // Scene + environment map load
+    double renderSeconds = 0.0;   // Accumulation until target SPP
+    double wallSeconds = 0.0;     // Config load through EXR write
+
+    double samplesPerSecond() const {
+        return renderSeconds > 0.0 ? samples / renderSeconds : 0.0;
+    }
+};
+
+/**
+ * @class BatchRenderer
+ * @brief Renders a list of configs to EXR with a shared headless context
+ *
+ * One ExternalRenderContext is created for the whole batch and reused
+ * across scenes (Resize + scene reload), so pipelines are compiled once.
+ * Each scene is accumulated until renderer.spp is reached and written to
+ * renderer.output with ImageIO::WriteEXR.
+ */
+class BatchRenderer {
+public:
+    explicit BatchRenderer(BatchOptions options);
+    ~BatchRenderer();
+
+    BatchRenderer(const BatchRenderer&) = delete;
+    BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+    /**
+     * @brief Render every config
+     * @return Process exit code (0 if all scenes succeeded)
+     */
+    int run();
+
+    const QVector<BatchSceneResult>& results() const { return m_results; }
+
+private:
+    // Vulkan setup
+    bool createInstance(QString* error);
+    bool selectPhysicalDevice(QString* error);
+    bool createDevice(QString* error);
+    bool ensureRenderContext(uint32_t width, uint32_t height, QString* error);
+    void destroyRenderContext();
+    void shutdown();
+
+    // Per-scene work
+    BatchSceneResult renderConfig(const QString& configPath);
+    bool loadScene(const SceneConfig& config, QString* error);
+    void applySceneConfig(const SceneConfig& config);
+    bool accumulate(uint32_t targetSpp, QString* error);
+
+    void printSummary() const;
+
+    BatchOptions m_options;
+    QVector<BatchSceneResult> m_results;
+
+    VkInstance m_instance = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueue m_queue = VK_NULL_HANDLE;
+    uint32_t m_queueFamily = 0;
+    QString m_deviceName;
+
+    RayTracingFeatureChain m_rayTracingFeatures;
+    OffscreenFrameRunner m_frameRunner;
+    std::unique_ptr<quantiloom::ExternalRenderContext> m_renderContext;
+    bool m_hasEnvironmentMap = false;  // Context carries an environment map from a previous scene
+
+    static constexpr VkFormat kTargetFormat = VK_FORMAT_R8G8B8A8_UNORM;
+};
@@ -13,6 +13,21 @@
 
 #include <postprocess/PostprocessConfig.hpp>
 #include <renderer/LightingParams.hpp>
+#include <scene/Material.hpp>
+
+QString SceneConfig::resolvePath(const QString& path) const {
+    if (path.isEmpty() || QFileInfo(path).isAbsolute() || baseDir.isEmpty()) {
+        return path;
+    }
+    return baseDir + "/" + path;
+}
+
+QString SceneConfig::scenePath() const {
+    if (!usdPath.isEmpty()) {
+        return resolvePath(usdPath);
+    }
+    return resolvePath(gltfPath);
+}
 
 ConfigManager::ConfigManager(QObject* parent)
     : QObject(parent)
@@ -171,6 +186,51 @@ void ConfigManager::extractSceneConfig(const quantiloom::Config& config, SceneCo
     }
 }
 
+quantiloom::AtmosphericConfig ConfigManager::atmosphericConfigForPreset(const QString& preset) {
+    std::string presetStr = preset.toLower().toStdString();
+
+    if (presetStr == "clear_day") {
+        return quantiloom::AtmosphericConfig::ClearDay();
+    } else if (presetStr == "hazy") {
+        return quantiloom::AtmosphericConfig::Hazy();
+    } else if (presetStr == "polluted_urban") {
+        return quantiloom::AtmosphericConfig::PollutedUrban();
+    } else if (presetStr == "mountain_top") {
+        return quantiloom::AtmosphericConfig::MountainTop();
+    } else if (presetStr == "mars") {
+        return quantiloom::AtmosphericConfig::Mars();
+    }
+    return quantiloom::AtmosphericConfig::Disabled();
+}
+
+void ConfigManager::applyMaterialConfig(const MaterialConfig& config, quantiloom::Material& material) {
+    // Set IR curves with constant values across IR bands
+    const float mwir_nm = 4000.0f;
+    const float lwir_nm = 10000.0f;
+
+    if (config.irEmissivity > 0.0f) {
+        material.irEmissivityCurve.clear();
+        material.irEmissivityCurve.push_back({mwir_nm, config.irEmissivity});
+        material.irEmissivityCurve.push_back({lwir_nm, config.irEmissivity});
+    }
+
+    if (config.irTransmittance > 0.0f) {
+        material.irTransmittanceCurve.clear();
+        material.irTransmittanceCurve.push_back({mwir_nm, config.irTransmittance});
+        material.irTransmittanceCurve.push_back({lwir_nm, config.irTransmittance});
+    }
+
+    // Compute and set reflectance from energy conservation
+    float reflectance = 1.0f - config.irEmissivity - config.irTransmittance;
+    if (reflectance > 0.0f) {
+        material.irReflectanceCurve.clear();
+        material.irReflectanceCurve.push_back({mwir_nm, reflectance});
+        material.irReflectanceCurve.push_back({lwir_nm, reflectance});
+    }
+
+    material.irTemperature_K = config.irTemperature_K;
+}
+
 quantiloom::SpectralMode ConfigManager::parseSpectralMode(const std::string& modeStr) {
     std::string lower;
     lower.reserve(modeStr.size());
@@ -11,8 +11,13 @@
 #include <core/Config.hpp>
 #include <core/Types.hpp>
 #include <renderer/LightingParams.hpp>
+#include <renderer/AtmosphericConfig.hpp>
 #include <postprocess/SensorModel.hpp>
 
+namespace quantiloom {
+struct Material;
+}
+
 /**
  * @struct MaterialConfig
  * @brief IR material overrides from TOML config
@@ -70,6 +75,18 @@ struct SceneConfig {
 
     // Config file base directory (for resolving relative paths)
     QString baseDir;
+
+    /**
+     * @brief Resolve a config-relative path against baseDir
+     * @return Absolute path, or the input unchanged if already absolute or empty
+     */
+    QString resolvePath(const QString& path) const;
+
+    /**
+     * @brief Resolved scene file path (USD takes precedence over glTF)
+     * @return Empty string if no scene is specified
+     */
+    QString scenePath() const;
 };
 
 /**
@@ -106,6 +123,21 @@ public:
      */
     bool exportConfig(const QString& filePath, const SceneConfig& config);
 
+    /**
+     * @brief Map an atmospheric preset name to its SDK configuration
+     * @param preset Preset name (clear_day, hazy, polluted_urban, mountain_top, mars)
+     * @return Matching config, or AtmosphericConfig::Disabled() for unknown names
+     */
+    static quantiloom::AtmosphericConfig atmosphericConfigForPreset(const QString& preset);
+
+    /**
+     * @brief Apply an IR material override to a material
+     *
+     * Sets constant emissivity/transmittance curves across MWIR/LWIR, derives
+     * reflectance from energy conservation, and sets surface temperature.
+     */
+    static void applyMaterialConfig(const MaterialConfig& config, quantiloom::Material& material);
+
     /**
      * @brief Get last error message
      */
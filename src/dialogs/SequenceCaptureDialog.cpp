@@ -0,0 +1,154 @@
+#include "SequenceCaptureDialog.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QPushButton>
+#include <QFileDialog>
+#include <QDialogButtonBox>
+#include <QGroupBox>
+#include <QLabel>
+#include <QSettings>
+#include <QDir>
+#include <QStandardPaths>
+
+SequenceCaptureDialog::SequenceCaptureDialog(QWidget* parent)
+    : QDialog(parent)
+{
+    setWindowTitle(tr("Record Image Sequence"));
+    setMinimumWidth(500);
+    setupUi();
+    loadSettings();
+}
+
+void SequenceCaptureDialog::setupUi() {
+    auto* mainLayout = new QVBoxLayout(this);
+
+    // Output
+    auto* outputGroup = new QGroupBox(tr("Output"));
+    auto* outputLayout = new QFormLayout(outputGroup);
+
+    auto* pathLayout = new QHBoxLayout();
+    m_directoryEdit = new QLineEdit();
+    auto* browseButton = new QPushButton(tr("Browse..."));
+    connect(browseButton, &QPushButton::clicked, this, &SequenceCaptureDialog::onBrowse);
+    pathLayout->addWidget(m_directoryEdit);
+    pathLayout->addWidget(browseButton);
+    outputLayout->addRow(tr("Directory:"), pathLayout);
+
+    m_prefixEdit = new QLineEdit();
+    m_prefixEdit->setToolTip(tr("Files are named <prefix>_000000.png, <prefix>_000001.png, ..."));
+    outputLayout->addRow(tr("File Prefix:"), m_prefixEdit);
+
+    m_formatCombo = new QComboBox();
+    m_formatCombo->addItem(tr("PNG (display image, no stall)"), static_cast<int>(ImageExportFormat::PNG));
+    m_formatCombo->addItem(tr("EXR (HDR, brief stall per frame)"), static_cast<int>(ImageExportFormat::EXR));
+    outputLayout->addRow(tr("Format:"), m_formatCombo);
+
+    mainLayout->addWidget(outputGroup);
+
+    // Pacing
+    auto* pacingGroup = new QGroupBox(tr("Pacing"));
+    auto* pacingLayout = new QFormLayout(pacingGroup);
+
+    m_triggerCombo = new QComboBox();
+    m_triggerCombo->addItem(tr("Every N frames (fly-through)"), static_cast<int>(SequenceTrigger::Frames));
+    m_triggerCombo->addItem(tr("Every K samples (convergence)"), static_cast<int>(SequenceTrigger::Samples));
+    pacingLayout->addRow(tr("Capture:"), m_triggerCombo);
+
+    m_intervalSpin = new QSpinBox();
+    m_intervalSpin->setRange(1, 65536);
+    pacingLayout->addRow(tr("Interval:"), m_intervalSpin);
+
+    m_maxFramesSpin = new QSpinBox();
+    m_maxFramesSpin->setRange(0, 1000000);
+    m_maxFramesSpin->setSpecialValueText(tr("Until stopped"));
+    pacingLayout->addRow(tr("Max Frames:"), m_maxFramesSpin);
+
+    m_bandwidthSpin = new QDoubleSpinBox();
+    m_bandwidthSpin->setRange(0.0, 10000.0);
+    m_bandwidthSpin->setDecimals(1);
+    m_bandwidthSpin->setSuffix(tr(" MB/s"));
+    m_bandwidthSpin->setSpecialValueText(tr("Unlimited"));
+    m_bandwidthSpin->setToolTip(tr("Capture points are skipped while writes exceed this rate"));
+    pacingLayout->addRow(tr("Disk Bandwidth Cap:"), m_bandwidthSpin);
+
+    mainLayout->addWidget(pacingGroup);
+
+    // Dialog buttons
+    auto* buttonBox = new QDialogButtonBox(
+        QDialogButtonBox::Ok | QDialogButtonBox::Cancel
+    );
+    buttonBox->button(QDialogButtonBox::Ok)->setText(tr("Start Recording"));
+    connect(buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    mainLayout->addWidget(buttonBox);
+}
+
+void SequenceCaptureDialog::loadSettings() {
+    QSettings settings;
+    settings.beginGroup("sequence_capture");
+
+    QString directory = settings.value("directory").toString();
+    if (directory.isEmpty()) {
+        directory = QDir(QStandardPaths::writableLocation(QStandardPaths::PicturesLocation))
+            .filePath("Quantiloom/sequences");
+    }
+    m_directoryEdit->setText(directory);
+    m_prefixEdit->setText(settings.value("prefix", "frame").toString());
+    m_formatCombo->setCurrentIndex(qMax(0, m_formatCombo->findData(settings.value("format", 0).toInt())));
+    m_triggerCombo->setCurrentIndex(qMax(0, m_triggerCombo->findData(settings.value("trigger", 0).toInt())));
+    m_intervalSpin->setValue(settings.value("interval", 10).toInt());
+    m_maxFramesSpin->setValue(settings.value("max_frames", 0).toInt());
+    m_bandwidthSpin->setValue(settings.value("max_mb_per_second", 0.0).toDouble());
+
+    settings.endGroup();
+}
+
+SequenceCaptureSettings SequenceCaptureDialog::settings() const {
+    SequenceCaptureSettings result;
+    result.directory = m_directoryEdit->text().trimmed();
+    result.prefix = m_prefixEdit->text().trimmed();
+    if (result.prefix.isEmpty()) {
+        result.prefix = QStringLiteral("frame");
+    }
+    result.format = static_cast<ImageExportFormat>(m_formatCombo->currentData().toInt());
+    result.trigger = static_cast<SequenceTrigger>(m_triggerCombo->currentData().toInt());
+    result.interval = static_cast<uint32_t>(m_intervalSpin->value());
+    result.maxFrames = static_cast<uint32_t>(m_maxFramesSpin->value());
+    result.maxMegabytesPerSecond = m_bandwidthSpin->value();
+    return result;
+}
+
+void SequenceCaptureDialog::accept() {
+    const SequenceCaptureSettings current = settings();
+
+    QSettings settings;
+    settings.beginGroup("sequence_capture");
+    settings.setValue("directory", current.directory);
+    settings.setValue("prefix", current.prefix);
+    settings.setValue("format", static_cast<int>(current.format));
+    settings.setValue("trigger", static_cast<int>(current.trigger));
+    settings.setValue("interval", current.interval);
+    settings.setValue("max_frames", current.maxFrames);
+    settings.setValue("max_mb_per_second", current.maxMegabytesPerSecond);
+    settings.endGroup();
+
+    QDialog::accept();
+}
+
+void SequenceCaptureDialog::onBrowse() {
+    QString dir = QFileDialog::getExistingDirectory(
+        this,
+        tr("Select Sequence Output Directory"),
+        m_directoryEdit->text(),
+        QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks
+    );
+
+    if (!dir.isEmpty()) {
+        m_directoryEdit->setText(dir);
+    }
+}
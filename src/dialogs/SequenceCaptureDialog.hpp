@@ -0,0 +1,42 @@
+#pragma once
+
+#include "export/SequenceCapture.hpp"
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QLineEdit;
+class QComboBox;
+class QSpinBox;
+class QDoubleSpinBox;
+QT_END_NAMESPACE
+
+/**
+ * @class SequenceCaptureDialog
+ * @brief Configures an image sequence recording (remembers the last settings)
+ */
+class SequenceCaptureDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit SequenceCaptureDialog(QWidget* parent = nullptr);
+
+    SequenceCaptureSettings settings() const;
+
+    void accept() override;
+
+private slots:
+    void onBrowse();
+
+private:
+    void setupUi();
+    void loadSettings();
+
+    QLineEdit* m_directoryEdit = nullptr;
+    QLineEdit* m_prefixEdit = nullptr;
+    QComboBox* m_formatCombo = nullptr;
+    QComboBox* m_triggerCombo = nullptr;
+    QSpinBox* m_intervalSpin = nullptr;
+    QSpinBox* m_maxFramesSpin = nullptr;
+    QDoubleSpinBox* m_bandwidthSpin = nullptr;
+};
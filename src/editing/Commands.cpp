@@ -10,6 +10,28 @@
 #include <renderer/LightingParams.hpp>
 #include <QCoreApplication>
 
+namespace {
+
+template <typename T>
+size_t vectorBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+// Heap owned by a material (the spectral curves dominate)
+size_t materialHeapBytes(const quantiloom::Material& material) {
+    return material.name.capacity()
+        + vectorBytes(material.irEmissivityCurve)
+        + vectorBytes(material.irTransmittanceCurve)
+        + vectorBytes(material.irReflectanceCurve);
+}
+
+size_t setBytes(const QSet<int>& set) {
+    // Hash node: key plus bucket bookkeeping
+    return static_cast<size_t>(set.capacity()) * (sizeof(int) + sizeof(void*));
+}
+
+} // namespace
+
 // ============================================================================
 // TransformNodeCommand
 // ============================================================================
@@ -51,6 +73,10 @@ bool TransformNodeCommand::mergeWith(const Command* other) {
     return true;
 }
 
+size_t TransformNodeCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes();
+}
+
 // ============================================================================
 // MultiTransformCommand
 // ============================================================================
@@ -70,6 +96,7 @@ MultiTransformCommand::MultiTransformCommand(QuantiloomVulkanWindow* window,
 void MultiTransformCommand::execute() {
     if (!m_window) return;
 
+    SceneEditBatch batch(m_window);
     for (const auto& t : m_transforms) {
         m_window->setNodeTransform(t.nodeIndex, t.newTransform);
     }
@@ -79,11 +106,16 @@ void MultiTransformCommand::undo() {
     if (!m_window) return;
 
     // Undo in reverse order
+    SceneEditBatch batch(m_window);
     for (auto it = m_transforms.rbegin(); it != m_transforms.rend(); ++it) {
         m_window->setNodeTransform(it->nodeIndex, it->oldTransform);
     }
 }
 
+size_t MultiTransformCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes() + vectorBytes(m_transforms);
+}
+
 // ============================================================================
 // ModifyMaterialCommand
 // ============================================================================
@@ -125,6 +157,111 @@ bool ModifyMaterialCommand::mergeWith(const Command* other) {
     return true;
 }
 
+size_t ModifyMaterialCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes()
+        + materialHeapBytes(m_oldMaterial) + materialHeapBytes(m_newMaterial);
+}
+
+// ============================================================================
+// MaterialDeltaCommand
+// ============================================================================
+
+MaterialDeltaCommand::MaterialDeltaCommand(QuantiloomVulkanWindow* window,
+                                           int materialIndex,
+                                           const MaterialDelta& delta,
+                                           const QString& description)
+    : Command(description.isEmpty()
+        ? QCoreApplication::translate("Commands", "Modify %1").arg(delta.describe())
+        : description)
+    , m_window(window)
+    , m_materialIndex(materialIndex)
+    , m_delta(delta)
+    , m_autoDescription(description.isEmpty())
+{
+}
+
+void MaterialDeltaCommand::execute() {
+    apply(true);
+}
+
+void MaterialDeltaCommand::undo() {
+    apply(false);
+}
+
+void MaterialDeltaCommand::apply(bool forward) {
+    if (!m_window || m_materialIndex < 0 || m_delta.isEmpty()) {
+        return;
+    }
+    const quantiloom::Material* current = m_window->material(m_materialIndex);
+    if (!current) {
+        return;
+    }
+
+    // The SDK takes a whole material, so patch a copy of the current one
+    quantiloom::Material material = *current;
+    m_delta.applyTo(material, forward);
+    m_window->updateMaterial(m_materialIndex, material);
+}
+
+bool MaterialDeltaCommand::mergeWith(const Command* other) {
+    auto* otherCmd = dynamic_cast<const MaterialDeltaCommand*>(other);
+    if (!otherCmd || otherCmd->m_materialIndex != m_materialIndex) {
+        return false;
+    }
+    m_delta.mergeWith(otherCmd->m_delta);
+    if (m_autoDescription && !m_delta.isEmpty()) {
+        m_description = QCoreApplication::translate("Commands", "Modify %1").arg(m_delta.describe());
+    }
+    return true;
+}
+
+size_t MaterialDeltaCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes() + m_delta.heapBytes();
+}
+
+// ============================================================================
+// ModifyLightingCommand
+// ============================================================================
+
+ModifyLightingCommand::ModifyLightingCommand(QuantiloomVulkanWindow* window,
+                                             const quantiloom::LightingParams& oldParams,
+                                             const quantiloom::LightingParams& newParams,
+                                             const QString& description)
+    : Command(description.isEmpty()
+        ? QCoreApplication::translate("Commands", "Modify Lighting")
+        : description)
+    , m_window(window)
+    , m_oldParams(oldParams)
+    , m_newParams(newParams)
+{
+}
+
+void ModifyLightingCommand::execute() {
+    if (m_window) {
+        m_window->setLightingParams(m_newParams);
+    }
+}
+
+void ModifyLightingCommand::undo() {
+    if (m_window) {
+        m_window->setLightingParams(m_oldParams);
+    }
+}
+
+bool ModifyLightingCommand::mergeWith(const Command* other) {
+    auto* otherCmd = dynamic_cast<const ModifyLightingCommand*>(other);
+    if (!otherCmd) {
+        return false;
+    }
+    // Keep our old params, take their new params
+    m_newParams = otherCmd->m_newParams;
+    return true;
+}
+
+size_t ModifyLightingCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes();
+}
+
 // ============================================================================
 // SelectionCommand
 // ============================================================================
@@ -151,12 +288,17 @@ void SelectionCommand::undo() {
     }
 }
 
+size_t SelectionCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes() + setBytes(m_oldSelection) + setBytes(m_newSelection);
+}
+
 // ============================================================================
 // CompositeCommand
 // ============================================================================
 
-CompositeCommand::CompositeCommand(const QString& description)
+CompositeCommand::CompositeCommand(const QString& description, QuantiloomVulkanWindow* window)
     : Command(description)
+    , m_window(window)
 {
 }
 
@@ -165,6 +307,7 @@ void CompositeCommand::addCommand(std::unique_ptr<Command> command) {
 }
 
 void CompositeCommand::execute() {
+    SceneEditBatch batch(m_window);
     for (auto& cmd : m_commands) {
         cmd->execute();
     }
@@ -172,21 +315,32 @@ void CompositeCommand::execute() {
 
 void CompositeCommand::undo() {
     // Undo in reverse order
+    SceneEditBatch batch(m_window);
     for (auto it = m_commands.rbegin(); it != m_commands.rend(); ++it) {
         (*it)->undo();
     }
 }
 
+size_t CompositeCommand::memoryFootprint() const {
+    size_t bytes = sizeof(*this) + descriptionBytes() + vectorBytes(m_commands);
+    for (const auto& cmd : m_commands) {
+        bytes += cmd->memoryFootprint();
+    }
+    return bytes;
+}
+
 // ============================================================================
 // LambdaCommand
 // ============================================================================
 
 LambdaCommand::LambdaCommand(const QString& description,
                              Action executeFunc,
-                             Action undoFunc)
+                             Action undoFunc,
+                             size_t capturedBytes)
     : Command(description)
     , m_execute(std::move(executeFunc))
     , m_undo(std::move(undoFunc))
+    , m_capturedBytes(capturedBytes)
 {
 }
 
@@ -201,3 +355,7 @@ void LambdaCommand::undo() {
         m_undo();
     }
 }
+
+size_t LambdaCommand::memoryFootprint() const {
+    return sizeof(*this) + descriptionBytes() + m_capturedBytes;
+}
@@ -11,9 +11,11 @@
 #pragma once
 
 #include "UndoStack.hpp"
+#include "MaterialDelta.hpp"
 #include <QSet>
 #include <scene/Mesh.hpp>
 #include <scene/Material.hpp>
+#include <renderer/LightingParams.hpp>
 #include <glm/glm.hpp>
 #include <functional>
 
@@ -21,10 +23,6 @@
 class QuantiloomVulkanWindow;
 class SelectionManager;
 
-namespace quantiloom {
-struct LightingParams;
-}
-
 // Command IDs for merging
 enum class CommandId {
     TransformNode = 1,
@@ -50,6 +48,7 @@ public:
     void undo() override;
     bool mergeWith(const Command* other) override;
     [[nodiscard]] int id() const override { return static_cast<int>(CommandId::TransformNode); }
+    [[nodiscard]] size_t memoryFootprint() const override;
 
 private:
     QuantiloomVulkanWindow* m_window;
@@ -76,6 +75,7 @@ public:
 
     void execute() override;
     void undo() override;
+    [[nodiscard]] size_t memoryFootprint() const override;
 
 private:
     QuantiloomVulkanWindow* m_window;
@@ -97,7 +97,9 @@ public:
     void execute() override;
     void undo() override;
     bool mergeWith(const Command* other) override;
+    [[nodiscard]] bool isObsolete() const override { return m_delta.isEmpty(); }
     [[nodiscard]] int id() const override { return static_cast<int>(CommandId::ModifyMaterial); }
+    [[nodiscard]] size_t memoryFootprint() const override;
 
 private:
     QuantiloomVulkanWindow* m_window;
@@ -106,6 +108,60 @@ private:
     quantiloom::Material m_newMaterial;
 };
 
+/**
+ * @class MaterialDeltaCommand
+ * @brief Command for changing some fields of a material
+ *
+ * Stores only the changed fields; curves are shared with neighbouring
+ * commands. Merges with the previous edit of the same material, and is
+ * discarded if the merged edits cancel out.
+ */
+class MaterialDeltaCommand : public Command {
+public:
+    MaterialDeltaCommand(QuantiloomVulkanWindow* window,
+                         int materialIndex,
+                         const MaterialDelta& delta,
+                         const QString& description = QString());
+
+    void execute() override;
+    void undo() override;
+    bool mergeWith(const Command* other) override;
+    [[nodiscard]] bool isObsolete() const override { return m_delta.isEmpty(); }
+    [[nodiscard]] int id() const override { return static_cast<int>(CommandId::ModifyMaterial); }
+    [[nodiscard]] size_t memoryFootprint() const override;
+
+private:
+    void apply(bool forward);
+
+    QuantiloomVulkanWindow* m_window;
+    int m_materialIndex;
+    MaterialDelta m_delta;
+    bool m_autoDescription;
+};
+
+/**
+ * @class ModifyLightingCommand
+ * @brief Command for changing sun/sky lighting
+ */
+class ModifyLightingCommand : public Command {
+public:
+    ModifyLightingCommand(QuantiloomVulkanWindow* window,
+                          const quantiloom::LightingParams& oldParams,
+                          const quantiloom::LightingParams& newParams,
+                          const QString& description = QString());
+
+    void execute() override;
+    void undo() override;
+    bool mergeWith(const Command* other) override;
+    [[nodiscard]] int id() const override { return static_cast<int>(CommandId::ModifyLighting); }
+    [[nodiscard]] size_t memoryFootprint() const override;
+
+private:
+    QuantiloomVulkanWindow* m_window;
+    quantiloom::LightingParams m_oldParams;
+    quantiloom::LightingParams m_newParams;
+};
+
 /**
  * @class SelectionCommand
  * @brief Command for changing selection (optional, for selection undo)
@@ -118,6 +174,7 @@ public:
 
     void execute() override;
     void undo() override;
+    [[nodiscard]] size_t memoryFootprint() const override;
 
 private:
     SelectionManager* m_manager;
@@ -128,18 +185,24 @@ private:
 /**
  * @class CompositeCommand
  * @brief Groups multiple commands into one undoable action
+ *
+ * With a window, the children run inside one SceneEditBatch, so their
+ * scene edits are applied together when the command finishes.
  */
 class CompositeCommand : public Command {
 public:
-    explicit CompositeCommand(const QString& description);
+    explicit CompositeCommand(const QString& description,
+                              QuantiloomVulkanWindow* window = nullptr);
 
     void addCommand(std::unique_ptr<Command> command);
     void execute() override;
     void undo() override;
+    [[nodiscard]] size_t memoryFootprint() const override;
 
     [[nodiscard]] bool isEmpty() const { return m_commands.empty(); }
 
 private:
+    QuantiloomVulkanWindow* m_window;
     std::vector<std::unique_ptr<Command>> m_commands;
 };
 
@@ -153,14 +216,18 @@ class LambdaCommand : public Command {
 public:
     using Action = std::function<void()>;
 
+    // capturedBytes: heap state owned by the lambdas' captures (not measurable here)
     LambdaCommand(const QString& description,
                   Action executeFunc,
-                  Action undoFunc);
+                  Action undoFunc,
+                  size_t capturedBytes = 0);
 
     void execute() override;
     void undo() override;
+    [[nodiscard]] size_t memoryFootprint() const override;
 
 private:
     Action m_execute;
     Action m_undo;
+    size_t m_capturedBytes = 0;
 };
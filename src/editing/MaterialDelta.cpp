@@ -0,0 +1,244 @@
+/**
+ * @file MaterialDelta.cpp
+ * @brief MaterialDelta implementation
+ */
+
+#include "MaterialDelta.hpp"
+
+#include <QCoreApplication>
+#include <QHashFunctions>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Sweep expired pool slots after this many interns
+constexpr int kPoolSweepInterval = 256;
+
+struct CurvePool {
+    std::unordered_map<size_t, std::vector<std::weak_ptr<const MaterialCurve>>> buckets;
+    int internsSinceSweep = 0;
+};
+
+CurvePool& curvePool() {
+    static CurvePool pool;
+    return pool;
+}
+
+size_t curveHash(const MaterialCurve& curve) {
+    size_t seed = curve.size();
+    for (const auto& point : curve) {
+        seed = qHashMulti(seed, point.first, point.second);
+    }
+    return seed;
+}
+
+void sweepPool(CurvePool& pool) {
+    for (auto it = pool.buckets.begin(); it != pool.buckets.end();) {
+        auto& slots = it->second;
+        std::erase_if(slots, [](const auto& weak) { return weak.expired(); });
+        it = slots.empty() ? pool.buckets.erase(it) : std::next(it);
+    }
+    pool.internsSinceSweep = 0;
+}
+
+// Shared curves are equal by pointer when interned; fall back to content otherwise
+bool sameCurve(const SharedMaterialCurve& a, const SharedMaterialCurve& b) {
+    if (a == b) {
+        return true;
+    }
+    const bool aEmpty = !a || a->empty();
+    const bool bEmpty = !b || b->empty();
+    if (aEmpty || bEmpty) {
+        return aEmpty && bEmpty;
+    }
+    return *a == *b;
+}
+
+bool sameCurve(const SharedMaterialCurve& shared, const MaterialCurve& curve) {
+    return shared ? *shared == curve : curve.empty();
+}
+
+size_t sharedCurveBytes(const SharedMaterialCurve& curve) {
+    if (!curve) {
+        return 0;
+    }
+    const size_t bytes = curve->capacity() * sizeof(MaterialCurve::value_type);
+    return bytes / static_cast<size_t>(std::max(1L, curve.use_count()));
+}
+
+QString fieldName(uint32_t field) {
+    switch (field) {
+        case MaterialBaseColor: return QCoreApplication::translate("MaterialDelta", "Base Color");
+        case MaterialMetallic: return QCoreApplication::translate("MaterialDelta", "Metallic");
+        case MaterialRoughness: return QCoreApplication::translate("MaterialDelta", "Roughness");
+        case MaterialEmissive: return QCoreApplication::translate("MaterialDelta", "Emissive");
+        case MaterialIrEmissivity: return QCoreApplication::translate("MaterialDelta", "IR Emissivity");
+        case MaterialIrTransmittance: return QCoreApplication::translate("MaterialDelta", "IR Transmittance");
+        case MaterialIrReflectance: return QCoreApplication::translate("MaterialDelta", "IR Reflectance");
+        case MaterialIrTemperature: return QCoreApplication::translate("MaterialDelta", "IR Temperature");
+        default: return QString();
+    }
+}
+
+} // namespace
+
+SharedMaterialCurve internMaterialCurve(const MaterialCurve& curve) {
+    if (curve.empty()) {
+        return nullptr;
+    }
+
+    CurvePool& pool = curvePool();
+    if (++pool.internsSinceSweep >= kPoolSweepInterval) {
+        sweepPool(pool);
+    }
+
+    auto& slots = pool.buckets[curveHash(curve)];
+    for (const auto& weak : slots) {
+        if (auto shared = weak.lock(); shared && *shared == curve) {
+            return shared;
+        }
+    }
+
+    auto shared = std::make_shared<const MaterialCurve>(curve);
+    slots.push_back(shared);
+    return shared;
+}
+
+MaterialDelta MaterialDelta::fromEdit(const quantiloom::Material& current,
+                                      const MaterialFieldValues& edited,
+                                      uint32_t fields) {
+    MaterialDelta delta;
+    auto record = [&](MaterialField field, bool changed, auto member, auto currentValue) {
+        if ((fields & field) && changed) {
+            delta.m_fields |= field;
+            delta.m_before.*member = currentValue;
+            delta.m_after.*member = edited.*member;
+        }
+    };
+
+    record(MaterialBaseColor, current.baseColorFactor != edited.baseColor,
+           &MaterialFieldValues::baseColor, current.baseColorFactor);
+    record(MaterialMetallic, current.metallicFactor != edited.metallic,
+           &MaterialFieldValues::metallic, current.metallicFactor);
+    record(MaterialRoughness, current.roughnessFactor != edited.roughness,
+           &MaterialFieldValues::roughness, current.roughnessFactor);
+    record(MaterialEmissive, current.emissiveFactor != edited.emissive,
+           &MaterialFieldValues::emissive, current.emissiveFactor);
+    record(MaterialIrTemperature, current.irTemperature_K != edited.irTemperature_K,
+           &MaterialFieldValues::irTemperature_K, current.irTemperature_K);
+
+    // Curves are only interned (hashed, possibly copied) when they actually changed
+    auto recordCurve = [&](MaterialField field, SharedMaterialCurve MaterialFieldValues::* member,
+                           const MaterialCurve& currentCurve) {
+        if ((fields & field) && !sameCurve(edited.*member, currentCurve)) {
+            delta.m_fields |= field;
+            delta.m_before.*member = internMaterialCurve(currentCurve);
+            delta.m_after.*member = edited.*member;
+        }
+    };
+
+    recordCurve(MaterialIrEmissivity, &MaterialFieldValues::irEmissivity, current.irEmissivityCurve);
+    recordCurve(MaterialIrTransmittance, &MaterialFieldValues::irTransmittance, current.irTransmittanceCurve);
+    recordCurve(MaterialIrReflectance, &MaterialFieldValues::irReflectance, current.irReflectanceCurve);
+
+    return delta;
+}
+
+void MaterialDelta::applyTo(quantiloom::Material& material, bool forward) const {
+    const MaterialFieldValues& values = forward ? m_after : m_before;
+    auto assignCurve = [](MaterialCurve& target, const SharedMaterialCurve& source) {
+        if (source) {
+            target = *source;
+        } else {
+            target.clear();
+        }
+    };
+
+    if (m_fields & MaterialBaseColor) material.baseColorFactor = values.baseColor;
+    if (m_fields & MaterialMetallic) material.metallicFactor = values.metallic;
+    if (m_fields & MaterialRoughness) material.roughnessFactor = values.roughness;
+    if (m_fields & MaterialEmissive) material.emissiveFactor = values.emissive;
+    if (m_fields & MaterialIrEmissivity) assignCurve(material.irEmissivityCurve, values.irEmissivity);
+    if (m_fields & MaterialIrTransmittance) assignCurve(material.irTransmittanceCurve, values.irTransmittance);
+    if (m_fields & MaterialIrReflectance) assignCurve(material.irReflectanceCurve, values.irReflectance);
+    if (m_fields & MaterialIrTemperature) material.irTemperature_K = values.irTemperature_K;
+}
+
+void MaterialDelta::mergeWith(const MaterialDelta& later) {
+    auto take = [&](MaterialField field, auto member) {
+        if (!(later.m_fields & field)) {
+            return;
+        }
+        if (!(m_fields & field)) {
+            m_before.*member = later.m_before.*member;
+        }
+        m_after.*member = later.m_after.*member;
+    };
+
+    take(MaterialBaseColor, &MaterialFieldValues::baseColor);
+    take(MaterialMetallic, &MaterialFieldValues::metallic);
+    take(MaterialRoughness, &MaterialFieldValues::roughness);
+    take(MaterialEmissive, &MaterialFieldValues::emissive);
+    take(MaterialIrEmissivity, &MaterialFieldValues::irEmissivity);
+    take(MaterialIrTransmittance, &MaterialFieldValues::irTransmittance);
+    take(MaterialIrReflectance, &MaterialFieldValues::irReflectance);
+    take(MaterialIrTemperature, &MaterialFieldValues::irTemperature_K);
+
+    m_fields |= later.m_fields;
+    dropUnchanged();
+}
+
+void MaterialDelta::dropUnchanged() {
+    // A drag that returns to its starting value leaves nothing to undo
+    auto drop = [&](MaterialField field, bool unchanged) {
+        if ((m_fields & field) && unchanged) {
+            m_fields &= ~static_cast<uint32_t>(field);
+        }
+    };
+
+    drop(MaterialBaseColor, m_before.baseColor == m_after.baseColor);
+    drop(MaterialMetallic, m_before.metallic == m_after.metallic);
+    drop(MaterialRoughness, m_before.roughness == m_after.roughness);
+    drop(MaterialEmissive, m_before.emissive == m_after.emissive);
+    drop(MaterialIrEmissivity, sameCurve(m_before.irEmissivity, m_after.irEmissivity));
+    drop(MaterialIrTransmittance, sameCurve(m_before.irTransmittance, m_after.irTransmittance));
+    drop(MaterialIrReflectance, sameCurve(m_before.irReflectance, m_after.irReflectance));
+    drop(MaterialIrTemperature, m_before.irTemperature_K == m_after.irTemperature_K);
+}
+
+QString MaterialDelta::describe() const {
+    if (m_fields == 0) {
+        return QString();
+    }
+
+    // Single field: name it, with values for the scalar ones
+    if ((m_fields & (m_fields - 1)) == 0) {
+        const QString name = fieldName(m_fields);
+        switch (m_fields) {
+            case MaterialMetallic:
+                return QString("%1 %2 -> %3").arg(name)
+                    .arg(m_before.metallic, 0, 'f', 2).arg(m_after.metallic, 0, 'f', 2);
+            case MaterialRoughness:
+                return QString("%1 %2 -> %3").arg(name)
+                    .arg(m_before.roughness, 0, 'f', 2).arg(m_after.roughness, 0, 'f', 2);
+            case MaterialIrTemperature:
+                return QString("%1 %2 K -> %3 K").arg(name)
+                    .arg(m_before.irTemperature_K, 0, 'f', 1).arg(m_after.irTemperature_K, 0, 'f', 1);
+            default:
+                return name;
+        }
+    }
+
+    if ((m_fields & ~static_cast<uint32_t>(MaterialIrFields)) == 0) {
+        return QCoreApplication::translate("MaterialDelta", "IR Properties");
+    }
+    return QCoreApplication::translate("MaterialDelta", "Material Properties");
+}
+
+size_t MaterialDelta::heapBytes() const {
+    return sharedCurveBytes(m_before.irEmissivity) + sharedCurveBytes(m_after.irEmissivity)
+        + sharedCurveBytes(m_before.irTransmittance) + sharedCurveBytes(m_after.irTransmittance)
+        + sharedCurveBytes(m_before.irReflectance) + sharedCurveBytes(m_after.irReflectance);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file MaterialDelta.hpp
+ * @brief Field-level material change with copy-on-write curve storage
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QString>
+#include <scene/Material.hpp>
+#include <cstdint>
+#include <memory>
+
+using MaterialCurve = decltype(quantiloom::Material::irEmissivityCurve);
+
+// Immutable once created; shared by every delta that holds the same curve
+using SharedMaterialCurve = std::shared_ptr<const MaterialCurve>;
+
+/**
+ * @brief Return the shared instance of a curve, creating it if no live one matches
+ *
+ * Curves are pooled by content, so an edit whose "before" curve is the
+ * previous edit's "after" curve costs no allocation. GUI thread only.
+ */
+SharedMaterialCurve internMaterialCurve(const MaterialCurve& curve);
+
+// Fields a MaterialDelta can record
+enum MaterialField : uint32_t {
+    MaterialBaseColor       = 1u << 0,
+    MaterialMetallic        = 1u << 1,
+    MaterialRoughness       = 1u << 2,
+    MaterialEmissive        = 1u << 3,
+    MaterialIrEmissivity    = 1u << 4,
+    MaterialIrTransmittance = 1u << 5,
+    MaterialIrReflectance   = 1u << 6,
+    MaterialIrTemperature   = 1u << 7,
+
+    MaterialIrFields = MaterialIrEmissivity | MaterialIrTransmittance |
+                       MaterialIrReflectance | MaterialIrTemperature
+};
+
+/**
+ * @struct MaterialFieldValues
+ * @brief Values of the editable material fields (only those in a mask are meaningful)
+ */
+struct MaterialFieldValues {
+    decltype(quantiloom::Material::baseColorFactor) baseColor{};
+    decltype(quantiloom::Material::metallicFactor) metallic{};
+    decltype(quantiloom::Material::roughnessFactor) roughness{};
+    decltype(quantiloom::Material::emissiveFactor) emissive{};
+    SharedMaterialCurve irEmissivity;
+    SharedMaterialCurve irTransmittance;
+    SharedMaterialCurve irReflectance;
+    decltype(quantiloom::Material::irTemperature_K) irTemperature_K{};
+};
+
+/**
+ * @class MaterialDelta
+ * @brief The fields an edit changed, with their values before and after
+ *
+ * Unchanged fields (and the material name) are not stored, so a slider
+ * drag records two floats rather than two full Material copies.
+ */
+class MaterialDelta {
+public:
+    MaterialDelta() = default;
+
+    /**
+     * @brief Diff the edited fields of a material against new values
+     * @param fields Mask of MaterialField; fields whose value is unchanged are dropped
+     */
+    static MaterialDelta fromEdit(const quantiloom::Material& current,
+                                  const MaterialFieldValues& edited,
+                                  uint32_t fields);
+
+    /**
+     * @brief Write the recorded fields into a material
+     * @param forward true for the new values (redo), false for the old ones (undo)
+     */
+    void applyTo(quantiloom::Material& material, bool forward) const;
+
+    /**
+     * @brief Fold a later delta into this one (earliest "before", latest "after")
+     */
+    void mergeWith(const MaterialDelta& later);
+
+    [[nodiscard]] uint32_t fields() const { return m_fields; }
+    [[nodiscard]] bool isEmpty() const { return m_fields == 0; }
+
+    // Short label, e.g. "Roughness 0.40 -> 0.50"
+    [[nodiscard]] QString describe() const;
+
+    // Heap bytes owned; shared curves are split between their holders
+    [[nodiscard]] size_t heapBytes() const;
+
+private:
+    void dropUnchanged();
+
+    uint32_t m_fields = 0;
+    MaterialFieldValues m_before;
+    MaterialFieldValues m_after;
+};
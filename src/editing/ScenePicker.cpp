@@ -0,0 +1,609 @@
+/**
+ * @file ScenePicker.cpp
+ * @brief CPU ray picking implementation (binned SAH BVH)
+ */
+
+#include "ScenePicker.hpp"
+
+#include <scene/Scene.hpp>
+#include <scene/Mesh.hpp>
+
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDebug>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// BVH build parameters
+constexpr int kSahBins = 16;
+constexpr uint32_t kMaxLeafSize = 4;
+// Traversal stack entries kept on the stack; deeper (degenerate) trees spill to the heap
+constexpr size_t kInlineTraversalDepth = 128;
+
+struct Aabb {
+    glm::vec3 min{kInfinity};
+    glm::vec3 max{-kInfinity};
+
+    void grow(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void grow(const Aabb& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    [[nodiscard]] bool isEmpty() const { return min.x > max.x; }
+    [[nodiscard]] glm::vec3 center() const { return (min + max) * 0.5f; }
+    [[nodiscard]] float area() const {
+        if (isEmpty()) {
+            return 0.0f;
+        }
+        glm::vec3 e = max - min;
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+};
+
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 invDirection;
+
+    Ray(const glm::vec3& o, const glm::vec3& d)
+        : origin(o), direction(d), invDirection(1.0f / d) {}
+};
+
+// Slab test; returns entry distance or +inf on miss
+float intersectAabb(const Ray& ray, const Aabb& box, float tMax) {
+    glm::vec3 t0 = (box.min - ray.origin) * ray.invDirection;
+    glm::vec3 t1 = (box.max - ray.origin) * ray.invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+    return enter <= exit ? enter : kInfinity;
+}
+
+// Möller–Trumbore, two-sided
+bool intersectTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1,
+                       const glm::vec3& v2, float& tHit) {
+    const glm::vec3 e1 = v1 - v0;
+    const glm::vec3 e2 = v2 - v0;
+    const glm::vec3 p = glm::cross(ray.direction, e2);
+    const float det = glm::dot(e1, p);
+    if (std::abs(det) < 1e-12f) {
+        return false;
+    }
+    const float invDet = 1.0f / det;
+    const glm::vec3 s = ray.origin - v0;
+    const float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const glm::vec3 q = glm::cross(s, e1);
+    const float v = glm::dot(ray.direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    const float t = glm::dot(e2, q) * invDet;
+    if (t <= 0.0f || t >= tHit) {
+        return false;
+    }
+    tHit = t;
+    return true;
+}
+
+struct MeshGeometry {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;  // Empty: non-indexed triangle list
+};
+
+Aabb transformBounds(const Aabb& box, const glm::mat4& m) {
+    Aabb result;
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? box.max.x : box.min.x,
+                         (i & 2) ? box.max.y : box.min.y,
+                         (i & 4) ? box.max.z : box.min.z);
+        result.grow(glm::vec3(m * glm::vec4(corner, 1.0f)));
+    }
+    return result;
+}
+
+} // namespace
+
+// ============================================================================
+// BVH
+// ============================================================================
+
+struct ScenePicker::Bvh {
+    struct Node {
+        Aabb bounds;
+        uint32_t leftFirst = 0;  // Leaf: first primitive; inner: left child (right = left + 1)
+        uint32_t count = 0;      // > 0: leaf
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> primitives;  // Primitive indices in leaf order
+
+    /**
+     * @brief Binned SAH build over primitive bounds
+     *
+     * Children are always appended after their parent, so a reverse sweep
+     * over nodes visits children first (used by refit()).
+     */
+    void build(const std::vector<Aabb>& primBounds) {
+        const auto count = static_cast<uint32_t>(primBounds.size());
+        nodes.clear();
+        primitives.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            primitives[i] = i;
+        }
+        if (count == 0) {
+            return;
+        }
+
+        std::vector<glm::vec3> centroids(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            centroids[i] = primBounds[i].center();
+        }
+
+        nodes.reserve(2 * static_cast<size_t>(count));
+        nodes.push_back({{}, 0, count});
+        std::vector<uint32_t> stack{0};
+
+        while (!stack.empty()) {
+            const uint32_t nodeIndex = stack.back();
+            stack.pop_back();
+
+            Node& node = nodes[nodeIndex];
+            Aabb centroidBounds;
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+                node.bounds.grow(primBounds[primitives[i]]);
+                centroidBounds.grow(centroids[primitives[i]]);
+            }
+            if (node.count <= kMaxLeafSize) {
+                continue;
+            }
+
+            // Pick the cheapest bin boundary over all three axes
+            int bestAxis = -1;
+            int bestSplit = 0;
+            float bestCost = node.count * node.bounds.area();
+            const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+
+            for (int axis = 0; axis < 3; ++axis) {
+                if (extent[axis] <= 0.0f) {
+                    continue;
+                }
+                std::array<Aabb, kSahBins> binBounds{};
+                std::array<uint32_t, kSahBins> binCounts{};
+                const float scale = kSahBins / extent[axis];
+                for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+                    const uint32_t prim = primitives[i];
+                    int bin = static_cast<int>((centroids[prim][axis] - centroidBounds.min[axis]) * scale);
+                    bin = std::clamp(bin, 0, kSahBins - 1);
+                    binBounds[bin].grow(primBounds[prim]);
+                    ++binCounts[bin];
+                }
+
+                std::array<float, kSahBins - 1> leftCost{};
+                Aabb leftBox;
+                uint32_t leftCount = 0;
+                for (int b = 0; b < kSahBins - 1; ++b) {
+                    leftBox.grow(binBounds[b]);
+                    leftCount += binCounts[b];
+                    leftCost[b] = leftCount * leftBox.area();
+                }
+                Aabb rightBox;
+                uint32_t rightCount = 0;
+                for (int b = kSahBins - 1; b > 0; --b) {
+                    rightBox.grow(binBounds[b]);
+                    rightCount += binCounts[b];
+                    const float cost = leftCost[b - 1] + rightCount * rightBox.area();
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = b;
+                    }
+                }
+            }
+
+            if (bestAxis < 0) {
+                continue;  // Splitting does not pay off (or all centroids coincide)
+            }
+
+            const float scale = kSahBins / extent[bestAxis];
+            const float axisMin = centroidBounds.min[bestAxis];
+            auto* first = primitives.data() + node.leftFirst;
+            auto* middle = std::partition(first, first + node.count, [&](uint32_t prim) {
+                int bin = static_cast<int>((centroids[prim][bestAxis] - axisMin) * scale);
+                return std::clamp(bin, 0, kSahBins - 1) < bestSplit;
+            });
+            const auto leftCount = static_cast<uint32_t>(middle - first);
+            if (leftCount == 0 || leftCount == node.count) {
+                continue;
+            }
+
+            const auto leftChild = static_cast<uint32_t>(nodes.size());
+            const uint32_t firstPrim = node.leftFirst;
+            const uint32_t primCount = node.count;
+            node.leftFirst = leftChild;
+            node.count = 0;
+            // node is invalidated by the push_backs below
+            nodes.push_back({{}, firstPrim, leftCount});
+            nodes.push_back({{}, firstPrim + leftCount, primCount - leftCount});
+            stack.push_back(leftChild);
+            stack.push_back(leftChild + 1);
+        }
+    }
+
+    /**
+     * @brief Recompute node bounds after primitives moved (topology unchanged)
+     */
+    void refit(const std::vector<Aabb>& primBounds) {
+        for (size_t i = nodes.size(); i-- > 0;) {
+            Node& node = nodes[i];
+            node.bounds = Aabb{};
+            if (node.count > 0) {
+                for (uint32_t p = node.leftFirst; p < node.leftFirst + node.count; ++p) {
+                    node.bounds.grow(primBounds[primitives[p]]);
+                }
+            } else {
+                node.bounds.grow(nodes[node.leftFirst].bounds);
+                node.bounds.grow(nodes[node.leftFirst + 1].bounds);
+            }
+        }
+    }
+
+    /**
+     * @brief Closest-hit traversal, near child first
+     * @param intersect bool(uint32_t primitive, float& tHit) narrowing tHit on hit
+     */
+    template <typename IntersectFn>
+    void traverse(const Ray& ray, float& tHit, IntersectFn&& intersect) const {
+        if (nodes.empty() || intersectAabb(ray, nodes[0].bounds, tHit) == kInfinity) {
+            return;
+        }
+
+        std::array<uint32_t, kInlineTraversalDepth> stack{};
+        std::vector<uint32_t> overflow;
+        size_t stackSize = 0;
+        uint32_t current = 0;
+
+        while (true) {
+            const Node& node = nodes[current];
+            if (node.count > 0) {
+                for (uint32_t p = node.leftFirst; p < node.leftFirst + node.count; ++p) {
+                    intersect(primitives[p], tHit);
+                }
+            } else {
+                uint32_t nearChild = node.leftFirst;
+                uint32_t farChild = node.leftFirst + 1;
+                float tNear = intersectAabb(ray, nodes[nearChild].bounds, tHit);
+                float tFar = intersectAabb(ray, nodes[farChild].bounds, tHit);
+                if (tFar < tNear) {
+                    std::swap(nearChild, farChild);
+                    std::swap(tNear, tFar);
+                }
+                if (tNear != kInfinity) {
+                    if (tFar != kInfinity) {
+                        if (stackSize < stack.size()) {
+                            stack[stackSize++] = farChild;
+                        } else {
+                            overflow.push_back(farChild);
+                        }
+                    }
+                    current = nearChild;
+                    continue;
+                }
+            }
+
+            // Pop, skipping nodes already farther than the closest hit
+            bool found = false;
+            while (!overflow.empty() || stackSize > 0) {
+                uint32_t candidate;
+                if (!overflow.empty()) {
+                    candidate = overflow.back();
+                    overflow.pop_back();
+                } else {
+                    candidate = stack[--stackSize];
+                }
+                if (intersectAabb(ray, nodes[candidate].bounds, tHit) != kInfinity) {
+                    current = candidate;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                return;
+            }
+        }
+    }
+};
+
+// ============================================================================
+// Bottom Level (per mesh)
+// ============================================================================
+
+struct ScenePicker::MeshBlas {
+    std::vector<glm::vec3> vertices;  // 3 per triangle, in BVH leaf order
+    Bvh bvh;
+
+    /**
+     * @brief Build over a mesh's triangles, then store them in leaf order
+     *        so traversal reads vertices sequentially
+     */
+    void build(const MeshGeometry& geometry, std::vector<Aabb>& scratchBounds) {
+        const bool indexed = !geometry.indices.empty();
+        const size_t triangleCount = (indexed ? geometry.indices.size() : geometry.positions.size()) / 3;
+
+        auto vertex = [&](size_t tri, int corner) -> const glm::vec3& {
+            const size_t i = tri * 3 + static_cast<size_t>(corner);
+            return geometry.positions[indexed ? geometry.indices[i] : i];
+        };
+
+        scratchBounds.resize(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            Aabb box;
+            box.grow(vertex(t, 0));
+            box.grow(vertex(t, 1));
+            box.grow(vertex(t, 2));
+            scratchBounds[t] = box;
+        }
+        bvh.build(scratchBounds);
+
+        vertices.resize(triangleCount * 3);
+        for (size_t i = 0; i < triangleCount; ++i) {
+            const uint32_t tri = bvh.primitives[i];
+            vertices[i * 3 + 0] = vertex(tri, 0);
+            vertices[i * 3 + 1] = vertex(tri, 1);
+            vertices[i * 3 + 2] = vertex(tri, 2);
+            bvh.primitives[i] = static_cast<uint32_t>(i);
+        }
+    }
+
+    [[nodiscard]] Aabb bounds() const {
+        return bvh.nodes.empty() ? Aabb{} : bvh.nodes[0].bounds;
+    }
+};
+
+struct ScenePicker::BlasSet {
+    std::vector<MeshBlas> meshes;
+    qint64 triangleCount = 0;
+    double buildMs = 0.0;
+};
+
+struct ScenePicker::Instance {
+    int nodeIndex = -1;
+    int meshIndex = -1;
+    glm::mat4 worldToObject{1.0f};
+    Aabb worldBounds;
+};
+
+// ============================================================================
+// ScenePicker
+// ============================================================================
+
+ScenePicker::ScenePicker(QObject* parent)
+    : QObject(parent)
+{
+}
+
+ScenePicker::~ScenePicker() {
+    cancelBuild();
+}
+
+void ScenePicker::rebuild(const quantiloom::Scene* scene) {
+    cancelBuild();
+    clear();
+    if (!scene) {
+        return;
+    }
+
+    // Snapshot positions/indices; the worker never touches the live scene
+    auto geometry = std::make_shared<std::vector<MeshGeometry>>(scene->meshes.size());
+    for (size_t m = 0; m < scene->meshes.size(); ++m) {
+        const auto& mesh = scene->meshes[m];
+        auto& target = (*geometry)[m];
+        target.positions.reserve(mesh.vertices.size());
+        for (const auto& v : mesh.vertices) {
+            target.positions.push_back(v.position);
+        }
+        target.indices.assign(mesh.indices.begin(), mesh.indices.end());
+    }
+
+    m_nodeMeshes.resize(scene->nodes.size());
+    m_nodeTransforms.resize(scene->nodes.size());
+    for (size_t n = 0; n < scene->nodes.size(); ++n) {
+        const auto& node = scene->nodes[n];
+        m_nodeMeshes[n] = node.meshIndex < scene->meshes.size() ? static_cast<int>(node.meshIndex) : -1;
+        m_nodeTransforms[n] = node.transform;
+    }
+
+    auto cancel = std::make_shared<std::atomic_bool>(false);
+    m_buildCancel = cancel;
+    m_buildWatcher = std::make_unique<QFutureWatcher<std::shared_ptr<const BlasSet>>>();
+    connect(m_buildWatcher.get(), &QFutureWatcherBase::finished, this, &ScenePicker::onBuildFinished);
+    m_buildWatcher->setFuture(QtConcurrent::run([geometry, cancel]() -> std::shared_ptr<const BlasSet> {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto set = std::make_shared<BlasSet>();
+        set->meshes.resize(geometry->size());
+        std::vector<Aabb> scratch;
+        for (size_t m = 0; m < geometry->size(); ++m) {
+            if (cancel->load()) {
+                return nullptr;
+            }
+            auto& blas = set->meshes[m];
+            blas.build((*geometry)[m], scratch);
+            set->triangleCount += static_cast<qint64>(blas.vertices.size() / 3);
+        }
+        set->buildMs = timer.nsecsElapsed() / 1e6;
+        return set;
+    }));
+}
+
+void ScenePicker::cancelBuild() {
+    if (!m_buildWatcher) {
+        return;
+    }
+    m_buildCancel->store(true);
+    m_buildWatcher->disconnect(this);
+    m_buildWatcher->waitForFinished();
+    m_buildWatcher.reset();
+    m_buildCancel.reset();
+}
+
+void ScenePicker::clear() {
+    m_blas.reset();
+    m_nodeMeshes.clear();
+    m_nodeTransforms.clear();
+    m_instances.clear();
+    m_instanceOfNode.clear();
+    m_tlas.reset();
+    m_tlasDirty = false;
+}
+
+void ScenePicker::onBuildFinished() {
+    auto result = m_buildWatcher->result();
+
+    // Still inside the watcher's signal; delete it later
+    m_buildWatcher.release()->deleteLater();
+    m_buildCancel.reset();
+
+    if (!result) {
+        return;
+    }
+    m_blas = std::move(result);
+    buildTlas();
+
+    qDebug() << "ScenePicker: BVH ready -" << m_instances.size() << "instances,"
+             << m_blas->triangleCount << "triangles, BLAS build"
+             << m_blas->buildMs << "ms";
+    emit ready(static_cast<int>(m_instances.size()), m_blas->triangleCount, m_blas->buildMs);
+}
+
+void ScenePicker::updateInstanceBounds(Instance& instance) const {
+    const glm::mat4& objectToWorld = m_nodeTransforms[static_cast<size_t>(instance.nodeIndex)];
+    instance.worldToObject = glm::inverse(objectToWorld);
+    instance.worldBounds = transformBounds(
+        m_blas->meshes[static_cast<size_t>(instance.meshIndex)].bounds(), objectToWorld);
+}
+
+void ScenePicker::buildTlas() {
+    m_instances.clear();
+    m_instanceOfNode.assign(m_nodeMeshes.size(), -1);
+
+    for (size_t n = 0; n < m_nodeMeshes.size(); ++n) {
+        const int mesh = m_nodeMeshes[n];
+        if (mesh < 0 || m_blas->meshes[static_cast<size_t>(mesh)].bvh.nodes.empty()) {
+            continue;
+        }
+        Instance instance;
+        instance.nodeIndex = static_cast<int>(n);
+        instance.meshIndex = mesh;
+        updateInstanceBounds(instance);
+        m_instanceOfNode[n] = static_cast<int>(m_instances.size());
+        m_instances.push_back(instance);
+    }
+
+    std::vector<Aabb> bounds(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        bounds[i] = m_instances[i].worldBounds;
+    }
+    m_tlas = std::make_unique<Bvh>();
+    m_tlas->build(bounds);
+    m_tlasDirty = false;
+}
+
+void ScenePicker::refitTlas() {
+    std::vector<Aabb> bounds(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        bounds[i] = m_instances[i].worldBounds;
+    }
+    m_tlas->refit(bounds);
+    m_tlasDirty = false;
+}
+
+void ScenePicker::updateNodeTransform(int nodeIndex, const glm::mat4& transform) {
+    if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= m_nodeTransforms.size()) {
+        return;
+    }
+    m_nodeTransforms[static_cast<size_t>(nodeIndex)] = transform;
+
+    // Before the build finishes the TLAS is created from m_nodeTransforms
+    if (!m_tlas) {
+        return;
+    }
+    const int instance = m_instanceOfNode[static_cast<size_t>(nodeIndex)];
+    if (instance >= 0) {
+        updateInstanceBounds(m_instances[static_cast<size_t>(instance)]);
+        m_tlasDirty = true;
+    }
+}
+
+PickHit ScenePicker::pick(const glm::vec3& origin, const glm::vec3& direction) {
+    PickHit hit;
+    if (!m_tlas || glm::dot(direction, direction) <= 0.0f) {
+        return hit;
+    }
+    if (m_tlasDirty) {
+        refitTlas();
+    }
+
+    const glm::vec3 dir = glm::normalize(direction);
+    const Ray worldRay(origin, dir);
+    float tHit = kInfinity;
+
+    m_tlas->traverse(worldRay, tHit, [&](uint32_t instanceIndex, float& tClosest) {
+        const Instance& instance = m_instances[instanceIndex];
+        const MeshBlas& blas = m_blas->meshes[static_cast<size_t>(instance.meshIndex)];
+
+        // Object-space ray; direction is not renormalized so t stays in world units
+        const Ray objectRay(glm::vec3(instance.worldToObject * glm::vec4(origin, 1.0f)),
+                            glm::vec3(instance.worldToObject * glm::vec4(dir, 0.0f)));
+        bool instanceHit = false;
+        blas.bvh.traverse(objectRay, tClosest, [&](uint32_t tri, float& t) {
+            const glm::vec3* v = &blas.vertices[static_cast<size_t>(tri) * 3];
+            if (intersectTriangle(objectRay, v[0], v[1], v[2], t)) {
+                instanceHit = true;
+            }
+        });
+        if (instanceHit) {
+            hit.nodeIndex = instance.nodeIndex;
+        }
+    });
+
+    if (hit.isValid()) {
+        hit.distance = tHit;
+        hit.position = origin + dir * tHit;
+    }
+    return hit;
+}
+
+PickHit ScenePicker::pickFromCamera(const QPointF& viewportPos, const QSizeF& viewportSize,
+                                    const glm::vec3& cameraPos, const glm::vec3& forward,
+                                    const glm::vec3& right, const glm::vec3& up, float fovY) {
+    if (viewportSize.width() <= 0.0 || viewportSize.height() <= 0.0) {
+        return {};
+    }
+
+    // Pinhole camera matching the renderer (vertical FOV, square pixels)
+    const float aspect = static_cast<float>(viewportSize.width() / viewportSize.height());
+    const float tanHalfFov = std::tan(glm::radians(fovY) * 0.5f);
+    const float ndcX = static_cast<float>(2.0 * viewportPos.x() / viewportSize.width() - 1.0);
+    const float ndcY = static_cast<float>(1.0 - 2.0 * viewportPos.y() / viewportSize.height());
+
+    const glm::vec3 direction = forward
+        + right * (ndcX * tanHalfFov * aspect)
+        + up * (ndcY * tanHalfFov);
+    return pick(cameraPos, direction);
+}
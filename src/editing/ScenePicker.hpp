@@ -0,0 +1,124 @@
+/**
+ * @file ScenePicker.hpp
+ * @brief CPU ray picking for viewport selection
+ *
+ * Two-level BVH: one BLAS per mesh over its triangles (built on a worker
+ * thread when a scene loads) and a TLAS over scene nodes. Node transform
+ * edits only refit the TLAS; triangle data is never touched again.
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QPointF>
+#include <QSizeF>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace quantiloom {
+class Scene;
+}
+
+/**
+ * @struct PickHit
+ * @brief Closest intersection of a pick ray
+ */
+struct PickHit {
+    int nodeIndex = -1;       // -1: nothing hit
+    float distance = 0.0f;    // Along the normalized ray direction
+    glm::vec3 position{0.0f};
+
+    [[nodiscard]] bool isValid() const { return nodeIndex >= 0; }
+};
+
+/**
+ * @class ScenePicker
+ * @brief Finds the scene node under a viewport position
+ *
+ * Usage:
+ * - rebuild(scene) after a scene load (returns immediately, BLAS build runs
+ *   in the background; ready() is emitted when picking becomes available)
+ * - updateNodeTransform() whenever a node moves (TLAS refit on next pick)
+ * - pick() / pickFromCamera() on click
+ */
+class ScenePicker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ScenePicker(QObject* parent = nullptr);
+    ~ScenePicker() override;
+
+    /**
+     * @brief Snapshot scene geometry and build acceleration structures
+     *
+     * Vertex data is copied, so the scene may be replaced while the
+     * worker runs. A newer rebuild() supersedes a running one.
+     */
+    void rebuild(const quantiloom::Scene* scene);
+
+    /**
+     * @brief Drop all picking data (no scene)
+     */
+    void clear();
+
+    /**
+     * @brief Record a node transform change (refits the TLAS lazily)
+     */
+    void updateNodeTransform(int nodeIndex, const glm::mat4& transform);
+
+    [[nodiscard]] bool isReady() const { return m_tlas != nullptr; }
+    [[nodiscard]] bool isBuilding() const { return m_buildWatcher != nullptr; }
+
+    /**
+     * @brief Cast a world-space ray and return the closest hit node
+     */
+    PickHit pick(const glm::vec3& origin, const glm::vec3& direction);
+
+    /**
+     * @brief Cast the camera ray through a viewport position
+     * @param viewportPos Position in viewport coordinates (origin top-left)
+     * @param viewportSize Viewport size in the same units
+     * @param fovY Vertical field of view in degrees
+     */
+    PickHit pickFromCamera(const QPointF& viewportPos, const QSizeF& viewportSize,
+                           const glm::vec3& cameraPos, const glm::vec3& forward,
+                           const glm::vec3& right, const glm::vec3& up, float fovY);
+
+signals:
+    /**
+     * @brief Emitted when a build finishes and picking is available
+     */
+    void ready(int instanceCount, qint64 triangleCount, double buildMs);
+
+private:
+    struct Bvh;
+    struct MeshBlas;
+    struct BlasSet;
+    struct Instance;
+
+    void onBuildFinished();
+    void cancelBuild();
+    void buildTlas();
+    void refitTlas();
+    void updateInstanceBounds(Instance& instance) const;
+
+    // Bottom level (immutable after build, shared with the worker)
+    std::shared_ptr<const BlasSet> m_blas;
+
+    // Top level (GUI thread)
+    std::vector<int> m_nodeMeshes;            // Node -> mesh index (-1: no geometry)
+    std::vector<glm::mat4> m_nodeTransforms;  // Latest transform per node
+    std::vector<Instance> m_instances;
+    std::vector<int> m_instanceOfNode;        // Node -> instance index (-1: none)
+    std::unique_ptr<Bvh> m_tlas;
+    bool m_tlasDirty = false;
+
+    // Background build
+    std::unique_ptr<QFutureWatcher<std::shared_ptr<const BlasSet>>> m_buildWatcher;
+    std::shared_ptr<std::atomic_bool> m_buildCancel;
+};
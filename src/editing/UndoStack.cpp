@@ -5,6 +5,7 @@
 
 #include "UndoStack.hpp"
 #include <QCoreApplication>
+#include <algorithm>
 
 UndoStack::UndoStack(QObject* parent)
     : QObject(parent)
@@ -20,8 +21,8 @@ void UndoStack::push(std::unique_ptr<Command> command) {
     command->execute();
 
     // If we're not at the end, remove all commands after current position
-    if (m_undoIndex < static_cast<int>(m_commands.size())) {
-        m_commands.erase(m_commands.begin() + m_undoIndex, m_commands.end());
+    if (m_undoIndex < m_count) {
+        dropRedo();
         // Clean index becomes invalid if we're past it
         if (m_cleanIndex > m_undoIndex) {
             m_cleanIndex = -1;  // Clean state is unreachable
@@ -29,32 +30,30 @@ void UndoStack::push(std::unique_ptr<Command> command) {
     }
 
     // Try to merge with previous command
-    if (!m_commands.empty() && m_undoIndex > 0) {
-        Command* lastCmd = m_commands.back().get();
-        if (lastCmd->id() != -1 && lastCmd->id() == command->id()) {
-            if (lastCmd->mergeWith(command.get())) {
-                // Command was merged, don't add new one
-                emitStateChanged();
-                return;
+    if (mergeIntoLast(command.get())) {
+        if (entry(m_count - 1).command->isObsolete()) {
+            // The edits cancelled out: no history entry, and later pushes
+            // must not merge into the command before it
+            --m_undoIndex;
+            dropRedo();
+            if (m_cleanIndex > m_count) {
+                m_cleanIndex = -1;
             }
+            m_mergeTimer.invalidate();
+        } else {
+            m_mergeTimer.start();
         }
+        enforceLimits();
+        emitStateChanged();
+        return;
     }
 
     // Add new command
-    m_commands.push_back(std::move(command));
-    m_undoIndex = static_cast<int>(m_commands.size());
-
-    // Enforce undo limit
-    while (static_cast<int>(m_commands.size()) > m_undoLimit && m_undoLimit > 0) {
-        m_commands.erase(m_commands.begin());
-        m_undoIndex--;
-        if (m_cleanIndex > 0) {
-            m_cleanIndex--;
-        } else if (m_cleanIndex == 0) {
-            m_cleanIndex = -1;  // Clean state removed
-        }
-    }
+    append(std::move(command));
+    m_undoIndex = m_count;
+    m_mergeTimer.start();
 
+    enforceLimits();
     emitStateChanged();
 }
 
@@ -64,8 +63,10 @@ void UndoStack::undo() {
     }
 
     m_undoIndex--;
-    m_commands[static_cast<size_t>(m_undoIndex)]->undo();
+    entry(m_undoIndex).command->undo();
+    m_mergeTimer.invalidate();
     emitStateChanged();
+    emit historyNavigated(m_undoIndex);
 }
 
 void UndoStack::redo() {
@@ -73,9 +74,11 @@ void UndoStack::redo() {
         return;
     }
 
-    m_commands[static_cast<size_t>(m_undoIndex)]->execute();
+    entry(m_undoIndex).command->execute();
     m_undoIndex++;
+    m_mergeTimer.invalidate();
     emitStateChanged();
+    emit historyNavigated(m_undoIndex);
 }
 
 QString UndoStack::undoText() const {
@@ -83,7 +86,7 @@ QString UndoStack::undoText() const {
         return QCoreApplication::translate("UndoStack", "Undo");
     }
     return QCoreApplication::translate("UndoStack", "Undo %1")
-        .arg(m_commands[static_cast<size_t>(m_undoIndex - 1)]->description());
+        .arg(entry(m_undoIndex - 1).command->description());
 }
 
 QString UndoStack::redoText() const {
@@ -91,10 +94,11 @@ QString UndoStack::redoText() const {
         return QCoreApplication::translate("UndoStack", "Redo");
     }
     return QCoreApplication::translate("UndoStack", "Redo %1")
-        .arg(m_commands[static_cast<size_t>(m_undoIndex)]->description());
+        .arg(entry(m_undoIndex).command->description());
 }
 
 void UndoStack::setClean() {
+    m_mergeTimer.invalidate();  // Edits after a save start a new entry
     if (m_cleanIndex != m_undoIndex) {
         m_cleanIndex = m_undoIndex;
         emit cleanChanged(true);
@@ -102,11 +106,15 @@ void UndoStack::setClean() {
 }
 
 void UndoStack::clear() {
-    if (m_commands.empty()) {
+    if (m_count == 0) {
         return;
     }
 
-    m_commands.clear();
+    m_ring.clear();
+    m_mergeTimer.invalidate();
+    m_head = 0;
+    m_count = 0;
+    m_totalBytes = 0;
     m_undoIndex = 0;
     m_cleanIndex = 0;
     emitStateChanged();
@@ -114,20 +122,106 @@ void UndoStack::clear() {
 
 void UndoStack::setUndoLimit(int limit) {
     m_undoLimit = limit;
+    enforceLimits();
+    emitStateChanged();
+}
 
-    // Enforce new limit
-    while (static_cast<int>(m_commands.size()) > m_undoLimit && m_undoLimit > 0) {
-        m_commands.erase(m_commands.begin());
-        m_undoIndex = std::max(0, m_undoIndex - 1);
-        m_cleanIndex = std::max(-1, m_cleanIndex - 1);
-    }
+void UndoStack::setByteBudget(size_t bytes) {
+    m_byteBudget = bytes;
+    enforceLimits();
+    emitStateChanged();
+}
+
+void UndoStack::beginGesture() {
+    m_inGesture = true;
+    m_mergeTimer.invalidate();
+}
+
+void UndoStack::endGesture() {
+    m_inGesture = false;
+    m_mergeTimer.invalidate();
 }
 
 const Command* UndoStack::command(int index) const {
-    if (index < 0 || index >= static_cast<int>(m_commands.size())) {
+    if (index < 0 || index >= m_count) {
         return nullptr;
     }
-    return m_commands[static_cast<size_t>(index)].get();
+    return entry(index).command.get();
+}
+
+void UndoStack::append(std::unique_ptr<Command> command) {
+    if (static_cast<size_t>(m_count) == m_ring.size()) {
+        // Full: double the capacity, unrolling the ring oldest first
+        std::vector<Entry> grown(std::max(kMinCapacity, m_ring.size() * 2));
+        for (int i = 0; i < m_count; ++i) {
+            grown[static_cast<size_t>(i)] = std::move(entry(i));
+        }
+        m_ring = std::move(grown);
+        m_head = 0;
+    }
+
+    Entry& slot = entry(m_count);
+    slot.bytes = command->memoryFootprint();
+    slot.command = std::move(command);
+    m_totalBytes += slot.bytes;
+    m_count++;
+}
+
+bool UndoStack::mergeIntoLast(Command* command) {
+    // Only into the command just pushed, and only while the edit is ongoing
+    if (m_count == 0 || m_undoIndex != m_count || !m_mergeTimer.isValid()) {
+        return false;
+    }
+    if (!m_inGesture && m_mergeWindowMs > 0 && m_mergeTimer.elapsed() > m_mergeWindowMs) {
+        return false;
+    }
+
+    Entry& last = entry(m_count - 1);
+    Command* lastCmd = last.command.get();
+    if (lastCmd->id() == -1 || lastCmd->id() != command->id() || !lastCmd->mergeWith(command)) {
+        return false;
+    }
+
+    // Command was merged, don't add new one (its footprint may have changed)
+    m_totalBytes -= last.bytes;
+    last.bytes = lastCmd->memoryFootprint();
+    m_totalBytes += last.bytes;
+    return true;
+}
+
+void UndoStack::dropRedo() {
+    while (m_count > m_undoIndex) {
+        Entry& last = entry(m_count - 1);
+        m_totalBytes -= last.bytes;
+        last = Entry{};
+        m_count--;
+    }
+}
+
+void UndoStack::dropOldest() {
+    Entry& oldest = entry(0);
+    m_totalBytes -= oldest.bytes;
+    oldest = Entry{};
+    m_head = (m_head + 1) & (m_ring.size() - 1);
+    m_count--;
+
+    m_undoIndex--;
+    if (m_cleanIndex > 0) {
+        m_cleanIndex--;
+    } else if (m_cleanIndex == 0) {
+        m_cleanIndex = -1;  // Clean state removed
+    }
+}
+
+void UndoStack::enforceLimits() {
+    // Only undo history is evicted, and never the most recent undoable command
+    const auto overLimit = [this]() {
+        return (m_undoLimit > 0 && m_count > m_undoLimit) ||
+               (m_byteBudget > 0 && m_totalBytes > m_byteBudget);
+    };
+    while (m_undoIndex > 1 && overLimit()) {
+        dropOldest();
+    }
 }
 
 void UndoStack::emitStateChanged() {
@@ -11,8 +11,10 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -26,6 +28,8 @@ class UndoStack;
  * - execute(): Apply the command
  * - undo(): Reverse the command
  * - mergeWith(): Optionally merge with previous command (for drag operations)
+ * - isObsolete(): A merge cancelled the command out; the stack discards it
+ * - memoryFootprint(): Bytes held for undo/redo (counted against the stack's budget)
  */
 class Command {
 public:
@@ -42,13 +46,23 @@ public:
     // Used for merging consecutive similar operations (e.g., drag transform)
     virtual bool mergeWith(const Command* /*other*/) { return false; }
 
+    // True once merging has left nothing to undo (e.g. a drag back to the start)
+    [[nodiscard]] virtual bool isObsolete() const { return false; }
+
     // Command description for UI
     [[nodiscard]] const QString& description() const { return m_description; }
 
     // Command ID for merging (commands with same ID can potentially merge)
     [[nodiscard]] virtual int id() const { return -1; }
 
+    // Approximate object + heap size held for undo/redo
+    [[nodiscard]] virtual size_t memoryFootprint() const { return sizeof(Command) + descriptionBytes(); }
+
 protected:
+    [[nodiscard]] size_t descriptionBytes() const {
+        return static_cast<size_t>(m_description.capacity()) * sizeof(QChar);
+    }
+
     QString m_description;
 };
 
@@ -57,9 +71,16 @@ protected:
  * @brief Manages command history for undo/redo operations
  *
  * Features:
- * - Unlimited undo depth (configurable)
- * - Command merging for smooth drag operations
+ * - History bounded by a byte budget and a command count
+ * - Command merging for smooth drag operations: consecutive mergeable
+ *   commands merge while they arrive within the merge window of each
+ *   other, or at any pace inside a gesture (e.g. a slider drag)
  * - Clean state tracking for save prompts
+ *
+ * History is a ring buffer (oldest first), so dropping the oldest command
+ * when a limit is reached is O(1) however long the session has been.
+ * The most recent undoable command is always kept, even if it alone
+ * exceeds the budget.
  */
 class UndoStack : public QObject {
     Q_OBJECT
@@ -76,7 +97,7 @@ public:
 
     // State queries
     [[nodiscard]] bool canUndo() const { return m_undoIndex > 0; }
-    [[nodiscard]] bool canRedo() const { return m_undoIndex < static_cast<int>(m_commands.size()); }
+    [[nodiscard]] bool canRedo() const { return m_undoIndex < m_count; }
     [[nodiscard]] bool isClean() const { return m_undoIndex == m_cleanIndex; }
 
     // Get descriptions for UI
@@ -89,12 +110,26 @@ public:
     // Clear all history
     void clear();
 
-    // Configuration
+    // Configuration (0: no limit)
     void setUndoLimit(int limit);
     [[nodiscard]] int undoLimit() const { return m_undoLimit; }
+    void setByteBudget(size_t bytes);
+    [[nodiscard]] size_t byteBudget() const { return m_byteBudget; }
+
+    // Merge window in ms (0: consecutive mergeable commands always merge)
+    void setMergeWindow(int ms) { m_mergeWindowMs = ms; }
+    [[nodiscard]] int mergeWindow() const { return m_mergeWindowMs; }
 
-    // History access
-    [[nodiscard]] int count() const { return static_cast<int>(m_commands.size()); }
+    // Gesture bracket: pushes in between merge regardless of timing, and
+    // the gesture starts and ends its own history entry
+    void beginGesture();
+    void endGesture();
+
+    // Bytes held by all commands (undo and redo)
+    [[nodiscard]] size_t memoryUsage() const { return m_totalBytes; }
+
+    // History access (0 = oldest)
+    [[nodiscard]] int count() const { return m_count; }
     [[nodiscard]] const Command* command(int index) const;
 
 signals:
@@ -108,11 +143,43 @@ signals:
     // Emitted when any command is pushed/undone/redone
     void indexChanged(int index);
 
+    // Emitted after undo() or redo() changed the document (not on push)
+    void historyNavigated(int index);
+
 private:
+    static constexpr size_t kDefaultByteBudget = 64 * 1024 * 1024;
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr int kDefaultMergeWindowMs = 1000;
+
+    struct Entry {
+        std::unique_ptr<Command> command;
+        size_t bytes = 0;      // Footprint when last measured (push or merge)
+    };
+
+    Entry& entry(int index) { return m_ring[(m_head + static_cast<size_t>(index)) & (m_ring.size() - 1)]; }
+    const Entry& entry(int index) const {
+        return m_ring[(m_head + static_cast<size_t>(index)) & (m_ring.size() - 1)];
+    }
+
+    void append(std::unique_ptr<Command> command);
+    void dropRedo();
+    void dropOldest();
+    bool mergeIntoLast(Command* command);
+    void enforceLimits();
     void emitStateChanged();
 
-    std::vector<std::unique_ptr<Command>> m_commands;
+    std::vector<Entry> m_ring;   // Power-of-two capacity
+    size_t m_head = 0;           // Slot of the oldest command
+    int m_count = 0;
+    size_t m_totalBytes = 0;
+
     int m_undoIndex = 0;       // Points to next command to undo
     int m_cleanIndex = 0;      // Index at last save
     int m_undoLimit = 100;     // Maximum number of commands to keep
+    size_t m_byteBudget = kDefaultByteBudget;
+
+    // Time since the last push; invalid when the next push must not merge
+    QElapsedTimer m_mergeTimer;
+    int m_mergeWindowMs = kDefaultMergeWindowMs;
+    bool m_inGesture = false;
 };
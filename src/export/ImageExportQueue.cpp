@@ -0,0 +1,178 @@
+/**
+ * @file ImageExportQueue.cpp
+ * @brief Background image export implementation
+ *
+ * @author wtflmao
+ */
+
+#include "ImageExportQueue.hpp"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+#include <core/Image.hpp>
+#include <io/ImageIO.hpp>
+
+namespace {
+
+bool writeTarget(const quantiloom::Image& image, const ImageExportTarget& target) {
+    QElapsedTimer timer;
+    timer.start();
+    const std::string path = target.path.toStdString();
+    const bool success = target.format == ImageExportFormat::PNG
+        ? quantiloom::ImageIO::WritePNG(path, image)
+        : quantiloom::ImageIO::WriteEXR(path, image);
+    qDebug() << "Export" << (success ? "wrote" : "FAILED") << target.path
+             << "in" << timer.elapsed() << "ms";
+    return success;
+}
+
+bool writeTarget(const QImage& image, const ImageExportTarget& target) {
+    QElapsedTimer timer;
+    timer.start();
+    const bool success = image.save(target.path, "PNG");
+    qDebug() << "Export" << (success ? "wrote" : "FAILED") << target.path
+             << "in" << timer.elapsed() << "ms";
+    return success;
+}
+
+} // namespace
+
+ImageExportQueue::ImageExportQueue(QObject* parent)
+    : QObject(parent)
+{
+    // EXR compression is the slow part; a few encoders are plenty and
+    // leave cores for the scene loader and picker builds
+    m_pool.setMaxThreadCount(std::clamp(QThread::idealThreadCount() / 2, 2, 4));
+}
+
+ImageExportQueue::~ImageExportQueue() {
+    if (!m_jobs.empty()) {
+        qDebug() << "Waiting for" << m_jobs.size() << "image export(s) to finish";
+    }
+    m_pool.waitForDone();
+}
+
+quint64 ImageExportQueue::enqueue(std::unique_ptr<quantiloom::Image> image,
+                                  const QList<ImageExportTarget>& targets,
+                                  const QString& label, QString* error) {
+    if (!image || targets.isEmpty()) {
+        if (error) *error = tr("Nothing to export");
+        return 0;
+    }
+
+    const qint64 bytes = estimateBytes(*image);
+    if (!admit(bytes, error)) {
+        return 0;
+    }
+
+    auto job = std::make_unique<Job>();
+    job->label = label;
+    job->image = std::shared_ptr<const quantiloom::Image>(std::move(image));
+    job->bytes = bytes;
+    return submit(std::move(job), targets);
+}
+
+quint64 ImageExportQueue::enqueue(const QImage& image, const QList<ImageExportTarget>& targets,
+                                  const QString& label, QString* error) {
+    if (image.isNull() || targets.isEmpty()) {
+        if (error) *error = tr("Nothing to export");
+        return 0;
+    }
+    for (const ImageExportTarget& target : targets) {
+        if (target.format != ImageExportFormat::PNG) {
+            if (error) *error = tr("EXR export needs an HDR capture: %1").arg(target.path);
+            return 0;
+        }
+    }
+
+    const qint64 bytes = image.sizeInBytes();
+    if (!admit(bytes, error)) {
+        return 0;
+    }
+
+    auto job = std::make_unique<Job>();
+    job->label = label;
+    job->displayImage = image;
+    job->bytes = bytes;
+    return submit(std::move(job), targets);
+}
+
+bool ImageExportQueue::admit(qint64 bytes, QString* error) const {
+    if (!m_jobs.empty() && m_inFlightBytes + bytes > m_maxInFlightBytes) {
+        if (error) {
+            *error = tr("Export queue is full (%1 image(s), %2 MiB still being written)")
+                .arg(m_jobs.size()).arg(m_inFlightBytes / (1024 * 1024));
+        }
+        return false;
+    }
+    return true;
+}
+
+quint64 ImageExportQueue::submit(std::unique_ptr<Job> job, const QList<ImageExportTarget>& targets) {
+    job->id = m_nextJobId++;
+    job->remaining = static_cast<int>(targets.size());
+
+    for (const ImageExportTarget& target : targets) {
+        auto watcher = std::make_unique<QFutureWatcher<bool>>();
+        connect(watcher.get(), &QFutureWatcherBase::finished, this,
+                [this, jobId = job->id, path = target.path, w = watcher.get()]() {
+                    onTargetFinished(jobId, path, w->result());
+                });
+        if (job->image) {
+            watcher->setFuture(QtConcurrent::run(&m_pool,
+                [image = job->image, target]() { return writeTarget(*image, target); }));
+        } else {
+            watcher->setFuture(QtConcurrent::run(&m_pool,
+                [image = job->displayImage, target]() { return writeTarget(image, target); }));
+        }
+        job->watchers.push_back(std::move(watcher));
+    }
+
+    const quint64 id = job->id;
+    m_inFlightBytes += job->bytes;
+    m_jobs.push_back(std::move(job));
+    emit queueChanged(pendingJobs(), m_inFlightBytes);
+    return id;
+}
+
+void ImageExportQueue::onTargetFinished(quint64 jobId, const QString& path, bool success) {
+    auto it = std::find_if(m_jobs.begin(), m_jobs.end(),
+                           [jobId](const auto& job) { return job->id == jobId; });
+    if (it == m_jobs.end()) {
+        return;
+    }
+
+    Job& job = **it;
+    (success ? job.written : job.failed).append(path);
+    if (--job.remaining > 0) {
+        return;
+    }
+
+    // Last target done: release the image before notifying
+    std::unique_ptr<Job> finished = std::move(*it);
+    m_jobs.erase(it);
+    m_inFlightBytes -= finished->bytes;
+    finished->image.reset();
+    finished->displayImage = QImage();
+
+    emit queueChanged(pendingJobs(), m_inFlightBytes);
+    emit exportFinished(finished->id, finished->label, finished->written, finished->failed);
+
+    // Watchers are still on the call stack (this runs from their signal)
+    for (auto& watcher : finished->watchers) {
+        watcher.release()->deleteLater();
+    }
+}
+
+ImageExportFormat ImageExportQueue::formatForPath(const QString& path) {
+    return path.endsWith(".png", Qt::CaseInsensitive) ? ImageExportFormat::PNG
+                                                      : ImageExportFormat::EXR;
+}
+
+qint64 ImageExportQueue::estimateBytes(const quantiloom::Image& image) {
+    return static_cast<qint64>(image.width) * image.height * 4 * sizeof(float);
+}
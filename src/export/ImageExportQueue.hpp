@@ -0,0 +1,136 @@
+/**
+ * @file ImageExportQueue.hpp
+ * @brief Background encoding of captured images (EXR / PNG)
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <memory>
+#include <vector>
+
+namespace quantiloom {
+struct Image;
+}
+
+/**
+ * @enum ImageExportFormat
+ * @brief Encoder used for one output file
+ */
+enum class ImageExportFormat {
+    EXR,    // HDR, physical values
+    PNG     // LDR preview
+};
+
+/**
+ * @struct ImageExportTarget
+ * @brief One file to write from a captured image
+ */
+struct ImageExportTarget {
+    QString path;
+    ImageExportFormat format = ImageExportFormat::EXR;
+};
+
+/**
+ * @class ImageExportQueue
+ * @brief Writes captured images on a worker pool instead of the GUI thread
+ *
+ * enqueue() takes ownership of the image; every target of a job is encoded
+ * in parallel from the same (read-only) image, which is freed once the last
+ * target is written. Captures still waiting to be written count against a
+ * memory budget: while the budget is exhausted further captures are
+ * refused rather than queued, so a held-down screenshot key cannot pile up
+ * gigabytes of float images. A job is always accepted when the queue is
+ * empty, even if it alone exceeds the budget.
+ */
+class ImageExportQueue : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ImageExportQueue(QObject* parent = nullptr);
+
+    /**
+     * @brief Waits for running encodes so no file is left half written
+     */
+    ~ImageExportQueue() override;
+
+    /**
+     * @brief Queue an image for writing
+     * @param image Captured image (ownership transferred)
+     * @param targets Files to write; encoded in parallel
+     * @param label Shown in notifications (e.g. "Screenshot")
+     * @param error Reason on failure (optional)
+     * @return Job id (> 0), or 0 if the image was refused
+     */
+    quint64 enqueue(std::unique_ptr<quantiloom::Image> image,
+                    const QList<ImageExportTarget>& targets,
+                    const QString& label, QString* error = nullptr);
+
+    /**
+     * @brief Queue an 8-bit display image (async viewport readback)
+     *
+     * Only PNG targets are accepted; EXR needs an HDR capture.
+     */
+    quint64 enqueue(const QImage& image, const QList<ImageExportTarget>& targets,
+                    const QString& label, QString* error = nullptr);
+
+    void setMaxInFlightBytes(qint64 bytes) { m_maxInFlightBytes = bytes; }
+    [[nodiscard]] qint64 maxInFlightBytes() const { return m_maxInFlightBytes; }
+    [[nodiscard]] qint64 inFlightBytes() const { return m_inFlightBytes; }
+    [[nodiscard]] int pendingJobs() const { return static_cast<int>(m_jobs.size()); }
+
+    /**
+     * @brief Pick the encoder from a file extension (EXR unless ".png")
+     */
+    static ImageExportFormat formatForPath(const QString& path);
+
+    /**
+     * @brief Approximate memory held by a captured image (RGBA float)
+     */
+    static qint64 estimateBytes(const quantiloom::Image& image);
+
+signals:
+    /**
+     * @brief All targets of a job are done
+     * @param written Paths written successfully
+     * @param failed Paths that could not be written
+     */
+    void exportFinished(quint64 jobId, const QString& label,
+                        const QStringList& written, const QStringList& failed);
+
+    /**
+     * @brief Number of jobs or in-flight memory changed
+     */
+    void queueChanged(int pendingJobs, qint64 inFlightBytes);
+
+private:
+    struct Job {
+        quint64 id = 0;
+        QString label;
+        std::shared_ptr<const quantiloom::Image> image;   // HDR capture, or
+        QImage displayImage;                               // 8-bit readback
+        qint64 bytes = 0;
+        int remaining = 0;
+        QStringList written;
+        QStringList failed;
+        std::vector<std::unique_ptr<QFutureWatcher<bool>>> watchers;
+    };
+
+    bool admit(qint64 bytes, QString* error) const;
+    quint64 submit(std::unique_ptr<Job> job, const QList<ImageExportTarget>& targets);
+    void onTargetFinished(quint64 jobId, const QString& path, bool success);
+
+    QThreadPool m_pool;
+    std::vector<std::unique_ptr<Job>> m_jobs;
+    quint64 m_nextJobId = 1;
+    qint64 m_inFlightBytes = 0;
+    qint64 m_maxInFlightBytes = 512ll * 1024 * 1024;
+};
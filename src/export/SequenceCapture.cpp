@@ -0,0 +1,234 @@
+/**
+ * @file SequenceCapture.cpp
+ * @brief Image sequence recording implementation
+ *
+ * @author wtflmao
+ */
+
+#include "SequenceCapture.hpp"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+
+#include <core/Image.hpp>
+
+SequenceCapture::SequenceCapture(ImageExportQueue* queue, QObject* parent)
+    : QObject(parent)
+    , m_queue(queue)
+{
+    if (m_queue) {
+        connect(m_queue, &ImageExportQueue::exportFinished,
+                this, &SequenceCapture::onExportFinished);
+    }
+}
+
+bool SequenceCapture::start(const SequenceCaptureSettings& settings, QString* error) {
+    if (!m_queue) {
+        if (error) *error = tr("No export queue");
+        return false;
+    }
+    if (settings.directory.isEmpty()) {
+        if (error) *error = tr("No output directory");
+        return false;
+    }
+    QDir dir(settings.directory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        if (error) *error = tr("Failed to create directory:\n%1").arg(settings.directory);
+        return false;
+    }
+
+    m_settings = settings;
+    m_settings.interval = std::max(1u, m_settings.interval);
+    m_stats = SequenceCaptureStats{};
+    m_active = true;
+    m_finishPending = true;
+
+    m_framesSeen = 0;
+    m_nextSampleMark = m_settings.interval;
+    m_lastSamples = 0;
+    m_postponed = false;
+    m_nextIndex = 0;
+    m_inFlight = 0;
+    m_jobEstimates.clear();
+
+    // Start with one second of burst
+    m_tokens = m_settings.maxMegabytesPerSecond * 1e6;
+    m_bucketTimer.start();
+
+    qDebug() << "Sequence capture started:" << m_settings.directory
+             << "- every" << m_settings.interval
+             << (m_settings.trigger == SequenceTrigger::Frames ? "frames" : "samples")
+             << "- cap" << m_settings.maxMegabytesPerSecond << "MB/s";
+
+    emit statsChanged(stats());
+    return true;
+}
+
+void SequenceCapture::stop() {
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    emit statsChanged(stats());
+    maybeFinish();
+}
+
+SequenceCaptureStats SequenceCapture::stats() const {
+    SequenceCaptureStats stats = m_stats;
+    stats.active = m_active;
+    return stats;
+}
+
+bool SequenceCapture::shouldCapture(uint32_t accumulatedSamples) {
+    if (!m_active) {
+        return false;
+    }
+
+    bool due = false;
+    if (m_settings.trigger == SequenceTrigger::Frames) {
+        due = (m_framesSeen++ % m_settings.interval) == 0;
+    } else {
+        if (accumulatedSamples < m_lastSamples) {
+            // Accumulation restarted: count from zero again
+            m_nextSampleMark = m_settings.interval;
+            m_postponed = false;
+        }
+        m_lastSamples = accumulatedSamples;
+        due = accumulatedSamples >= m_nextSampleMark;
+    }
+    if (!due) {
+        return false;
+    }
+
+    if (!hasBandwidth()) {
+        // Frame trigger: this point is skipped. Sample trigger: the mark
+        // stays, so the first frame with bandwidth captures it.
+        if (m_settings.trigger == SequenceTrigger::Frames || !m_postponed) {
+            ++m_stats.throttled;
+        }
+        m_postponed = true;
+        return false;
+    }
+
+    if (m_settings.trigger == SequenceTrigger::Samples) {
+        m_nextSampleMark = (accumulatedSamples / m_settings.interval + 1) * m_settings.interval;
+        m_postponed = false;
+    }
+    return true;
+}
+
+int SequenceCapture::beginCapture() {
+    ++m_stats.captured;
+    ++m_inFlight;
+    if (m_settings.maxFrames > 0 && m_stats.captured >= m_settings.maxFrames) {
+        m_active = false;  // Last one; finished() follows once it is written
+    }
+    return m_nextIndex++;
+}
+
+void SequenceCapture::submit(int index, const QImage& image) {
+    if (image.isNull() || !m_queue) {
+        ++m_stats.failed;
+        --m_inFlight;
+        emit statsChanged(stats());
+        maybeFinish();
+        return;
+    }
+
+    const qint64 bytes = image.sizeInBytes();
+    QString error;
+    const quint64 jobId = m_queue->enqueue(image, {{pathFor(index), ImageExportFormat::PNG}},
+                                           exportLabel(), &error);
+    enqueued(jobId, bytes, error);
+}
+
+void SequenceCapture::submit(int index, std::unique_ptr<quantiloom::Image> image) {
+    if (!image || !m_queue) {
+        ++m_stats.failed;
+        --m_inFlight;
+        emit statsChanged(stats());
+        maybeFinish();
+        return;
+    }
+
+    const qint64 bytes = ImageExportQueue::estimateBytes(*image);
+    QString error;
+    const quint64 jobId = m_queue->enqueue(std::move(image), {{pathFor(index), ImageExportFormat::EXR}},
+                                           exportLabel(), &error);
+    enqueued(jobId, bytes, error);
+}
+
+void SequenceCapture::enqueued(quint64 jobId, qint64 estimatedBytes, const QString& error) {
+    if (jobId == 0) {
+        // Export queue over its memory budget: writes are not keeping up
+        qDebug() << "Sequence frame dropped:" << error;
+        ++m_stats.dropped;
+        --m_inFlight;
+    } else {
+        charge(estimatedBytes);
+        m_jobEstimates.insert(jobId, estimatedBytes);
+    }
+    emit statsChanged(stats());
+    maybeFinish();
+}
+
+void SequenceCapture::onExportFinished(quint64 jobId, const QString& label,
+                                       const QStringList& written, const QStringList& failed) {
+    Q_UNUSED(label)
+
+    auto it = m_jobEstimates.find(jobId);
+    if (it == m_jobEstimates.end()) {
+        return;  // Not ours
+    }
+    const qint64 estimated = it.value();
+    m_jobEstimates.erase(it);
+
+    qint64 actual = 0;
+    for (const QString& path : written) {
+        actual += QFileInfo(path).size();
+    }
+    charge(actual - estimated);  // Replace the estimate with the real file size
+
+    m_stats.written += static_cast<quint32>(written.size());
+    m_stats.failed += static_cast<quint32>(failed.size());
+    m_stats.bytesWritten += actual;
+    --m_inFlight;
+
+    emit statsChanged(stats());
+    maybeFinish();
+}
+
+QString SequenceCapture::pathFor(int index) const {
+    const QString extension = m_settings.format == ImageExportFormat::PNG
+        ? QStringLiteral("png") : QStringLiteral("exr");
+    return QDir(m_settings.directory).filePath(
+        QStringLiteral("%1_%2.%3").arg(m_settings.prefix).arg(index, 6, 10, QChar('0')).arg(extension));
+}
+
+bool SequenceCapture::hasBandwidth() {
+    if (m_settings.maxMegabytesPerSecond <= 0.0) {
+        return true;
+    }
+    const double rate = m_settings.maxMegabytesPerSecond * 1e6;
+    m_tokens = std::min(rate, m_tokens + m_bucketTimer.restart() / 1000.0 * rate);
+    return m_tokens >= 0.0;
+}
+
+void SequenceCapture::charge(qint64 bytes) {
+    if (m_settings.maxMegabytesPerSecond > 0.0) {
+        m_tokens -= static_cast<double>(bytes);
+    }
+}
+
+void SequenceCapture::maybeFinish() {
+    if (m_active || m_inFlight > 0 || !m_finishPending) {
+        return;
+    }
+    m_finishPending = false;
+    qDebug() << "Sequence capture finished:" << m_stats.written << "written,"
+             << m_stats.failed << "failed," << m_stats.dropped << "dropped,"
+             << m_stats.throttled << "throttled";
+    emit finished(stats());
+}
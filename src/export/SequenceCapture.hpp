@@ -0,0 +1,154 @@
+/**
+ * @file SequenceCapture.hpp
+ * @brief Numbered image sequences (timelapse, convergence, fly-throughs)
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include "ImageExportQueue.hpp"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <memory>
+
+namespace quantiloom {
+struct Image;
+}
+
+/**
+ * @enum SequenceTrigger
+ * @brief What the capture interval counts
+ */
+enum class SequenceTrigger {
+    Frames,     // Every N-th rendered frame (fly-throughs)
+    Samples     // Every K accumulated samples (convergence)
+};
+
+/**
+ * @struct SequenceCaptureSettings
+ * @brief Output and pacing of a sequence recording
+ */
+struct SequenceCaptureSettings {
+    QString directory;
+    QString prefix = QStringLiteral("frame");
+    ImageExportFormat format = ImageExportFormat::PNG;
+    SequenceTrigger trigger = SequenceTrigger::Frames;
+    uint32_t interval = 10;         // Frames or samples between captures
+    uint32_t maxFrames = 0;         // 0: until stopped
+    double maxMegabytesPerSecond = 0.0;  // Disk bandwidth cap, 0: unlimited
+};
+
+/**
+ * @struct SequenceCaptureStats
+ * @brief Progress of the current (or last) recording
+ */
+struct SequenceCaptureStats {
+    quint32 captured = 0;       // Images taken from the renderer
+    quint32 written = 0;        // Files on disk
+    quint32 failed = 0;         // Write errors
+    quint32 dropped = 0;        // Refused by the export queue (memory budget)
+    quint32 throttled = 0;      // Capture points skipped by the bandwidth cap
+    qint64 bytesWritten = 0;
+    bool active = false;
+};
+
+/**
+ * @class SequenceCapture
+ * @brief Decides which frames to capture and numbers the resulting files
+ *
+ * The renderer asks shouldCapture() once per frame, reserves a sequence
+ * number with beginCapture() and hands the image over with submit() once it
+ * is available (PNG via async readback a frame later, EXR directly).
+ * Encoding happens on the ImageExportQueue; this class never touches disk.
+ *
+ * The bandwidth cap is a token bucket over bytes actually written: each
+ * capture is charged its raw size up front and corrected to the file size
+ * when the write finishes. While the bucket is in debt, capture points are
+ * skipped (frame trigger) or postponed to the next frame (sample trigger).
+ */
+class SequenceCapture : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SequenceCapture(ImageExportQueue* queue, QObject* parent = nullptr);
+
+    /**
+     * @brief Start a new recording (creates the output directory)
+     */
+    bool start(const SequenceCaptureSettings& settings, QString* error = nullptr);
+
+    /**
+     * @brief Stop taking captures; files already queued are still written
+     */
+    void stop();
+
+    [[nodiscard]] bool isActive() const { return m_active; }
+    [[nodiscard]] const SequenceCaptureSettings& settings() const { return m_settings; }
+    [[nodiscard]] SequenceCaptureStats stats() const;
+
+    /**
+     * @brief Label of this recorder's jobs on the export queue
+     */
+    static QString exportLabel() { return QStringLiteral("Sequence"); }
+
+    /**
+     * @brief Call once per rendered frame
+     * @param accumulatedSamples Samples in the image this frame produces
+     * @return true if this frame should be captured
+     */
+    bool shouldCapture(uint32_t accumulatedSamples);
+
+    /**
+     * @brief Reserve the next file number for a capture in flight
+     */
+    int beginCapture();
+
+    /**
+     * @brief Hand over a captured image (null: capture lost)
+     */
+    void submit(int index, const QImage& image);
+    void submit(int index, std::unique_ptr<quantiloom::Image> image);
+
+signals:
+    void statsChanged(const SequenceCaptureStats& stats);
+
+    /**
+     * @brief Recording ended (stopped or frame limit reached) and all files are written
+     */
+    void finished(const SequenceCaptureStats& stats);
+
+private:
+    QString pathFor(int index) const;
+    bool hasBandwidth();
+    void charge(qint64 bytes);
+    void enqueued(quint64 jobId, qint64 estimatedBytes, const QString& error);
+    void onExportFinished(quint64 jobId, const QString& label,
+                          const QStringList& written, const QStringList& failed);
+    void maybeFinish();
+
+    QPointer<ImageExportQueue> m_queue;
+    SequenceCaptureSettings m_settings;
+    SequenceCaptureStats m_stats;
+    bool m_active = false;
+    bool m_finishPending = false;
+
+    // Trigger state
+    quint64 m_framesSeen = 0;
+    uint32_t m_nextSampleMark = 0;
+    uint32_t m_lastSamples = 0;
+    bool m_postponed = false;       // Sample mark waiting for bandwidth
+    int m_nextIndex = 0;
+    int m_inFlight = 0;             // Reserved or queued, not yet written
+
+    // Bandwidth token bucket (bytes; negative = in debt)
+    double m_tokens = 0.0;
+    QElapsedTimer m_bucketTimer;
+
+    QHash<quint64, qint64> m_jobEstimates;  // Export job -> bytes charged
+};
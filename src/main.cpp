@@ -3,13 +3,18 @@
  * @brief Entry point for QuantiloomGUI application
  *
  * Initializes Qt6 application with Vulkan support and launches main window.
+ * With --batch, renders TOML configs headlessly instead (no widgets, no window).
  *
  * @author wtflmao
  */
 
 #include "MainWindow.hpp"
+#include "StartupTrace.hpp"
+#include "batch/BatchRenderer.hpp"
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QCommandLineParser>
 #include <QVulkanInstance>
 #include <QLoggingCategory>
 #include <QTranslator>
@@ -18,18 +23,74 @@
 
 #include <core/Log.hpp>  // libQuantiloom logging
 
+#include <cstring>
+
+namespace {
+
+bool hasBatchFlag(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Headless entry point: QCoreApplication only, no display required
+ */
+int runBatch(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Quantiloom");
+    app.setApplicationVersion("0.0.3");
+    app.setOrganizationName("wtflmao");
+    app.setOrganizationDomain("github.com/wtflmao");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Quantiloom headless batch renderer");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOption({"batch", "Render the given TOML configs to renderer.output and exit."});
+    parser.addOption({"software", "Prefer a CPU Vulkan device (e.g. lavapipe) over GPUs."});
+    parser.addOption({"stop-on-error", "Abort the batch at the first failed scene."});
+    parser.addPositionalArgument("configs", "TOML scene configs to render.", "<config.toml...>");
+    parser.process(app);
+
+    BatchOptions options;
+    options.configPaths = parser.positionalArguments();
+    options.preferSoftware = parser.isSet("software");
+    options.continueOnError = !parser.isSet("stop-on-error");
+
+    BatchRenderer renderer(options);
+    return renderer.run();
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
+    // Cold-start timeline up to the first presented frame
+    StartupTrace::start();
+
     // Set log message format with timestamp [HH:mm:ss.zzz]
     qSetMessagePattern("[%{time HH:mm:ss.zzz}] %{message}");
 
     // Initialize libQuantiloom logging (console only, no log file)
     quantiloom::Log::Init(nullptr, quantiloom::Log::Level::Debug);
 
+    // Headless batch mode bypasses MainWindow and QVulkanWindow entirely
+    if (hasBatchFlag(argc, argv)) {
+        int result = runBatch(argc, argv);
+        quantiloom::Log::Shutdown();
+        return result;
+    }
+
     // Enable high DPI scaling
     QApplication::setHighDpiScaleFactorRoundingPolicy(
         Qt::HighDpiScaleFactorRoundingPolicy::PassThrough);
 
+    StartupTrace::begin("QApplication");
     QApplication app(argc, argv);
+    StartupTrace::end("QApplication");
 
     // Set application metadata
     app.setApplicationName("Quantiloom");
@@ -38,6 +99,7 @@ int main(int argc, char* argv[]) {
     app.setOrganizationDomain("github.com/wtflmao");
 
     // Load translations
+    StartupTrace::begin("Translations");
     QTranslator translator;
 
     // Check for saved language preference first
@@ -68,6 +130,7 @@ int main(int argc, char* argv[]) {
             }
         }
     }
+    StartupTrace::end("Translations");
 
     // Create Vulkan instance for Qt
     QVulkanInstance vulkanInstance;
@@ -86,14 +149,19 @@ int main(int argc, char* argv[]) {
         VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME
     });
 
+    StartupTrace::begin("Vulkan instance creation");
     if (!vulkanInstance.create()) {
         qFatal("Failed to create Vulkan instance: %d", vulkanInstance.errorCode());
         return 1;
     }
+    StartupTrace::end("Vulkan instance creation");
 
-    // Create and show main window
+    // Create and show main window (device creation follows on first expose)
+    StartupTrace::begin("MainWindow construction");
     MainWindow mainWindow(&vulkanInstance);
+    StartupTrace::end("MainWindow construction");
     mainWindow.show();
+    StartupTrace::mark("MainWindow shown");
 
     int result = app.exec();
 
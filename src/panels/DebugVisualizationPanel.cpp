@@ -10,7 +10,18 @@
 #include <QGroupBox>
 #include <QLabel>
 #include <QComboBox>
+#include <QSpinBox>
 #include <QFormLayout>
+#include <QPushButton>
+#include <QPainter>
+#include <QPixmap>
+
+#include <algorithm>
+
+namespace {
+constexpr int kHistogramWidth = 192;
+constexpr int kHistogramHeight = 48;
+}
 
 DebugVisualizationPanel::DebugVisualizationPanel(QWidget* parent)
     : QWidget(parent)
@@ -172,6 +183,81 @@ void DebugVisualizationPanel::setupUi() {
 
     mainLayout->addWidget(modeGroup);
 
+    // Hover probe group
+    auto* probeGroup = new QGroupBox(tr("Pixel Probe"));
+    auto* probeLayout = new QFormLayout(probeGroup);
+
+    m_probeSizeSpin = new QSpinBox();
+    m_probeSizeSpin->setRange(1, 7);
+    m_probeSizeSpin->setSingleStep(2);
+    m_probeSizeSpin->setValue(1);
+    m_probeSizeSpin->setSuffix(tr(" px"));
+    m_probeSizeSpin->setToolTip(tr("Neighbourhood under the cursor (NxN). Values beyond the center "
+                                   "pixel are filled in over the following frames."));
+    connect(m_probeSizeSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, [this](int value) {
+                if (value % 2 == 0) {
+                    m_probeSizeSpin->setValue(value + 1);  // Keep the cursor pixel centred
+                    return;
+                }
+                emit probeSizeChanged(value);
+            });
+    probeLayout->addRow(tr("Probe Size:"), m_probeSizeSpin);
+
+    mainLayout->addWidget(probeGroup);
+
+    // Region statistics group
+    auto* roiGroup = new QGroupBox(tr("Region Statistics"));
+    auto* roiLayout = new QFormLayout(roiGroup);
+
+    auto* roiButtons = new QHBoxLayout();
+    m_roiSelectButton = new QPushButton(tr("Select Region"));
+    m_roiSelectButton->setCheckable(true);
+    m_roiSelectButton->setToolTip(tr("Drag a rectangle in the viewport to track its statistics"));
+    connect(m_roiSelectButton, &QPushButton::toggled,
+            this, &DebugVisualizationPanel::roiSelectRequested);
+    roiButtons->addWidget(m_roiSelectButton);
+
+    m_roiClearButton = new QPushButton(tr("Clear"));
+    m_roiClearButton->setEnabled(false);
+    connect(m_roiClearButton, &QPushButton::clicked,
+            this, &DebugVisualizationPanel::roiCleared);
+    roiButtons->addWidget(m_roiClearButton);
+    roiLayout->addRow(roiButtons);
+
+    m_roiChannelCombo = new QComboBox();
+    m_roiChannelCombo->addItem(tr("Luminance"), static_cast<int>(RoiChannel::Luminance));
+    m_roiChannelCombo->addItem(tr("Red"), static_cast<int>(RoiChannel::Red));
+    m_roiChannelCombo->addItem(tr("Green"), static_cast<int>(RoiChannel::Green));
+    m_roiChannelCombo->addItem(tr("Blue"), static_cast<int>(RoiChannel::Blue));
+    m_roiChannelCombo->setToolTip(tr("Scalar debug modes (temperature, emissivity, ...) "
+                                     "store their value in the red channel"));
+    connect(m_roiChannelCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this](int index) {
+                emit roiChannelChanged(
+                    static_cast<RoiChannel>(m_roiChannelCombo->itemData(index).toInt()));
+            });
+    roiLayout->addRow(tr("Channel:"), m_roiChannelCombo);
+
+    m_roiRegionLabel = new QLabel(tr("None"));
+    roiLayout->addRow(tr("Region:"), m_roiRegionLabel);
+    m_roiMeanLabel = new QLabel();
+    roiLayout->addRow(tr("Mean:"), m_roiMeanLabel);
+    m_roiStdDevLabel = new QLabel();
+    roiLayout->addRow(tr("Std Dev:"), m_roiStdDevLabel);
+    m_roiRangeLabel = new QLabel();
+    roiLayout->addRow(tr("Min / Max:"), m_roiRangeLabel);
+    m_roiSamplesLabel = new QLabel();
+    roiLayout->addRow(tr("Points:"), m_roiSamplesLabel);
+
+    m_roiHistogram = new QLabel();
+    m_roiHistogram->setFixedSize(kHistogramWidth, kHistogramHeight);
+    m_roiHistogram->setStyleSheet("QLabel { background-color: #202020; }");
+    roiLayout->addRow(tr("Histogram:"), m_roiHistogram);
+
+    clearRoiStats();
+    mainLayout->addWidget(roiGroup);
+
     // Info group
     auto* infoGroup = new QGroupBox(tr("Output Interpretation"));
     auto* infoLayout = new QVBoxLayout(infoGroup);
@@ -216,6 +302,84 @@ void DebugVisualizationPanel::setDebugMode(quantiloom::DebugVisualizationMode mo
     updateDescription(mode);
 }
 
+void DebugVisualizationPanel::setRoiSelecting(bool selecting) {
+    m_roiSelectButton->blockSignals(true);
+    m_roiSelectButton->setChecked(selecting);
+    m_roiSelectButton->blockSignals(false);
+}
+
+void DebugVisualizationPanel::setRoiRegion(const QRect& region) {
+    m_roiClearButton->setEnabled(!region.isEmpty());
+    if (region.isEmpty()) {
+        m_roiRegionLabel->setText(tr("None"));
+        clearRoiStats();
+        return;
+    }
+    m_roiRegionLabel->setText(tr("%1 x %2 at (%3, %4)")
+        .arg(region.width()).arg(region.height())
+        .arg(region.x()).arg(region.y()));
+}
+
+void DebugVisualizationPanel::setRoiStats(const RoiStats& stats) {
+    if (stats.count == 0) {
+        clearRoiStats();
+        return;
+    }
+
+    // A grid coarser than the region reads cell centres only: the values are
+    // estimates, and extremes between the centres are not seen
+    const qint64 regionPixels = static_cast<qint64>(stats.region.width()) * stats.region.height();
+    const bool estimated = stats.count < regionPixels;
+    const QString approx = estimated ? QStringLiteral("~") : QString();
+    const QString estimateTip = estimated
+        ? tr("Estimated from %1 of %2 pixels").arg(stats.count).arg(regionPixels)
+        : QString();
+
+    m_roiMeanLabel->setText(approx + QString::number(stats.mean, 'g', 5));
+    m_roiStdDevLabel->setText(approx + QString::number(stats.stddev, 'g', 5));
+    m_roiRangeLabel->setText(approx + QString::number(stats.min, 'g', 5) + QStringLiteral(" / ")
+                             + approx + QString::number(stats.max, 'g', 5));
+    m_roiSamplesLabel->setText(estimated
+        ? tr("%1 of %2 px (%3 x %4 grid, estimate), %5 spp")
+              .arg(stats.count).arg(regionPixels)
+              .arg(stats.gridColumns).arg(stats.gridRows).arg(stats.samples)
+        : tr("%1 px (exact), %2 spp").arg(stats.count).arg(stats.samples));
+    for (QLabel* label : {m_roiMeanLabel, m_roiStdDevLabel, m_roiRangeLabel, m_roiSamplesLabel}) {
+        label->setToolTip(estimateTip);
+    }
+
+    // Bars scaled to the fullest bin
+    QPixmap pixmap(kHistogramWidth, kHistogramHeight);
+    pixmap.fill(QColor(0x20, 0x20, 0x20));
+    const uint32_t peak = *std::max_element(stats.histogram.begin(), stats.histogram.end());
+    if (peak > 0) {
+        QPainter painter(&pixmap);
+        const double barWidth = static_cast<double>(kHistogramWidth) / RoiStats::kHistogramBins;
+        for (int i = 0; i < RoiStats::kHistogramBins; ++i) {
+            const double h = static_cast<double>(stats.histogram[static_cast<size_t>(i)]) / peak *
+                             (kHistogramHeight - 2);
+            painter.fillRect(QRectF(i * barWidth, kHistogramHeight - h, barWidth - 1.0, h),
+                             QColor(0x6a, 0x9a, 0xca));
+        }
+    }
+    m_roiHistogram->setPixmap(pixmap);
+    m_roiHistogram->setToolTip(tr("%1 bins from %2 to %3")
+        .arg(RoiStats::kHistogramBins).arg(stats.min, 0, 'g', 5).arg(stats.max, 0, 'g', 5)
+        + (estimated ? QStringLiteral("\n") + estimateTip : QString()));
+}
+
+void DebugVisualizationPanel::clearRoiStats() {
+    m_roiMeanLabel->setText(QStringLiteral("-"));
+    m_roiStdDevLabel->setText(QStringLiteral("-"));
+    m_roiRangeLabel->setText(QStringLiteral("-"));
+    m_roiSamplesLabel->setText(QStringLiteral("-"));
+    for (QLabel* label : {m_roiMeanLabel, m_roiStdDevLabel, m_roiRangeLabel, m_roiSamplesLabel}) {
+        label->setToolTip(QString());
+    }
+    m_roiHistogram->clear();
+    m_roiHistogram->setToolTip(QString());
+}
+
 void DebugVisualizationPanel::onModeChanged(int index) {
     int modeValue = m_modeCombo->itemData(index).toInt();
 
@@ -11,10 +11,14 @@
 #include <QWidget>
 #include <core/Types.hpp>
 
+#include "vulkan/RoiStatistics.hpp"
+
 QT_BEGIN_NAMESPACE
 class QComboBox;
+class QSpinBox;
 class QLabel;
 class QGroupBox;
+class QPushButton;
 QT_END_NAMESPACE
 
 /**
@@ -39,8 +43,17 @@ public:
     void setDebugMode(quantiloom::DebugVisualizationMode mode);
     [[nodiscard]] quantiloom::DebugVisualizationMode debugMode() const { return m_mode; }
 
+    // Region statistics display
+    void setRoiSelecting(bool selecting);
+    void setRoiRegion(const QRect& region);
+    void setRoiStats(const RoiStats& stats);
+
 signals:
     void debugModeChanged(quantiloom::DebugVisualizationMode mode);
+    void probeSizeChanged(int size);
+    void roiSelectRequested(bool enabled);
+    void roiCleared();
+    void roiChannelChanged(RoiChannel channel);
 
 private slots:
     void onModeChanged(int index);
@@ -48,10 +61,23 @@ private slots:
 private:
     void setupUi();
     void updateDescription(quantiloom::DebugVisualizationMode mode);
+    void clearRoiStats();
 
     quantiloom::DebugVisualizationMode m_mode = quantiloom::DebugVisualizationMode::None;
 
     QComboBox* m_modeCombo = nullptr;
+    QSpinBox* m_probeSizeSpin = nullptr;
     QLabel* m_description = nullptr;
     QLabel* m_categoryLabel = nullptr;
+
+    // Region statistics
+    QPushButton* m_roiSelectButton = nullptr;
+    QPushButton* m_roiClearButton = nullptr;
+    QComboBox* m_roiChannelCombo = nullptr;
+    QLabel* m_roiRegionLabel = nullptr;
+    QLabel* m_roiMeanLabel = nullptr;
+    QLabel* m_roiStdDevLabel = nullptr;
+    QLabel* m_roiRangeLabel = nullptr;
+    QLabel* m_roiSamplesLabel = nullptr;
+    QLabel* m_roiHistogram = nullptr;
 };
@@ -0,0 +1,154 @@
+/**
+ * @file FrameStatsPanel.cpp
+ * @brief Frame timing statistics panel implementation
+ */
+
+#include "FrameStatsPanel.hpp"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QFormLayout>
+#include <QTableWidget>
+#include <QHeaderView>
+
+namespace {
+
+enum StatsColumn { ColMean, ColP50, ColP95, ColP99, ColMax, ColCount };
+
+} // namespace
+
+FrameStatsPanel::FrameStatsPanel(QWidget* parent)
+    : QWidget(parent)
+{
+    setupUi();
+}
+
+void FrameStatsPanel::setupUi() {
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(4, 4, 4, 4);
+    mainLayout->setSpacing(8);
+
+    // Overview group
+    auto* overviewGroup = new QGroupBox(tr("Overview"));
+    auto* overviewLayout = new QFormLayout(overviewGroup);
+
+    m_fpsLabel = new QLabel("--");
+    m_fpsLabel->setStyleSheet("font-weight: bold; font-size: 14pt;");
+    overviewLayout->addRow(tr("FPS (median):"), m_fpsLabel);
+
+    m_gpuLabel = new QLabel("--");
+    overviewLayout->addRow(tr("GPU Frame:"), m_gpuLabel);
+
+    m_windowLabel = new QLabel("0");
+    overviewLayout->addRow(tr("Frames in Window:"), m_windowLabel);
+
+    m_parameterLabel = new QLabel("--");
+    m_parameterLabel->setToolTip(tr("Parameter updates received / coalesced before a frame, "
+                                    "accumulation resets requested / applied"));
+    overviewLayout->addRow(tr("Parameter Queue:"), m_parameterLabel);
+
+    m_schedulerLabel = new QLabel("--");
+    m_schedulerLabel->setWordWrap(true);
+    m_schedulerLabel->setToolTip(tr("Frames are only requested while the image is still "
+                                    "accumulating or something changed"));
+    overviewLayout->addRow(tr("Render Loop:"), m_schedulerLabel);
+
+    mainLayout->addWidget(overviewGroup);
+
+    // Per-span table (milliseconds)
+    auto* spansGroup = new QGroupBox(tr("Frame Time Breakdown (ms)"));
+    auto* spansLayout = new QVBoxLayout(spansGroup);
+
+    m_table = new QTableWidget(kFrameMetricCount, ColCount);
+    m_table->setHorizontalHeaderLabels({tr("Mean"), tr("p50"), tr("p95"), tr("p99"), tr("Max")});
+    m_table->setVerticalHeaderLabels({
+        tr("Frame Interval"), tr("CPU Frame"), tr("Camera Update"), tr("Node Transforms"),
+        tr("Parameter Upload"), tr("Record (CPU)"), tr("Render (GPU)")
+    });
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_table->setStyleSheet("QTableWidget { font-family: monospace; }");
+    for (int row = 0; row < kFrameMetricCount; ++row) {
+        for (int col = 0; col < ColCount; ++col) {
+            auto* item = new QTableWidgetItem("--");
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_table->setItem(row, col, item);
+        }
+    }
+    spansLayout->addWidget(m_table);
+
+    auto* noteLabel = new QLabel(
+        tr("GPU time covers RenderFrame (trace, display enhancement, blit) "
+           "and lags a few frames behind."));
+    noteLabel->setWordWrap(true);
+    noteLabel->setStyleSheet("color: gray; font-size: 9pt;");
+    spansLayout->addWidget(noteLabel);
+
+    mainLayout->addWidget(spansGroup);
+
+    // Actions
+    auto* buttonLayout = new QHBoxLayout();
+    m_resetBtn = new QPushButton(tr("Reset"));
+    m_resetBtn->setToolTip(tr("Clear the timing history"));
+    connect(m_resetBtn, &QPushButton::clicked, this, &FrameStatsPanel::resetRequested);
+    buttonLayout->addWidget(m_resetBtn);
+
+    m_exportBtn = new QPushButton(tr("Export..."));
+    m_exportBtn->setToolTip(tr("Save per-frame timings as CSV or JSON"));
+    connect(m_exportBtn, &QPushButton::clicked, this, &FrameStatsPanel::exportRequested);
+    buttonLayout->addWidget(m_exportBtn);
+    mainLayout->addLayout(buttonLayout);
+
+    mainLayout->addStretch();
+}
+
+void FrameStatsPanel::setStats(const FrameTimingSummary& timings,
+                               const ParameterQueueStats& parameters,
+                               const FrameSchedulerStats& scheduler) {
+    const FrameMetricStats& interval = timings[FrameMetric::Interval];
+    m_fpsLabel->setText(interval.count > 0 && interval.p50 > 0.0
+        ? QString::number(1000.0 / interval.p50, 'f', 1) : QStringLiteral("--"));
+
+    const FrameMetricStats& gpu = timings[FrameMetric::GpuFrame];
+    if (!timings.gpuTimingAvailable) {
+        m_gpuLabel->setText(tr("Unavailable (no timestamp support)"));
+    } else if (gpu.count == 0) {
+        m_gpuLabel->setText("--");
+    } else {
+        m_gpuLabel->setText(tr("%1 ms (p95 %2 ms)")
+            .arg(gpu.p50, 0, 'f', 2).arg(gpu.p95, 0, 'f', 2));
+    }
+
+    m_windowLabel->setText(QString::number(timings.frameCount));
+    m_parameterLabel->setText(tr("%1 updates, %2 coalesced; resets %3 / %4")
+        .arg(parameters.updatesQueued).arg(parameters.updatesCoalesced)
+        .arg(parameters.resetsApplied).arg(parameters.resetsRequested));
+
+    const auto wakeups = [&scheduler](FrameWakeReason reason) {
+        return scheduler.wakeupsByReason[static_cast<size_t>(reason)];
+    };
+    m_schedulerLabel->setText(tr("%1, idle %2 s total; %3 wakeups "
+                                 "(input %4, parameters %5, scene %6, job %7, capture %8, window %9)")
+        .arg(scheduler.idle ? tr("Idle") : tr("Active"))
+        .arg(scheduler.idleSeconds, 0, 'f', 1)
+        .arg(scheduler.wakeups)
+        .arg(wakeups(FrameWakeReason::Input))
+        .arg(wakeups(FrameWakeReason::Parameters))
+        .arg(wakeups(FrameWakeReason::Scene))
+        .arg(wakeups(FrameWakeReason::Job))
+        .arg(wakeups(FrameWakeReason::Capture))
+        .arg(wakeups(FrameWakeReason::External)));
+
+    for (int row = 0; row < kFrameMetricCount; ++row) {
+        const FrameMetricStats& stats = timings.metrics[static_cast<size_t>(row)];
+        const double values[ColCount] = {stats.mean, stats.p50, stats.p95, stats.p99, stats.max};
+        for (int col = 0; col < ColCount; ++col) {
+            m_table->item(row, col)->setText(stats.count > 0
+                ? QString::number(values[col], 'f', 2) : QStringLiteral("--"));
+        }
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file FrameStatsPanel.hpp
+ * @brief Frame timing statistics (CPU spans, GPU time, percentiles)
+ */
+
+#pragma once
+
+#include <QWidget>
+
+#include "vulkan/FrameProfiler.hpp"
+#include "vulkan/ParameterQueueStats.hpp"
+#include "vulkan/FrameScheduler.hpp"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTableWidget;
+QT_END_NAMESPACE
+
+/**
+ * @class FrameStatsPanel
+ * @brief Shows where viewport frame time goes
+ *
+ * Passive view: MainWindow pushes a summary a few times per second while
+ * the panel is visible.
+ */
+class FrameStatsPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit FrameStatsPanel(QWidget* parent = nullptr);
+
+    void setStats(const FrameTimingSummary& timings, const ParameterQueueStats& parameters,
+                  const FrameSchedulerStats& scheduler);
+
+signals:
+    void exportRequested();
+    void resetRequested();
+
+private:
+    void setupUi();
+
+    QLabel* m_fpsLabel = nullptr;
+    QLabel* m_gpuLabel = nullptr;
+    QLabel* m_windowLabel = nullptr;
+    QLabel* m_parameterLabel = nullptr;
+    QLabel* m_schedulerLabel = nullptr;
+    QTableWidget* m_table = nullptr;
+    QPushButton* m_resetBtn = nullptr;
+    QPushButton* m_exportBtn = nullptr;
+};
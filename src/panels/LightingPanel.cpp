@@ -43,6 +43,8 @@ void LightingPanel::setupUi() {
     m_azimuthLabel = new QLabel("180°");
     m_azimuthLabel->setFixedWidth(45);
     connect(m_azimuthSlider, &QSlider::valueChanged, this, &LightingPanel::onSunAzimuthChanged);
+    connect(m_azimuthSlider, &QSlider::sliderPressed, this, &LightingPanel::editStarted);
+    connect(m_azimuthSlider, &QSlider::sliderReleased, this, &LightingPanel::editFinished);
     azimuthRow->addWidget(m_azimuthSlider);
     azimuthRow->addWidget(m_azimuthLabel);
     sunDirLayout->addRow(tr("Azimuth:"), azimuthRow);
@@ -55,6 +57,8 @@ void LightingPanel::setupUi() {
     m_elevationLabel = new QLabel("45°");
     m_elevationLabel->setFixedWidth(45);
     connect(m_elevationSlider, &QSlider::valueChanged, this, &LightingPanel::onSunElevationChanged);
+    connect(m_elevationSlider, &QSlider::sliderPressed, this, &LightingPanel::editStarted);
+    connect(m_elevationSlider, &QSlider::sliderReleased, this, &LightingPanel::editFinished);
     elevationRow->addWidget(m_elevationSlider);
     elevationRow->addWidget(m_elevationLabel);
     sunDirLayout->addRow(tr("Elevation:"), elevationRow);
@@ -98,6 +102,8 @@ void LightingPanel::setupUi() {
     m_transmittanceLabel->setFixedWidth(40);
     connect(m_transmittanceSlider, &QSlider::valueChanged,
             this, &LightingPanel::onTransmittanceChanged);
+    connect(m_transmittanceSlider, &QSlider::sliderPressed, this, &LightingPanel::editStarted);
+    connect(m_transmittanceSlider, &QSlider::sliderReleased, this, &LightingPanel::editFinished);
     transRow->addWidget(m_transmittanceSlider);
     transRow->addWidget(m_transmittanceLabel);
     atmoLayout->addRow(tr("Transmittance:"), transRow);
@@ -35,6 +35,10 @@ public:
 signals:
     void lightingChanged(const quantiloom::LightingParams& params);
 
+    // Slider drag began / ended (edits in between form one gesture)
+    void editStarted();
+    void editFinished();
+
 private slots:
     void onSunAzimuthChanged(int value);
     void onSunElevationChanged(int value);
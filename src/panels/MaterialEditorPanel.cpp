@@ -57,6 +57,8 @@ void MaterialEditorPanel::setupUi() {
     m_metallicLabel = new QLabel("0.00");
     m_metallicLabel->setFixedWidth(40);
     connect(m_metallicSlider, &QSlider::valueChanged, this, &MaterialEditorPanel::onMetallicChanged);
+    connect(m_metallicSlider, &QSlider::sliderPressed, this, &MaterialEditorPanel::editStarted);
+    connect(m_metallicSlider, &QSlider::sliderReleased, this, &MaterialEditorPanel::editFinished);
     metallicRow->addWidget(m_metallicSlider);
     metallicRow->addWidget(m_metallicLabel);
     pbrLayout->addRow(tr("Metallic:"), metallicRow);
@@ -69,6 +71,8 @@ void MaterialEditorPanel::setupUi() {
     m_roughnessLabel = new QLabel("1.00");
     m_roughnessLabel->setFixedWidth(40);
     connect(m_roughnessSlider, &QSlider::valueChanged, this, &MaterialEditorPanel::onRoughnessChanged);
+    connect(m_roughnessSlider, &QSlider::sliderPressed, this, &MaterialEditorPanel::editStarted);
+    connect(m_roughnessSlider, &QSlider::sliderReleased, this, &MaterialEditorPanel::editFinished);
     roughnessRow->addWidget(m_roughnessSlider);
     roughnessRow->addWidget(m_roughnessLabel);
     pbrLayout->addRow(tr("Roughness:"), roughnessRow);
@@ -157,7 +161,7 @@ void MaterialEditorPanel::setupUi() {
 
 void MaterialEditorPanel::setMaterial(int index, const quantiloom::Material* material) {
     m_currentIndex = index;
-    m_currentMaterial = material;
+    m_editedFields = 0;
 
     if (!material) {
         clear();
@@ -224,7 +228,6 @@ void MaterialEditorPanel::setMaterial(int index, const quantiloom::Material* mat
 
 void MaterialEditorPanel::clear() {
     m_currentIndex = -1;
-    m_currentMaterial = nullptr;
     m_materialName->setText(tr("No material selected"));
     setEnabled(false);
 }
@@ -243,6 +246,7 @@ void MaterialEditorPanel::onBaseColorClicked() {
     if (color.isValid()) {
         m_baseColor = glm::vec4(color.redF(), color.greenF(), color.blueF(), m_baseColor.a);
         updateColorButton(m_baseColorBtn, glm::vec3(m_baseColor));
+        m_editedFields |= MaterialBaseColor;
         applyChanges();
     }
 }
@@ -250,12 +254,14 @@ void MaterialEditorPanel::onBaseColorClicked() {
 void MaterialEditorPanel::onMetallicChanged(int value) {
     m_metallic = value / 100.0f;
     m_metallicLabel->setText(QString::number(m_metallic, 'f', 2));
+    m_editedFields |= MaterialMetallic;
     applyChanges();
 }
 
 void MaterialEditorPanel::onRoughnessChanged(int value) {
     m_roughness = value / 100.0f;
     m_roughnessLabel->setText(QString::number(m_roughness, 'f', 2));
+    m_editedFields |= MaterialRoughness;
     applyChanges();
 }
 
@@ -265,6 +271,7 @@ void MaterialEditorPanel::onEmissiveChanged() {
         static_cast<float>(m_emissiveG->value()),
         static_cast<float>(m_emissiveB->value())
     );
+    m_editedFields |= MaterialEmissive;
     applyChanges();
 }
 
@@ -274,6 +281,7 @@ void MaterialEditorPanel::onIRPropertyChanged() {
     m_irTemperature_K = static_cast<float>(m_irTemperatureSpin->value());
 
     updateKirchhoffLabel();
+    m_editedFields |= MaterialIrFields;
     applyChanges();
 }
 
@@ -299,47 +307,44 @@ void MaterialEditorPanel::updateKirchhoffLabel() {
 }
 
 void MaterialEditorPanel::applyChanges() {
-    if (m_currentIndex < 0 || !m_currentMaterial) {
+    if (m_currentIndex < 0) {
+        m_editedFields = 0;
         return;
     }
 
-    // Create modified material
-    quantiloom::Material modified = *m_currentMaterial;
-    modified.baseColorFactor = m_baseColor;
-    modified.metallicFactor = m_metallic;
-    modified.roughnessFactor = m_roughness;
-    modified.emissiveFactor = m_emissive;
+    MaterialFieldValues edited;
+    edited.baseColor = m_baseColor;
+    edited.metallic = m_metallic;
+    edited.roughness = m_roughness;
+    edited.emissive = m_emissive;
 
     // IR properties - set as constant curves (single wavelength point)
     // Using 10000 nm as representative LWIR wavelength
-    if (m_irEmissivity > 0.0f || m_irTransmittance > 0.0f || m_irTemperature_K > 0.0f) {
-        modified.irEmissivityCurve.clear();
-        modified.irTransmittanceCurve.clear();
-        modified.irReflectanceCurve.clear();
-
+    uint32_t fields = m_editedFields;
+    if ((fields & MaterialIrFields) &&
+        (m_irEmissivity > 0.0f || m_irTransmittance > 0.0f || m_irTemperature_K > 0.0f)) {
         // Create constant curve with points at MWIR and LWIR bands
         const float mwir_nm = 4000.0f;  // 4 um
         const float lwir_nm = 10000.0f; // 10 um
 
-        if (m_irEmissivity > 0.0f) {
-            modified.irEmissivityCurve.push_back({mwir_nm, m_irEmissivity});
-            modified.irEmissivityCurve.push_back({lwir_nm, m_irEmissivity});
-        }
-
-        if (m_irTransmittance > 0.0f) {
-            modified.irTransmittanceCurve.push_back({mwir_nm, m_irTransmittance});
-            modified.irTransmittanceCurve.push_back({lwir_nm, m_irTransmittance});
-        }
+        auto constantCurve = [&](float value) -> SharedMaterialCurve {
+            if (value <= 0.0f) {
+                return nullptr;
+            }
+            return internMaterialCurve(MaterialCurve{{mwir_nm, value}, {lwir_nm, value}});
+        };
 
+        edited.irEmissivity = constantCurve(m_irEmissivity);
+        edited.irTransmittance = constantCurve(m_irTransmittance);
         // Compute reflectance from energy conservation
-        float reflectance = 1.0f - m_irEmissivity - m_irTransmittance;
-        if (reflectance > 0.0f) {
-            modified.irReflectanceCurve.push_back({mwir_nm, reflectance});
-            modified.irReflectanceCurve.push_back({lwir_nm, reflectance});
-        }
-
-        modified.irTemperature_K = m_irTemperature_K;
+        edited.irReflectance = constantCurve(1.0f - m_irEmissivity - m_irTransmittance);
+        edited.irTemperature_K = m_irTemperature_K;
+    } else {
+        fields &= ~static_cast<uint32_t>(MaterialIrFields);
     }
+    m_editedFields = 0;
 
-    emit materialChanged(m_currentIndex, modified);
+    if (fields != 0) {
+        emit materialChanged(m_currentIndex, edited, fields);
+    }
 }
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "editing/MaterialDelta.hpp"
+
 #include <QWidget>
 #include <glm/glm.hpp>
 
@@ -17,10 +19,6 @@ class QGroupBox;
 class QCheckBox;
 QT_END_NAMESPACE
 
-namespace quantiloom {
-struct Material;
-}
-
 /**
  * @class MaterialEditorPanel
  * @brief Editor for PBR material properties
@@ -34,8 +32,16 @@ public:
     void setMaterial(int index, const quantiloom::Material* material);
     void clear();
 
+    // Index of the material being edited (-1: none)
+    int currentIndex() const { return m_currentIndex; }
+
 signals:
-    void materialChanged(int index, const quantiloom::Material& material);
+    // Values of the fields touched by the edit (fields: MaterialField mask)
+    void materialChanged(int index, const MaterialFieldValues& values, uint32_t fields);
+
+    // Slider drag began / ended (edits in between form one gesture)
+    void editStarted();
+    void editFinished();
 
 private slots:
     void onBaseColorClicked();
@@ -51,7 +57,7 @@ private:
     void updateKirchhoffLabel();
 
     int m_currentIndex = -1;
-    const quantiloom::Material* m_currentMaterial = nullptr;
+    uint32_t m_editedFields = 0;  // MaterialField mask for the next applyChanges()
 
     // UI elements
     QLabel* m_materialName = nullptr;
@@ -10,11 +10,13 @@
 #include <QGroupBox>
 #include <QLabel>
 #include <QSpinBox>
+#include <QDoubleSpinBox>
 #include <QComboBox>
 #include <QPushButton>
 #include <QCheckBox>
 #include <QFormLayout>
 #include <QFileDialog>
+#include <QPointF>
 
 RenderSettingsPanel::RenderSettingsPanel(QWidget* parent)
     : QWidget(parent)
@@ -64,6 +66,29 @@ void RenderSettingsPanel::setupUi() {
             this, &RenderSettingsPanel::onCustomSppChanged);
     qualityLayout->addRow(tr("Custom SPP:"), m_customSpp);
 
+    // Adaptive SPP (target SPP becomes the upper limit)
+    m_adaptiveSppCheck = new QCheckBox(tr("Adaptive SPP"));
+    m_adaptiveSppCheck->setToolTip(tr("Adjust samples per frame to hold the frame budget.\n"
+                                      "Drops to 1 SPP while the camera or an object moves;\n"
+                                      "Target SPP is the upper limit."));
+    connect(m_adaptiveSppCheck, &QCheckBox::toggled,
+            this, &RenderSettingsPanel::onAdaptiveSppChanged);
+    qualityLayout->addRow(m_adaptiveSppCheck);
+
+    m_frameBudgetSpin = new QDoubleSpinBox();
+    m_frameBudgetSpin->setRange(4.0, 200.0);
+    m_frameBudgetSpin->setSingleStep(1.0);
+    m_frameBudgetSpin->setDecimals(1);
+    m_frameBudgetSpin->setSuffix(tr(" ms"));
+    m_frameBudgetSpin->setValue(m_frameBudgetMs);
+    m_frameBudgetSpin->setEnabled(false);
+    connect(m_frameBudgetSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &RenderSettingsPanel::onAdaptiveSppChanged);
+    qualityLayout->addRow(tr("Frame Budget:"), m_frameBudgetSpin);
+
+    m_frameSppLabel = new QLabel("--");
+    qualityLayout->addRow(tr("SPP This Frame:"), m_frameSppLabel);
+
     // Progressive rendering
     m_progressiveCheck = new QCheckBox(tr("Progressive Rendering"));
     m_progressiveCheck->setChecked(true);
@@ -72,6 +97,40 @@ void RenderSettingsPanel::setupUi() {
 
     mainLayout->addWidget(qualityGroup);
 
+    // Convergence group
+    auto* convergenceGroup = new QGroupBox(tr("Convergence"));
+    auto* convergenceLayout = new QFormLayout(convergenceGroup);
+
+    m_autoStopCheck = new QCheckBox(tr("Stop When Converged"));
+    m_autoStopCheck->setToolTip(tr("Stop rendering once the image no longer changes noticeably.\n"
+                                   "Any edit or camera move resumes accumulation."));
+    connect(m_autoStopCheck, &QCheckBox::toggled,
+            this, &RenderSettingsPanel::onConvergenceChanged);
+    convergenceLayout->addRow(m_autoStopCheck);
+
+    m_noiseThresholdSpin = new QDoubleSpinBox();
+    m_noiseThresholdSpin->setRange(0.05, 10.0);
+    m_noiseThresholdSpin->setSingleStep(0.1);
+    m_noiseThresholdSpin->setDecimals(2);
+    m_noiseThresholdSpin->setSuffix(tr(" %"));
+    m_noiseThresholdSpin->setValue(1.0);
+    m_noiseThresholdSpin->setToolTip(tr("Mean relative change of probe pixels between\n"
+                                        "sample checkpoints (16, 32, 64, ...)"));
+    m_noiseThresholdSpin->setEnabled(false);
+    connect(m_noiseThresholdSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &RenderSettingsPanel::onConvergenceChanged);
+    convergenceLayout->addRow(tr("Noise Threshold:"), m_noiseThresholdSpin);
+
+    m_maxSamplesSpin = new QSpinBox();
+    m_maxSamplesSpin->setRange(16, 1 << 20);
+    m_maxSamplesSpin->setValue(4096);
+    m_maxSamplesSpin->setToolTip(tr("Accumulation stops here even with auto-stop disabled"));
+    connect(m_maxSamplesSpin, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &RenderSettingsPanel::onConvergenceChanged);
+    convergenceLayout->addRow(tr("Max Samples:"), m_maxSamplesSpin);
+
+    mainLayout->addWidget(convergenceGroup);
+
     // Resolution group
     auto* resGroup = new QGroupBox(tr("Resolution"));
     auto* resLayout = new QFormLayout(resGroup);
@@ -90,6 +149,23 @@ void RenderSettingsPanel::setupUi() {
     m_resolutionLabel = new QLabel("1280 x 720");
     resLayout->addRow(tr("Current:"), m_resolutionLabel);
 
+    // Viewport trace size (scaled to the window; window resizes apply once settled)
+    m_viewportResolution = new QComboBox();
+    m_viewportResolution->addItem(tr("Window Size"), QPointF(1.0, 0));
+    m_viewportResolution->addItem(tr("75% of Window"), QPointF(0.75, 0));
+    m_viewportResolution->addItem(tr("50% of Window"), QPointF(0.5, 0));
+    m_viewportResolution->addItem(tr("720 Rows"), QPointF(1.0, 720));
+    m_viewportResolution->addItem(tr("1080 Rows"), QPointF(1.0, 1080));
+    m_viewportResolution->setToolTip(
+        tr("Resolution the viewport is traced at. Resizing the window keeps the current "
+           "accumulation and reallocates only after the resize settles."));
+    connect(m_viewportResolution, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &RenderSettingsPanel::onViewportResolutionChanged);
+    resLayout->addRow(tr("Viewport:"), m_viewportResolution);
+
+    m_viewportSizeLabel = new QLabel("-");
+    resLayout->addRow(tr("Viewport Size:"), m_viewportSizeLabel);
+
     mainLayout->addWidget(resGroup);
 
     // Actions group
@@ -115,6 +191,10 @@ void RenderSettingsPanel::setSampleCount(uint32_t count) {
     m_sampleCountLabel->setText(QString::number(count));
 }
 
+void RenderSettingsPanel::setFrameSpp(uint32_t spp) {
+    m_frameSppLabel->setText(QString::number(spp));
+}
+
 void RenderSettingsPanel::setTargetSPP(uint32_t spp) {
     m_targetSPP = spp;
 
@@ -145,6 +225,11 @@ void RenderSettingsPanel::setResolution(uint32_t width, uint32_t height) {
     m_resolutionLabel->setText(QString("%1 x %2").arg(width).arg(height));
 }
 
+void RenderSettingsPanel::setViewportRenderSize(const QSize& size) {
+    m_viewportSizeLabel->setText(size.isEmpty() ? QString("-")
+                                                : QString("%1 x %2").arg(size.width()).arg(size.height()));
+}
+
 void RenderSettingsPanel::onSppPresetChanged(int index) {
     int spp = m_sppPreset->itemData(index).toInt();
 
@@ -168,6 +253,20 @@ void RenderSettingsPanel::onCustomSppChanged(int value) {
     }
 }
 
+void RenderSettingsPanel::onAdaptiveSppChanged() {
+    m_adaptiveSpp = m_adaptiveSppCheck->isChecked();
+    m_frameBudgetMs = m_frameBudgetSpin->value();
+    m_frameBudgetSpin->setEnabled(m_adaptiveSpp);
+    emit adaptiveSppChanged(m_adaptiveSpp, m_frameBudgetMs);
+}
+
+void RenderSettingsPanel::onConvergenceChanged() {
+    const bool enabled = m_autoStopCheck->isChecked();
+    m_noiseThresholdSpin->setEnabled(enabled);
+    emit convergenceSettingsChanged(enabled, m_noiseThresholdSpin->value() / 100.0,
+                                    static_cast<uint32_t>(m_maxSamplesSpin->value()));
+}
+
 void RenderSettingsPanel::onResolutionPresetChanged(int index) {
     QSize size = m_resolutionPreset->itemData(index).toSize();
 
@@ -180,6 +279,11 @@ void RenderSettingsPanel::onResolutionPresetChanged(int index) {
     // Window Size option (0,0) - no emit, use actual window size
 }
 
+void RenderSettingsPanel::onViewportResolutionChanged(int index) {
+    const QPointF mode = m_viewportResolution->itemData(index).toPointF();
+    emit viewportResolutionChanged(mode.x(), static_cast<int>(mode.y()));
+}
+
 void RenderSettingsPanel::onExportClicked() {
     QString fileName = QFileDialog::getSaveFileName(
         this,
@@ -14,6 +14,7 @@ class QLabel;
 class QPushButton;
 class QGroupBox;
 class QCheckBox;
+class QDoubleSpinBox;
 QT_END_NAMESPACE
 
 /**
@@ -27,24 +28,34 @@ public:
     explicit RenderSettingsPanel(QWidget* parent = nullptr);
 
     void setSampleCount(uint32_t count);
+    void setFrameSpp(uint32_t spp);
     void setTargetSPP(uint32_t spp);
     void setResolution(uint32_t width, uint32_t height);
+    void setViewportRenderSize(const QSize& size);
 
     // Getters for current settings
     uint32_t width() const { return m_width; }
     uint32_t height() const { return m_height; }
     uint32_t spp() const { return m_targetSPP; }
+    bool isAdaptiveSpp() const { return m_adaptiveSpp; }
+    double frameBudgetMs() const { return m_frameBudgetMs; }
 
 signals:
     void sppChanged(uint32_t spp);
+    void adaptiveSppChanged(bool enabled, double budgetMs);
+    void convergenceSettingsChanged(bool enabled, double threshold, uint32_t maxSamples);
     void resolutionChanged(uint32_t width, uint32_t height);
+    void viewportResolutionChanged(double scale, int fixedHeight);
     void exportRequested(const QString& format);
     void resetAccumulationRequested();
 
 private slots:
     void onSppPresetChanged(int index);
     void onCustomSppChanged(int value);
+    void onAdaptiveSppChanged();
+    void onConvergenceChanged();
     void onResolutionPresetChanged(int index);
+    void onViewportResolutionChanged(int index);
     void onExportClicked();
     void onResetClicked();
 
@@ -54,6 +65,8 @@ private:
 
     // Current settings
     uint32_t m_targetSPP = 4;
+    bool m_adaptiveSpp = false;
+    double m_frameBudgetMs = 16.0;
     uint32_t m_width = 1280;
     uint32_t m_height = 720;
 
@@ -61,8 +74,16 @@ private:
     QLabel* m_sampleCountLabel = nullptr;
     QComboBox* m_sppPreset = nullptr;
     QSpinBox* m_customSpp = nullptr;
+    QCheckBox* m_adaptiveSppCheck = nullptr;
+    QDoubleSpinBox* m_frameBudgetSpin = nullptr;
+    QLabel* m_frameSppLabel = nullptr;
+    QCheckBox* m_autoStopCheck = nullptr;
+    QDoubleSpinBox* m_noiseThresholdSpin = nullptr;
+    QSpinBox* m_maxSamplesSpin = nullptr;
     QComboBox* m_resolutionPreset = nullptr;
     QLabel* m_resolutionLabel = nullptr;
+    QComboBox* m_viewportResolution = nullptr;
+    QLabel* m_viewportSizeLabel = nullptr;
     QPushButton* m_exportBtn = nullptr;
     QPushButton* m_resetBtn = nullptr;
     QCheckBox* m_progressiveCheck = nullptr;
@@ -0,0 +1,315 @@
+/**
+ * @file SceneTreeModel.cpp
+ * @brief Virtualized scene tree model implementation
+ */
+
+#include "SceneTreeModel.hpp"
+
+#include <QBrush>
+#include <QColor>
+#include <algorithm>
+
+// SDK headers
+#include <scene/Scene.hpp>
+#include <scene/Material.hpp>
+
+namespace {
+
+const QColor kHighlightColor(74, 144, 217);  // Blue highlight
+
+} // namespace
+
+SceneTreeModel::SceneTreeModel(QObject* parent)
+    : QAbstractItemModel(parent)
+{
+}
+
+void SceneTreeModel::setScene(const quantiloom::Scene* scene) {
+    beginResetModel();
+    m_scene = scene;
+    m_highlighted.clear();
+    resetCounts();
+    endResetModel();
+}
+
+void SceneTreeModel::refresh() {
+    beginResetModel();
+    resetCounts();
+    endResetModel();
+}
+
+void SceneTreeModel::resetCounts() {
+    m_fetched.fill(0);
+    m_stats = {};
+    if (!m_scene) {
+        return;
+    }
+
+    // Statistics walk every mesh, so compute them once rather than per paint
+    m_stats[0] = QString::number(m_scene->meshes.size());
+    m_stats[1] = QString::number(m_scene->GetTotalTriangleCount());
+    m_stats[2] = QString::number(m_scene->GetTotalVertexCount());
+    m_fetched[static_cast<int>(Group::Statistics)] = kStatCount;
+}
+
+int SceneTreeModel::totalRows(Group group) const {
+    if (!m_scene) {
+        return 0;
+    }
+    switch (group) {
+        case Group::Nodes: return static_cast<int>(m_scene->nodes.size());
+        case Group::Materials: return static_cast<int>(m_scene->materials.size());
+        case Group::Textures: return static_cast<int>(m_scene->textures.size());
+        case Group::Statistics: return kStatCount;
+        default: return 0;
+    }
+}
+
+QModelIndex SceneTreeModel::sceneRootIndex() const {
+    return m_scene ? createIndex(0, 0, kSceneId) : QModelIndex();
+}
+
+QModelIndex SceneTreeModel::groupIndex(Group group) const {
+    return m_scene ? createIndex(static_cast<int>(group), 0, kGroupId) : QModelIndex();
+}
+
+QModelIndex SceneTreeModel::nodeIndex(int nodeIndex) {
+    if (nodeIndex < 0 || nodeIndex >= totalRows(Group::Nodes)) {
+        return QModelIndex();
+    }
+    // Row == node index; only the rows before it may need fetching
+    const int fetched = m_fetched[static_cast<int>(Group::Nodes)];
+    if (nodeIndex >= fetched) {
+        const int wanted = (nodeIndex / kFetchChunk + 1) * kFetchChunk;
+        fetchRows(Group::Nodes, wanted - fetched);
+    }
+    return createIndex(nodeIndex, 0, kItemIdBase + static_cast<quintptr>(Group::Nodes));
+}
+
+void SceneTreeModel::setHighlightedNodes(const QSet<int>& nodeIndices) {
+    QSet<int> changed = m_highlighted;
+    changed.unite(nodeIndices);
+    for (int nodeIndex : nodeIndices) {
+        if (m_highlighted.contains(nodeIndex)) {
+            changed.remove(nodeIndex);
+        }
+    }
+    m_highlighted = nodeIndices;
+    emitNodeRowsChanged(changed);
+}
+
+void SceneTreeModel::emitNodeRowsChanged(const QSet<int>& nodeIndices) {
+    // One span over the changed rows: views only repaint what is visible
+    const int fetched = m_fetched[static_cast<int>(Group::Nodes)];
+    int first = fetched;
+    int last = -1;
+    for (int nodeIndex : nodeIndices) {
+        if (nodeIndex >= 0 && nodeIndex < fetched) {
+            first = std::min(first, nodeIndex);
+            last = std::max(last, nodeIndex);
+        }
+    }
+    if (last < first) {
+        return;
+    }
+    const quintptr id = kItemIdBase + static_cast<quintptr>(Group::Nodes);
+    emit dataChanged(createIndex(first, 0, id), createIndex(last, columnCount() - 1, id),
+                     {Qt::BackgroundRole, Qt::ForegroundRole});
+}
+
+QModelIndex SceneTreeModel::index(int row, int column, const QModelIndex& parent) const {
+    if (!m_scene || row < 0 || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+    if (!parent.isValid()) {
+        return row == 0 ? createIndex(row, column, kSceneId) : QModelIndex();
+    }
+    if (parent.internalId() == kSceneId) {
+        return row < kGroupCount ? createIndex(row, column, kGroupId) : QModelIndex();
+    }
+    if (parent.internalId() == kGroupId && row < m_fetched[parent.row()]) {
+        return createIndex(row, column, kItemIdBase + static_cast<quintptr>(parent.row()));
+    }
+    return QModelIndex();
+}
+
+QModelIndex SceneTreeModel::parent(const QModelIndex& child) const {
+    if (!child.isValid() || child.internalId() == kSceneId) {
+        return QModelIndex();
+    }
+    if (child.internalId() == kGroupId) {
+        return createIndex(0, 0, kSceneId);
+    }
+    return createIndex(static_cast<int>(child.internalId() - kItemIdBase), 0, kGroupId);
+}
+
+int SceneTreeModel::rowCount(const QModelIndex& parent) const {
+    if (!m_scene) {
+        return 0;
+    }
+    if (!parent.isValid()) {
+        return 1;
+    }
+    if (parent.column() > 0) {
+        return 0;
+    }
+    if (parent.internalId() == kSceneId) {
+        return kGroupCount;
+    }
+    if (parent.internalId() == kGroupId) {
+        return m_fetched[parent.row()];
+    }
+    return 0;
+}
+
+int SceneTreeModel::columnCount(const QModelIndex& /*parent*/) const {
+    return 2;
+}
+
+bool SceneTreeModel::hasChildren(const QModelIndex& parent) const {
+    // Groups report children before any are fetched, so they can be expanded
+    if (parent.isValid() && parent.internalId() == kGroupId) {
+        return parent.column() == 0 && totalRows(static_cast<Group>(parent.row())) > 0;
+    }
+    return QAbstractItemModel::hasChildren(parent);
+}
+
+bool SceneTreeModel::canFetchMore(const QModelIndex& parent) const {
+    if (!parent.isValid() || parent.internalId() != kGroupId) {
+        return false;
+    }
+    return m_fetched[parent.row()] < totalRows(static_cast<Group>(parent.row()));
+}
+
+void SceneTreeModel::fetchMore(const QModelIndex& parent) {
+    if (canFetchMore(parent)) {
+        fetchRows(static_cast<Group>(parent.row()), kFetchChunk);
+    }
+}
+
+void SceneTreeModel::fetchRows(Group group, int count) {
+    const int g = static_cast<int>(group);
+    const int first = m_fetched[g];
+    const int last = std::min(first + count, totalRows(group)) - 1;
+    if (last < first) {
+        return;
+    }
+    beginInsertRows(groupIndex(group), first, last);
+    m_fetched[g] = last + 1;
+    endInsertRows();
+}
+
+QVariant SceneTreeModel::data(const QModelIndex& index, int role) const {
+    if (!m_scene || !index.isValid()) {
+        return QVariant();
+    }
+
+    if (index.internalId() == kSceneId) {
+        if (role != Qt::DisplayRole) {
+            return QVariant();
+        }
+        return index.column() == 0 ? QString::fromStdString(m_scene->name) : tr("Scene");
+    }
+    if (index.internalId() == kGroupId) {
+        return groupData(static_cast<Group>(index.row()), index.column(), role);
+    }
+    return itemData(static_cast<Group>(index.internalId() - kItemIdBase),
+                    index.row(), index.column(), role);
+}
+
+QVariant SceneTreeModel::groupData(Group group, int column, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (column == 1) {
+        return group == Group::Statistics ? tr("Info") : tr("Group");
+    }
+    switch (group) {
+        case Group::Nodes: return tr("Nodes (%1)").arg(totalRows(group));
+        case Group::Materials: return tr("Materials (%1)").arg(totalRows(group));
+        case Group::Textures: return tr("Textures (%1)").arg(totalRows(group));
+        case Group::Statistics: return tr("Statistics");
+        default: return QVariant();
+    }
+}
+
+QVariant SceneTreeModel::itemData(Group group, int row, int column, int role) const {
+    const auto i = static_cast<size_t>(row);
+
+    switch (group) {
+        case Group::Nodes: {
+            const bool highlighted = m_highlighted.contains(row);
+            switch (role) {
+                case Qt::DisplayRole: {
+                    if (column == 1) {
+                        return tr("Node");
+                    }
+                    const auto& node = m_scene->nodes[i];
+                    if (node.meshIndex < m_scene->meshes.size()) {
+                        const auto& mesh = m_scene->meshes[node.meshIndex];
+                        if (!mesh.name.empty()) {
+                            return QString::fromStdString(mesh.name);
+                        }
+                    }
+                    return QString("Node %1").arg(row);
+                }
+                case Qt::BackgroundRole:
+                    return highlighted ? QBrush(kHighlightColor) : QVariant();
+                case Qt::ForegroundRole:
+                    return highlighted ? QBrush(Qt::white) : QVariant();
+                case SceneIndexRole: return row;
+                case ItemKindRole: return QStringLiteral("node");
+                default: return QVariant();
+            }
+        }
+
+        case Group::Materials:
+            switch (role) {
+                case Qt::DisplayRole: {
+                    if (column == 1) {
+                        return tr("Material");
+                    }
+                    const auto& mat = m_scene->materials[i];
+                    return mat.name.empty() ? QString("Material %1").arg(row)
+                                            : QString::fromStdString(mat.name);
+                }
+                case SceneIndexRole: return row;
+                case ItemKindRole: return QStringLiteral("material");
+                default: return QVariant();
+            }
+
+        case Group::Textures: {
+            if (role == SceneIndexRole) return row;
+            if (role == ItemKindRole) return QStringLiteral("texture");
+            if (role != Qt::DisplayRole) return QVariant();
+            const auto& tex = m_scene->textures[i];
+            if (column == 1) {
+                return QString("%1x%2").arg(tex.width).arg(tex.height);
+            }
+            return tex.name.empty() ? QString("Texture %1").arg(row)
+                                    : QString::fromStdString(tex.name);
+        }
+
+        case Group::Statistics: {
+            if (role == ItemKindRole) return QStringLiteral("stat");
+            if (role != Qt::DisplayRole) return QVariant();
+            if (column == 1) {
+                return m_stats[i];
+            }
+            static const char* const kStatNames[kStatCount] = {
+                QT_TR_NOOP("Meshes"), QT_TR_NOOP("Triangles"), QT_TR_NOOP("Vertices")
+            };
+            return tr(kStatNames[i]);
+        }
+
+        default:
+            return QVariant();
+    }
+}
+
+QVariant SceneTreeModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    return section == 0 ? tr("Name") : tr("Type");
+}
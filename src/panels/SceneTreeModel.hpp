@@ -0,0 +1,93 @@
+/**
+ * @file SceneTreeModel.hpp
+ * @brief Virtualized item model over a scene's nodes, materials and textures
+ */
+
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QSet>
+#include <array>
+
+namespace quantiloom {
+class Scene;
+}
+
+/**
+ * @class SceneTreeModel
+ * @brief Scene > {Nodes, Materials, Textures, Statistics} > items
+ *
+ * No per-item objects are created: rows are computed from the scene when
+ * the view asks for them, and the row of an item is its scene index, so
+ * looking up a node is O(1). Group rows are fetched lazily in chunks as
+ * the view scrolls (canFetchMore / fetchMore).
+ */
+class SceneTreeModel : public QAbstractItemModel {
+    Q_OBJECT
+
+public:
+    enum class Group {
+        Nodes,
+        Materials,
+        Textures,
+        Statistics,
+        Count
+    };
+
+    enum Role {
+        SceneIndexRole = Qt::UserRole,  // int, index into the scene's array
+        ItemKindRole                    // "node" / "material" / "texture" / "stat"
+    };
+
+    static constexpr int kFetchChunk = 4096;
+
+    explicit SceneTreeModel(QObject* parent = nullptr);
+
+    void setScene(const quantiloom::Scene* scene);
+    void refresh();
+
+    /**
+     * @brief Index of a node row, fetching rows up to it if needed
+     */
+    QModelIndex nodeIndex(int nodeIndex);
+    QModelIndex groupIndex(Group group) const;
+    QModelIndex sceneRootIndex() const;
+
+    /**
+     * @brief Replace the set of highlighted nodes (only changed rows are updated)
+     */
+    void setHighlightedNodes(const QSet<int>& nodeIndices);
+    const QSet<int>& highlightedNodes() const { return m_highlighted; }
+
+    // QAbstractItemModel
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+private:
+    // internalId: kSceneId for the root, kGroupId for groups, kItemIdBase + group for items
+    static constexpr quintptr kSceneId = 0;
+    static constexpr quintptr kGroupId = 1;
+    static constexpr quintptr kItemIdBase = 2;
+    static constexpr int kGroupCount = static_cast<int>(Group::Count);
+    static constexpr int kStatCount = 3;
+
+    void resetCounts();
+    int totalRows(Group group) const;
+    void fetchRows(Group group, int count);
+    void emitNodeRowsChanged(const QSet<int>& nodeIndices);
+
+    QVariant groupData(Group group, int column, int role) const;
+    QVariant itemData(Group group, int row, int column, int role) const;
+
+    const quantiloom::Scene* m_scene = nullptr;
+    std::array<int, kGroupCount> m_fetched{};  // Rows exposed to views so far
+    std::array<QString, kStatCount> m_stats;   // Computed once per scene
+    QSet<int> m_highlighted;
+};
@@ -9,17 +9,22 @@
 #include <QSet>
 
 QT_BEGIN_NAMESPACE
-class QTreeWidget;
-class QTreeWidgetItem;
+class QTreeView;
+class QModelIndex;
 QT_END_NAMESPACE
 
 namespace quantiloom {
 class Scene;
 }
 
+class SceneTreeModel;
+
 /**
  * @class SceneTreePanel
  * @brief Displays scene hierarchy (meshes, nodes, materials)
+ *
+ * Backed by SceneTreeModel, so building the tree and highlighting a
+ * selection cost no per-node items even for very large stages.
  */
 class SceneTreePanel : public QWidget {
     Q_OBJECT
@@ -46,13 +51,11 @@ signals:
     void materialSelected(int materialIndex);
 
 private slots:
-    void onItemClicked(QTreeWidgetItem* item, int column);
+    void onItemClicked(const QModelIndex& index);
 
 private:
-    void populateTree();
-    QTreeWidgetItem* findNodeItem(int nodeIndex);
+    void expandDefaultGroups();
 
-    QTreeWidget* m_tree = nullptr;
-    const quantiloom::Scene* m_scene = nullptr;
-    QSet<int> m_highlightedNodes;
+    QTreeView* m_tree = nullptr;
+    SceneTreeModel* m_model = nullptr;
 };
@@ -0,0 +1,65 @@
+/**
+ * @file AdaptiveSppController.cpp
+ * @brief Adaptive SPP controller implementation
+ *
+ * @author wtflmao
+ */
+
+#include "AdaptiveSppController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Weight of a new measurement in the cost average
+constexpr double kSmoothing = 0.25;
+
+// Aim slightly below the budget so noise does not push frames over it
+constexpr double kHeadroom = 0.9;
+
+} // namespace
+
+void AdaptiveSppController::setBudgetMs(double budgetMs) {
+    m_budgetMs = std::max(1.0, budgetMs);
+}
+
+void AdaptiveSppController::setMaxSpp(uint32_t maxSpp) {
+    m_maxSpp = std::max(1u, maxSpp);
+    m_spp = std::min(m_spp, m_maxSpp);
+}
+
+void AdaptiveSppController::addMeasurement(double frameMs, uint32_t spp) {
+    if (frameMs <= 0.0 || spp == 0) {
+        return;
+    }
+    const double cost = frameMs / static_cast<double>(spp);
+    m_costPerSampleMs = m_costPerSampleMs > 0.0
+        ? m_costPerSampleMs + kSmoothing * (cost - m_costPerSampleMs)
+        : cost;
+    m_hasNewMeasurement = true;
+}
+
+uint32_t AdaptiveSppController::update(bool interacting) {
+    if (interacting) {
+        m_spp = 1;
+        return m_spp;
+    }
+    if (!m_hasNewMeasurement || m_costPerSampleMs <= 0.0) {
+        return m_spp;  // Keep the current value until a frame at it has been measured
+    }
+    m_hasNewMeasurement = false;
+
+    const double fit = std::floor(m_budgetMs * kHeadroom / m_costPerSampleMs);
+    const uint32_t target = static_cast<uint32_t>(std::clamp(fit, 1.0, static_cast<double>(m_maxSpp)));
+
+    // Drop immediately, grow gradually
+    m_spp = target < m_spp ? target : std::min(target, m_spp * 2);
+    return m_spp;
+}
+
+void AdaptiveSppController::reset() {
+    m_costPerSampleMs = 0.0;
+    m_hasNewMeasurement = false;
+    m_spp = 1;
+}
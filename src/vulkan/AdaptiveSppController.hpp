@@ -0,0 +1,57 @@
+/**
+ * @file AdaptiveSppController.hpp
+ * @brief Per-frame SPP controller that holds a frame-time budget
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @class AdaptiveSppController
+ * @brief Chooses samples per frame from measured frame cost
+ *
+ * Tracks a smoothed cost per sample (frame time / SPP of that frame) and
+ * picks the largest SPP that fits the budget, up to a maximum. While the
+ * user interacts the SPP is pinned to 1 so the viewport follows the input;
+ * once static it ramps up by at most a factor of two per update so a
+ * single cheap frame cannot overshoot the budget.
+ */
+class AdaptiveSppController {
+public:
+    void setBudgetMs(double budgetMs);
+    [[nodiscard]] double budgetMs() const { return m_budgetMs; }
+
+    /**
+     * @brief Upper limit (the fixed SPP setting)
+     */
+    void setMaxSpp(uint32_t maxSpp);
+
+    /**
+     * @brief Feed the measured time of a frame rendered at spp samples
+     */
+    void addMeasurement(double frameMs, uint32_t spp);
+
+    /**
+     * @brief Compute the SPP for the next frame
+     * @param interacting Camera or gizmo moved recently
+     */
+    uint32_t update(bool interacting);
+
+    [[nodiscard]] uint32_t currentSpp() const { return m_spp; }
+
+    /**
+     * @brief Forget the cost estimate (scene or resolution changed)
+     */
+    void reset();
+
+private:
+    double m_budgetMs = 16.0;
+    uint32_t m_maxSpp = 4;
+    uint32_t m_spp = 1;
+
+    double m_costPerSampleMs = 0.0;   // Exponential moving average (0: unknown)
+    bool m_hasNewMeasurement = false;
+};
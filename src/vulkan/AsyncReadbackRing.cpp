@@ -0,0 +1,275 @@
+/**
+ * @file AsyncReadbackRing.cpp
+ * @brief Non-blocking image readback implementation
+ *
+ * @author wtflmao
+ */
+
+#include "AsyncReadbackRing.hpp"
+
+#include <QDebug>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeBits,
+                        VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProps{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProps);
+    for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) &&
+            (memProps.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+// Byte layout of each supported swapchain format as a QImage format
+QImage::Format imageFormatFor(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return QImage::Format_RGB32;  // BGRA in memory, alpha ignored
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+            return QImage::Format_RGBX8888;
+        case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+            return QImage::Format_RGB30;
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            return QImage::Format_BGR30;
+        default:
+            return QImage::Format_Invalid;
+    }
+}
+
+} // namespace
+
+AsyncReadbackRing::~AsyncReadbackRing() {
+    destroy();
+}
+
+bool AsyncReadbackRing::create(VkPhysicalDevice physicalDevice, VkDevice device,
+                               int frameSlots, QString* error) {
+    destroy();
+
+    if (frameSlots <= 0) {
+        if (error) *error = QStringLiteral("No frame slots");
+        return false;
+    }
+
+    m_physicalDevice = physicalDevice;
+    m_device = device;
+    m_slots.resize(static_cast<size_t>(frameSlots));
+    return true;
+}
+
+void AsyncReadbackRing::destroy() {
+    for (Slot& slot : m_slots) {
+        if (slot.pending) {
+            slot.pending = false;
+            if (slot.callback) {
+                std::exchange(slot.callback, nullptr)(QImage());
+            }
+        }
+        releaseBuffer(slot);
+    }
+    m_slots.clear();
+    m_pendingCount = 0;
+    m_device = VK_NULL_HANDLE;
+    m_physicalDevice = VK_NULL_HANDLE;
+}
+
+bool AsyncReadbackRing::isFormatSupported(VkFormat format) {
+    return imageFormatFor(format) != QImage::Format_Invalid;
+}
+
+bool AsyncReadbackRing::isSlotFree(int frameSlot) const {
+    return frameSlot >= 0 && frameSlot < static_cast<int>(m_slots.size())
+        && !m_slots[static_cast<size_t>(frameSlot)].pending;
+}
+
+bool AsyncReadbackRing::recordCopy(VkCommandBuffer cmd, int frameSlot, VkImage image,
+                                   VkFormat format, uint32_t width, uint32_t height,
+                                   VkImageLayout layout, Callback callback) {
+    if (!isValid() || !isSlotFree(frameSlot) || !isFormatSupported(format) ||
+        width == 0 || height == 0) {
+        return false;
+    }
+
+    Slot& slot = m_slots[static_cast<size_t>(frameSlot)];
+    if (!ensureCapacity(slot, VkDeviceSize(width) * height * 4)) {
+        return false;
+    }
+
+    VkImageMemoryBarrier toTransfer{};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransfer.oldLayout = layout;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = image;
+    toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;    // Tightly packed
+    region.bufferImageHeight = 0;
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {width, height, 1};
+    vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           slot.buffer, 1, &region);
+
+    // Back to the layout the presentation engine expects, and make the
+    // buffer visible to the host once the frame's fence signals
+    VkImageMemoryBarrier toPresent = toTransfer;
+    toPresent.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toPresent.dstAccessMask = 0;
+    toPresent.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toPresent.newLayout = layout;
+
+    VkBufferMemoryBarrier toHost{};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = slot.buffer;
+    toHost.offset = 0;
+    toHost.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 0, nullptr, 1, &toHost, 1, &toPresent);
+
+    slot.pending = true;
+    slot.format = format;
+    slot.width = width;
+    slot.height = height;
+    slot.callback = std::move(callback);
+    ++m_pendingCount;
+    return true;
+}
+
+void AsyncReadbackRing::frameSlotReady(int frameSlot) {
+    if (frameSlot < 0 || frameSlot >= static_cast<int>(m_slots.size())) {
+        return;
+    }
+    Slot& slot = m_slots[static_cast<size_t>(frameSlot)];
+    if (slot.pending) {
+        deliver(slot);
+    }
+}
+
+void AsyncReadbackRing::resolveAll() {
+    for (Slot& slot : m_slots) {
+        if (slot.pending) {
+            deliver(slot);
+        }
+    }
+}
+
+void AsyncReadbackRing::deliver(Slot& slot) {
+    slot.pending = false;
+    --m_pendingCount;
+
+    const VkDeviceSize size = VkDeviceSize(slot.width) * slot.height * 4;
+    if (!slot.coherent) {
+        VkMappedMemoryRange range{};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = slot.memory;
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+        vkInvalidateMappedMemoryRanges(m_device, 1, &range);
+    }
+
+    // Deep copy: the buffer is reused by the next capture in this slot
+    const QImage view(static_cast<const uchar*>(slot.mapped),
+                      static_cast<int>(slot.width), static_cast<int>(slot.height),
+                      static_cast<qsizetype>(size / slot.height), imageFormatFor(slot.format));
+    Callback callback = std::exchange(slot.callback, nullptr);
+    if (callback) {
+        callback(view.copy());
+    }
+}
+
+bool AsyncReadbackRing::ensureCapacity(Slot& slot, VkDeviceSize size) {
+    if (slot.buffer != VK_NULL_HANDLE && slot.capacity >= size) {
+        return true;
+    }
+    releaseBuffer(slot);
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &slot.buffer) != VK_SUCCESS) {
+        qWarning() << "AsyncReadbackRing: vkCreateBuffer failed";
+        slot.buffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryRequirements memReqs{};
+    vkGetBufferMemoryRequirements(m_device, slot.buffer, &memReqs);
+
+    // Cached memory makes the CPU copy fast; fall back to plain coherent memory
+    VkMemoryAllocateInfo memInfo{};
+    memInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memInfo.allocationSize = memReqs.size;
+    memInfo.memoryTypeIndex = findMemoryType(m_physicalDevice, memReqs.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    if (memInfo.memoryTypeIndex == UINT32_MAX) {
+        memInfo.memoryTypeIndex = findMemoryType(m_physicalDevice, memReqs.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+    if (memInfo.memoryTypeIndex == UINT32_MAX ||
+        vkAllocateMemory(m_device, &memInfo, nullptr, &slot.memory) != VK_SUCCESS) {
+        qWarning() << "AsyncReadbackRing: no host-visible memory for" << size << "bytes";
+        slot.memory = VK_NULL_HANDLE;
+        releaseBuffer(slot);
+        return false;
+    }
+
+    VkPhysicalDeviceMemoryProperties memProps{};
+    vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProps);
+    slot.coherent = (memProps.memoryTypes[memInfo.memoryTypeIndex].propertyFlags &
+                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    if (vkBindBufferMemory(m_device, slot.buffer, slot.memory, 0) != VK_SUCCESS ||
+        vkMapMemory(m_device, slot.memory, 0, VK_WHOLE_SIZE, 0, &slot.mapped) != VK_SUCCESS) {
+        qWarning() << "AsyncReadbackRing: failed to bind or map staging buffer";
+        releaseBuffer(slot);
+        return false;
+    }
+
+    slot.capacity = size;
+    return true;
+}
+
+void AsyncReadbackRing::releaseBuffer(Slot& slot) {
+    if (m_device == VK_NULL_HANDLE) {
+        return;
+    }
+    if (slot.mapped) {
+        vkUnmapMemory(m_device, slot.memory);
+        slot.mapped = nullptr;
+    }
+    if (slot.buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(m_device, slot.buffer, nullptr);
+        slot.buffer = VK_NULL_HANDLE;
+    }
+    if (slot.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(m_device, slot.memory, nullptr);
+        slot.memory = VK_NULL_HANDLE;
+    }
+    slot.capacity = 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file AsyncReadbackRing.hpp
+ * @brief Non-blocking readback of the presented image
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QString>
+#include <functional>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @class AsyncReadbackRing
+ * @brief Copies swapchain images to host memory without stalling the frame
+ *
+ * One host-visible staging buffer per concurrent frame slot. recordCopy()
+ * appends an image-to-buffer copy to the frame's own command buffer; the
+ * copy is complete once that frame slot comes around again, because
+ * QVulkanWindow waits on the slot's fence before handing it out. At that
+ * point frameSlotReady() converts the buffer and invokes the callback,
+ * typically one or two frames after the request. Nothing ever waits on
+ * the GPU.
+ *
+ * All calls happen on the render (GUI) thread.
+ */
+class AsyncReadbackRing {
+public:
+    /// Receives the captured image; a null QImage means the capture was lost
+    using Callback = std::function<void(const QImage& image)>;
+
+    AsyncReadbackRing() = default;
+    ~AsyncReadbackRing();
+
+    AsyncReadbackRing(const AsyncReadbackRing&) = delete;
+    AsyncReadbackRing& operator=(const AsyncReadbackRing&) = delete;
+
+    /**
+     * @brief Set up one (lazily sized) staging buffer per frame slot
+     */
+    bool create(VkPhysicalDevice physicalDevice, VkDevice device, int frameSlots,
+                QString* error = nullptr);
+
+    /**
+     * @brief Release all buffers; pending captures are reported as lost
+     *
+     * The device must be idle (or the slots' work known complete).
+     */
+    void destroy();
+
+    /**
+     * @brief Check whether images of this format can be read back
+     */
+    static bool isFormatSupported(VkFormat format);
+
+    /**
+     * @brief Record a copy of a presentable image into the slot's buffer
+     *
+     * Must be recorded after the image's last write in cmd. The image is
+     * returned to @p layout afterwards and needs VK_IMAGE_USAGE_TRANSFER_SRC_BIT.
+     * @return false if the slot already has a copy in flight or the format
+     *         is unsupported (the callback is not called)
+     */
+    bool recordCopy(VkCommandBuffer cmd, int frameSlot, VkImage image, VkFormat format,
+                    uint32_t width, uint32_t height, VkImageLayout layout, Callback callback);
+
+    /**
+     * @brief Deliver the slot's capture; call before recording into the slot again
+     */
+    void frameSlotReady(int frameSlot);
+
+    /**
+     * @brief Deliver every capture (only when all submitted work has completed)
+     */
+    void resolveAll();
+
+    [[nodiscard]] bool isValid() const { return m_device != VK_NULL_HANDLE; }
+    [[nodiscard]] bool hasPending() const { return m_pendingCount > 0; }
+    [[nodiscard]] bool isSlotFree(int frameSlot) const;
+
+private:
+    struct Slot {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize capacity = 0;
+        void* mapped = nullptr;
+        bool coherent = true;
+
+        // Capture in flight
+        bool pending = false;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        Callback callback;
+    };
+
+    bool ensureCapacity(Slot& slot, VkDeviceSize size);
+    void releaseBuffer(Slot& slot);
+    void deliver(Slot& slot);
+
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkDevice m_device = VK_NULL_HANDLE;
+    std::vector<Slot> m_slots;
+    int m_pendingCount = 0;
+};
@@ -0,0 +1,124 @@
+/**
+ * @file ConvergenceMonitor.cpp
+ * @brief Accumulation convergence detection
+ *
+ * @author wtflmao
+ */
+
+#include "ConvergenceMonitor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr uint32_t kFirstCheckpoint = 16;
+
+float luminance(const glm::vec4& value) {
+    return 0.2126f * value.r + 0.7152f * value.g + 0.0722f * value.b;
+}
+
+} // namespace
+
+void ConvergenceMonitor::setSettings(const ConvergenceSettings& settings) {
+    m_settings = settings;
+    m_settings.threshold = std::max(1e-5, m_settings.threshold);
+    m_settings.maxSamples = std::max(kFirstCheckpoint, m_settings.maxSamples);
+    reset();
+}
+
+void ConvergenceMonitor::reset() {
+    m_currentLuminance.clear();
+    m_sweeping = false;
+    m_sweepSamples = 0;
+    m_previousLuminance.clear();
+    m_previousSamples = 0;
+    m_nextCheckpoint = kFirstCheckpoint;
+    m_lastRelativeChange = -1.0;
+    m_converged = false;
+}
+
+bool ConvergenceMonitor::isCheckpointDue(uint32_t samples) const {
+    if (m_converged) {
+        return false;
+    }
+    if (samples >= m_settings.maxSamples) {
+        return true;
+    }
+    return m_settings.enabled && (m_sweeping || samples >= m_nextCheckpoint);
+}
+
+bool ConvergenceMonitor::checkpoint(uint32_t samples, int width, int height, const ProbeFn& probe,
+                                    int maxReads) {
+    if (!isCheckpointDue(samples) || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    if (samples >= m_settings.maxSamples) {
+        m_sweeping = false;
+        m_converged = true;
+        return true;
+    }
+
+    // Accumulation restarted mid-checkpoint: the probes read so far are stale
+    if (m_sweeping && samples < m_sweepSamples) {
+        m_sweeping = false;
+    }
+    if (!m_sweeping) {
+        m_currentLuminance.clear();
+        m_currentLuminance.reserve(kProbeColumns * kProbeRows);
+        m_sweepSamples = samples;
+        m_sweeping = true;
+    }
+
+    // Probe the centre of the next grid cells
+    const size_t total = static_cast<size_t>(kProbeColumns * kProbeRows);
+    const int reads = std::min(kReadsPerFrame, maxReads);
+    for (int i = 0; i < reads && m_currentLuminance.size() < total; ++i) {
+        const int cell = static_cast<int>(m_currentLuminance.size());
+        const int col = cell % kProbeColumns;
+        const int row = cell / kProbeColumns;
+        const int x = (2 * col + 1) * width / (2 * kProbeColumns);
+        const int y = (2 * row + 1) * height / (2 * kProbeRows);
+        glm::vec4 value(0.0f);
+        if (!probe(x, y, value)) {
+            return false;  // Resume from this probe at the next frame
+        }
+        m_currentLuminance.push_back(luminance(value));
+    }
+
+    if (m_currentLuminance.size() < total) {
+        return false;
+    }
+    m_sweeping = false;
+    return evaluate(m_sweepSamples);
+}
+
+bool ConvergenceMonitor::evaluate(uint32_t samples) {
+    const std::vector<float>& current = m_currentLuminance;
+
+    bool converged = false;
+    if (m_previousLuminance.size() == current.size()) {
+        // Floor the denominator so near-black pixels do not dominate
+        double meanLuminance = 0.0;
+        for (float y : current) {
+            meanLuminance += std::abs(y);
+        }
+        meanLuminance /= static_cast<double>(current.size());
+        const double floor = std::max(1e-4, 0.05 * meanLuminance);
+
+        double change = 0.0;
+        for (size_t i = 0; i < current.size(); ++i) {
+            const double denom = std::max<double>(floor, std::abs(current[i]));
+            change += std::abs(current[i] - m_previousLuminance[i]) / denom;
+        }
+        m_lastRelativeChange = change / static_cast<double>(current.size());
+        converged = m_lastRelativeChange < m_settings.threshold;
+    }
+
+    m_previousLuminance.swap(m_currentLuminance);
+    m_previousSamples = samples;
+    m_nextCheckpoint = std::min(std::max(samples, m_nextCheckpoint) * 2, m_settings.maxSamples);
+    m_converged = converged;
+    return converged;
+}
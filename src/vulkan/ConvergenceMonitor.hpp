@@ -0,0 +1,90 @@
+/**
+ * @file ConvergenceMonitor.hpp
+ * @brief Detects when progressive accumulation has converged
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @struct ConvergenceSettings
+ * @brief When the viewport may stop accumulating
+ */
+struct ConvergenceSettings {
+    bool enabled = false;          // Noise-based auto-stop
+    double threshold = 0.01;       // Mean relative luminance change between checkpoints
+    uint32_t maxSamples = 4096;    // Stop here even if still noisy (also without auto-stop)
+};
+
+/**
+ * @class ConvergenceMonitor
+ * @brief Estimates remaining noise from a sparse grid of probe pixels
+ *
+ * At checkpoints (16, 32, 64, ... accumulated samples) the accumulated
+ * value of each probe is read back. Each read is a synchronous round trip,
+ * so a checkpoint reads at most kReadsPerFrame probes per frame (fewer when
+ * the renderer's shared read budget is lower) and is
+ * evaluated once the whole grid is in (accumulation moves on by a few
+ * frames meanwhile, which is small next to the doubling between
+ * checkpoints). The mean relative luminance change since the previous
+ * checkpoint tracks Monte Carlo error, which halves only every 4x samples;
+ * once it drops below the threshold (or the sample cap is reached) the
+ * image counts as converged. The sample cap applies even with auto-stop
+ * disabled, so an untouched viewport always goes idle eventually. reset() starts over whenever accumulation
+ * restarts.
+ */
+class ConvergenceMonitor {
+public:
+    /// Reads the accumulated value at a viewport pixel; false on failure
+    using ProbeFn = std::function<bool(int x, int y, glm::vec4& value)>;
+
+    static constexpr int kProbeColumns = 12;
+    static constexpr int kProbeRows = 8;
+    static constexpr int kReadsPerFrame = 16;
+
+    void setSettings(const ConvergenceSettings& settings);
+    [[nodiscard]] const ConvergenceSettings& settings() const { return m_settings; }
+
+    /**
+     * @brief Forget all checkpoints (accumulation restarted)
+     */
+    void reset();
+
+    /**
+     * @brief Check whether a checkpoint should be taken (or continued) at this sample count
+     */
+    [[nodiscard]] bool isCheckpointDue(uint32_t samples) const;
+
+    /**
+     * @brief Do this frame's probe reads; evaluate once the grid is complete
+     * @param maxReads Reads left in this frame's budget (capped at kReadsPerFrame)
+     * @return true if this checkpoint declared the image converged
+     */
+    bool checkpoint(uint32_t samples, int width, int height, const ProbeFn& probe,
+                    int maxReads = kReadsPerFrame);
+
+    [[nodiscard]] bool isConverged() const { return m_converged; }
+    [[nodiscard]] double lastRelativeChange() const { return m_lastRelativeChange; }
+
+private:
+    bool evaluate(uint32_t samples);
+
+    ConvergenceSettings m_settings;
+
+    // Checkpoint in progress
+    std::vector<float> m_currentLuminance;    // Probes read so far, row-major
+    bool m_sweeping = false;
+    uint32_t m_sweepSamples = 0;              // Samples when the checkpoint started
+
+    std::vector<float> m_previousLuminance;   // One entry per probe (last checkpoint)
+    uint32_t m_previousSamples = 0;
+    uint32_t m_nextCheckpoint = 16;
+    double m_lastRelativeChange = -1.0;       // Negative: not measured yet
+    bool m_converged = false;
+};
@@ -0,0 +1,351 @@
+/**
+ * @file FinalRenderJob.cpp
+ * @brief Offline final render implementation
+ *
+ * @author wtflmao
+ */
+
+#include "FinalRenderJob.hpp"
+#include "SceneLoader.hpp"
+
+#include <scene/Scene.hpp>
+#include <core/Image.hpp>
+#include <io/ImageIO.hpp>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QTimer>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// Time slice per timer tick: long on a worker (only pause/cancel compete),
+// short on the GUI thread so input and preview stay responsive
+constexpr int kWorkerSliceMs = 100;
+constexpr int kSharedSliceMs = 8;
+
+constexpr int kProgressIntervalMs = 100;
+
+// Abort if this many frames in a row add no samples
+constexpr int kMaxStalledFrames = 64;
+
+} // namespace
+
+FinalRenderJob::FinalRenderJob(FinalRenderSettings settings,
+                               quantiloom::ExternalRenderContext::InitParams params,
+                               bool sharedQueue, QObject* parent)
+    : QObject(parent)
+    , m_settings(std::move(settings))
+    , m_params(params)
+    , m_sharedQueue(sharedQueue)
+{
+    m_params.width = static_cast<quantiloom::u32>(m_settings.width);
+    m_params.height = static_cast<quantiloom::u32>(m_settings.height);
+
+    // Child object: follows the job into its thread
+    m_sliceTimer = new QTimer(this);
+    m_sliceTimer->setInterval(0);
+    connect(m_sliceTimer, &QTimer::timeout, this, &FinalRenderJob::renderSlice);
+}
+
+FinalRenderJob::~FinalRenderJob() {
+    releaseResources();
+}
+
+// ============================================================================
+// Control (any thread)
+// ============================================================================
+
+void FinalRenderJob::start() {
+    QMetaObject::invokeMethod(this, [this]() {
+        if (m_done || m_context) {
+            return;
+        }
+
+        QString error;
+        if (!prepare(&error)) {
+            finish(false, error);
+            return;
+        }
+        if (m_canceled.load()) {
+            finish(false, tr("Final render canceled"));
+            return;
+        }
+
+        emit statusChanged(tr("Rendering %1x%2 @ %3 SPP...")
+            .arg(m_settings.width).arg(m_settings.height).arg(m_settings.targetSpp));
+        m_renderTimer.start();
+        m_progressTimer.start();
+        reportProgress(true);
+        if (!m_paused.load()) {
+            m_sliceTimer->start();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void FinalRenderJob::pause() {
+    if (m_paused.exchange(true)) {
+        return;
+    }
+    QMetaObject::invokeMethod(this, [this]() {
+        if (m_done || !m_paused.load()) {
+            return;
+        }
+        if (m_sliceTimer->isActive()) {
+            m_sliceTimer->stop();
+            m_renderNsecs += m_renderTimer.nsecsElapsed();
+        }
+        emit pausedChanged(true);
+    }, Qt::QueuedConnection);
+}
+
+void FinalRenderJob::resume() {
+    if (!m_paused.exchange(false)) {
+        return;
+    }
+    QMetaObject::invokeMethod(this, [this]() {
+        if (m_done || m_paused.load()) {
+            return;
+        }
+        if (m_context && !m_sliceTimer->isActive()) {
+            m_renderTimer.restart();
+            m_stalledFrames = 0;
+            m_sliceTimer->start();
+        }
+        emit pausedChanged(false);
+    }, Qt::QueuedConnection);
+}
+
+void FinalRenderJob::cancel() {
+    m_canceled.store(true);
+    if (QThread::currentThread() == thread()) {
+        if (!m_done) {
+            finish(false, tr("Final render canceled"));
+        }
+        return;
+    }
+    QMetaObject::invokeMethod(this, [this]() {
+        if (!m_done) {
+            finish(false, tr("Final render canceled"));
+        }
+    }, Qt::QueuedConnection);
+}
+
+// ============================================================================
+// Job Thread
+// ============================================================================
+
+bool FinalRenderJob::prepare(QString* error) {
+    if (m_settings.width == 0 || m_settings.height == 0 || m_settings.targetSpp == 0) {
+        *error = tr("Invalid final render settings (%1x%2 @ %3 SPP)")
+            .arg(m_settings.width).arg(m_settings.height).arg(m_settings.targetSpp);
+        return false;
+    }
+
+    emit statusChanged(tr("Preparing final render..."));
+
+    auto created = quantiloom::ExternalRenderContext::Create(m_params);
+    if (!created) {
+        *error = tr("Failed to create render context: %1")
+            .arg(QString::fromStdString(created.error()));
+        return false;
+    }
+    m_context = std::move(created.value());
+
+    emit statusChanged(tr("Loading scene for final render..."));
+
+    const std::string path = m_settings.scenePath.toStdString();
+    quantiloom::Result<void, quantiloom::String> loadResult;
+    if (isUsdScenePath(m_settings.scenePath)) {
+        loadResult = m_context->LoadSceneFromUsd(path);
+    } else {
+        loadResult = m_context->LoadSceneFromGltf(path);
+    }
+    if (!loadResult) {
+        *error = tr("Failed to load scene: %1").arg(QString::fromStdString(loadResult.error()));
+        return false;
+    }
+
+    if (!m_settings.environmentMapPath.isEmpty()) {
+        auto envResult = m_context->LoadEnvironmentMap(m_settings.environmentMapPath.toStdString());
+        if (!envResult.has_value()) {
+            *error = tr("Failed to load environment map: %1")
+                .arg(QString::fromStdString(envResult.error()));
+            return false;
+        }
+    }
+
+    if (!m_frameRunner.create(m_params.physicalDevice, m_params.device, m_params.graphicsQueue,
+                              static_cast<uint32_t>(m_params.graphicsQueueFamily),
+                              m_params.targetColorFormat, m_settings.width, m_settings.height,
+                              error)) {
+        return false;
+    }
+
+    applySettings();
+    return true;
+}
+
+void FinalRenderJob::applySettings() {
+    if (m_settings.hasLightingParams) {
+        m_context->SetLightingParams(m_settings.lighting);
+    }
+    m_context->SetSpectralMode(m_settings.spectralMode);
+    m_context->SetSPP(std::clamp(m_settings.frameSpp, 1u, m_settings.targetSpp));
+    m_context->SetWavelength(m_settings.wavelength);
+    m_context->SetAtmosphericConfig(m_settings.atmosphericConfig);
+    m_context->SetCameraLookAt(m_settings.cameraPosition, m_settings.cameraTarget,
+                               m_settings.cameraUp);
+    m_context->SetCameraFOV(m_settings.cameraFovY);
+
+    if (const auto* scene = m_context->GetScene()) {
+        const size_t materialCount = std::min(scene->materials.size(), m_settings.materials.size());
+        for (size_t i = 0; i < materialCount; ++i) {
+            m_context->UpdateMaterial(static_cast<quantiloom::u32>(i), m_settings.materials[i]);
+        }
+
+        bool transformsChanged = false;
+        const size_t nodeCount = std::min(scene->nodes.size(), m_settings.nodeTransforms.size());
+        for (size_t i = 0; i < nodeCount; ++i) {
+            if (scene->nodes[i].transform != m_settings.nodeTransforms[i]) {
+                m_context->SetNodeTransform(static_cast<quantiloom::u32>(i),
+                                            m_settings.nodeTransforms[i]);
+                transformsChanged = true;
+            }
+        }
+        if (transformsChanged) {
+            m_context->RebuildAccelerationStructure();
+        }
+    }
+
+    m_context->ResetAccumulation();
+    m_lastSamples = m_context->GetAccumulatedSamples();
+}
+
+void FinalRenderJob::renderSlice() {
+    if (m_done || !m_context) {
+        m_sliceTimer->stop();
+        return;
+    }
+
+    const auto record = [this](VkCommandBuffer cmd, VkImage target, uint32_t width, uint32_t height) {
+        m_context->RenderFrame(cmd, target, VK_IMAGE_LAYOUT_UNDEFINED,
+                               static_cast<quantiloom::u32>(width),
+                               static_cast<quantiloom::u32>(height));
+    };
+
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
+    const int budgetMs = m_sharedQueue ? kSharedSliceMs : kWorkerSliceMs;
+
+    while (sliceTimer.elapsed() < budgetMs) {
+        if (m_canceled.load() || m_paused.load()) {
+            return;  // Queued cancel()/pause() handler takes over
+        }
+
+        uint32_t samples = m_context->GetAccumulatedSamples();
+        if (samples >= m_settings.targetSpp) {
+            complete();
+            return;
+        }
+
+        // On the GUI thread never wait for a ring slot; yield to the event loop
+        if (m_sharedQueue && !m_frameRunner.canSubmit()) {
+            break;
+        }
+
+        if (!m_frameRunner.submitFrame(record)) {
+            finish(false, tr("Frame submission failed"));
+            return;
+        }
+
+        samples = m_context->GetAccumulatedSamples();
+        if (samples == m_lastSamples) {
+            if (++m_stalledFrames >= kMaxStalledFrames) {
+                finish(false, tr("Accumulation stalled at %1/%2 samples")
+                    .arg(samples).arg(m_settings.targetSpp));
+                return;
+            }
+        } else {
+            m_stalledFrames = 0;
+            m_lastSamples = samples;
+        }
+    }
+
+    reportProgress(false);
+}
+
+void FinalRenderJob::complete() {
+    m_sliceTimer->stop();
+    m_renderNsecs += m_renderTimer.nsecsElapsed();
+    reportProgress(true);
+
+    emit statusChanged(tr("Writing %1...").arg(QFileInfo(m_settings.outputPath).fileName()));
+
+    // Capture reads the accumulation buffer; all frames must have landed
+    if (!m_frameRunner.waitIdle()) {
+        finish(false, tr("Waiting for GPU completion failed"));
+        return;
+    }
+
+    auto capture = m_context->CaptureScreenshot();
+    if (!capture.has_value()) {
+        finish(false, tr("Capture failed: %1").arg(QString::fromStdString(capture.error())));
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(m_settings.outputPath).absolutePath());
+    if (!quantiloom::ImageIO::WriteEXR(m_settings.outputPath.toStdString(), capture.value())) {
+        finish(false, tr("Failed to write %1").arg(m_settings.outputPath));
+        return;
+    }
+
+    const double seconds = m_renderNsecs / 1e9;
+    finish(true, tr("Final render saved: %1 (%2 SPP in %3 s)")
+        .arg(m_settings.outputPath)
+        .arg(m_context->GetAccumulatedSamples())
+        .arg(seconds, 0, 'f', 1));
+}
+
+void FinalRenderJob::finish(bool success, const QString& message) {
+    if (m_done) {
+        return;
+    }
+    m_done = true;
+    m_sliceTimer->stop();
+
+    if (success) {
+        qDebug() << "FinalRenderJob:" << message;
+    } else {
+        qWarning() << "FinalRenderJob:" << message;
+    }
+
+    // Release GPU resources on the thread that used them
+    releaseResources();
+    emit finished(success, message);
+}
+
+void FinalRenderJob::releaseResources() {
+    if (m_frameRunner.isValid()) {
+        m_frameRunner.waitIdle();
+    }
+    m_context.reset();
+    m_frameRunner.destroy();
+}
+
+void FinalRenderJob::reportProgress(bool force) {
+    if (!force && m_progressTimer.elapsed() < kProgressIntervalMs) {
+        return;
+    }
+    m_progressTimer.restart();
+
+    const uint32_t samples = m_context ? m_context->GetAccumulatedSamples() : 0;
+    qint64 nsecs = m_renderNsecs;
+    if (m_sliceTimer->isActive()) {
+        nsecs += m_renderTimer.nsecsElapsed();
+    }
+    const double samplesPerSecond = nsecs > 0 ? samples / (nsecs / 1e9) : 0.0;
+    emit progressChanged(samples, m_settings.targetSpp, samplesPerSecond);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file FinalRenderJob.hpp
+ * @brief Offline final render at a fixed resolution and sample count
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include "OffscreenFrameRunner.hpp"
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <core/Types.hpp>
+#include <renderer/ExternalRenderContext.hpp>
+#include <renderer/LightingParams.hpp>
+#include <renderer/AtmosphericConfig.hpp>
+#include <scene/Material.hpp>
+
+class QTimer;
+
+/**
+ * @struct FinalRenderSettings
+ * @brief Snapshot of everything a final render needs
+ *
+ * Taken from the interactive renderer when the job starts; later edits in
+ * the viewport do not affect a running job.
+ */
+struct FinalRenderSettings {
+    QString scenePath;
+    QString environmentMapPath;   // Empty: none
+    QString outputPath;           // EXR written on completion
+
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    uint32_t targetSpp = 256;
+    uint32_t frameSpp = 4;        // Samples per RenderFrame call (SetSPP)
+
+    // Render state
+    quantiloom::SpectralMode spectralMode = quantiloom::SpectralMode::RGB;
+    float wavelength = 550.0f;
+    quantiloom::LightingParams lighting = quantiloom::CreateDefaultLightingParams();
+    bool hasLightingParams = false;
+    quantiloom::AtmosphericConfig atmosphericConfig;
+
+    // Camera
+    glm::vec3 cameraPosition{0.0f, 1.0f, 5.0f};
+    glm::vec3 cameraTarget{0.0f, 0.0f, 0.0f};
+    glm::vec3 cameraUp{0.0f, 1.0f, 0.0f};
+    float cameraFovY = 45.0f;
+
+    // Scene edits made since load (indexed like Scene::materials / Scene::nodes)
+    std::vector<quantiloom::Material> materials;
+    std::vector<glm::mat4> nodeTransforms;
+};
+
+/**
+ * @class FinalRenderJob
+ * @brief Accumulates a scene offscreen until the target SPP, then writes EXR
+ *
+ * Builds its own ExternalRenderContext on the given queue and renders into
+ * an OffscreenFrameRunner target, so resolution is independent of the
+ * swapchain and frames are not paced by presentation.
+ *
+ * The job is event driven: start() prepares the context, then a zero-interval
+ * timer renders progressive passes in time slices. It can live on a worker
+ * thread (dedicated queue, slices run back to back) or on the GUI thread
+ * (queue shared with the preview, slices are short and never block on the GPU).
+ * pause(), resume() and cancel() may be called from any thread; cancel()
+ * on the job's own thread stops and releases the context immediately.
+ */
+class FinalRenderJob : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @param settings Scene, output and render state snapshot
+     * @param params Device handles; graphicsQueue must only be used from the
+     *               thread the job runs on
+     * @param sharedQueue true if the queue is also used by the preview
+     */
+    FinalRenderJob(FinalRenderSettings settings,
+                   quantiloom::ExternalRenderContext::InitParams params,
+                   bool sharedQueue, QObject* parent = nullptr);
+    ~FinalRenderJob() override;
+
+    void start();
+    void pause();
+    void resume();
+    void cancel();
+
+    bool isPaused() const { return m_paused.load(); }
+    const FinalRenderSettings& settings() const { return m_settings; }
+
+signals:
+    void statusChanged(const QString& status);
+    void progressChanged(uint32_t samples, uint32_t targetSpp, double samplesPerSecond);
+    void pausedChanged(bool paused);
+    void finished(bool success, const QString& message);
+
+private:
+    bool prepare(QString* error);
+    void applySettings();
+    void renderSlice();
+    void complete();
+    void finish(bool success, const QString& message);
+    void releaseResources();
+    void reportProgress(bool force);
+
+    FinalRenderSettings m_settings;
+    quantiloom::ExternalRenderContext::InitParams m_params;
+    bool m_sharedQueue = false;
+
+    std::unique_ptr<quantiloom::ExternalRenderContext> m_context;
+    OffscreenFrameRunner m_frameRunner;
+    QTimer* m_sliceTimer = nullptr;
+
+    std::atomic_bool m_canceled{false};
+    std::atomic_bool m_paused{false};
+    bool m_done = false;
+
+    // Progress / stall tracking
+    QElapsedTimer m_renderTimer;     // Excludes paused time
+    qint64 m_renderNsecs = 0;
+    QElapsedTimer m_progressTimer;
+    uint32_t m_lastSamples = 0;
+    int m_stalledFrames = 0;
+};
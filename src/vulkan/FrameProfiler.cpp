@@ -0,0 +1,347 @@
+/**
+ * @file FrameProfiler.cpp
+ * @brief Frame timing collection and export
+ *
+ * @author wtflmao
+ */
+
+#include "FrameProfiler.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+double elapsedMs(FrameProfiler::Clock::time_point start, FrameProfiler::Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Nearest-rank percentile of a sorted, non-empty range
+double percentile(const std::vector<double>& sorted, double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void setError(QString* error, const QString& message) {
+    if (error) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+const char* frameMetricKey(FrameMetric metric) {
+    switch (metric) {
+        case FrameMetric::Interval:        return "interval_ms";
+        case FrameMetric::CpuFrame:        return "cpu_frame_ms";
+        case FrameMetric::CameraUpdate:    return "camera_update_ms";
+        case FrameMetric::NodeTransforms:  return "node_transforms_ms";
+        case FrameMetric::ParameterUpload: return "parameter_upload_ms";
+        case FrameMetric::RecordFrame:     return "record_frame_ms";
+        case FrameMetric::GpuFrame:        return "gpu_frame_ms";
+        case FrameMetric::Count:           break;
+    }
+    return "unknown";
+}
+
+FrameProfiler::~FrameProfiler() {
+    destroyGpuTimer();
+}
+
+// ============================================================================
+// GPU Timer
+// ============================================================================
+
+void FrameProfiler::createGpuTimer(VkPhysicalDevice physicalDevice, VkDevice device,
+                                   uint32_t queueFamily, int frameSlots) {
+    destroyGpuTimer();
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    const uint32_t validBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+    if (validBits == 0 || frameSlots <= 0) {
+        qWarning() << "FrameProfiler: queue family has no timestamp support, GPU timing disabled";
+        return;
+    }
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    m_timestampPeriodNs = props.limits.timestampPeriod;
+    m_timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = static_cast<uint32_t>(frameSlots) * 2;
+    if (vkCreateQueryPool(device, &poolInfo, nullptr, &m_queryPool) != VK_SUCCESS) {
+        qWarning() << "FrameProfiler: vkCreateQueryPool failed, GPU timing disabled";
+        m_queryPool = VK_NULL_HANDLE;
+        return;
+    }
+
+    m_device = device;
+    m_slotFrame.assign(static_cast<size_t>(frameSlots), 0);
+}
+
+void FrameProfiler::destroyGpuTimer() {
+    if (m_queryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(m_device, m_queryPool, nullptr);
+    }
+    m_queryPool = VK_NULL_HANDLE;
+    m_device = VK_NULL_HANDLE;
+    m_slotFrame.clear();
+    m_gpuSpanOpen = false;
+}
+
+void FrameProfiler::writeGpuBegin(VkCommandBuffer cmd, int frameSlot) {
+    if (!hasGpuTimer() || frameSlot < 0 || frameSlot >= static_cast<int>(m_slotFrame.size())) {
+        return;
+    }
+
+    // Qt waited on this slot's fence before starting the frame
+    resolveGpuSlot(frameSlot);
+
+    const uint32_t first = static_cast<uint32_t>(frameSlot) * 2;
+    vkCmdResetQueryPool(cmd, m_queryPool, first, 2);
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPool, first);
+    m_gpuSpanOpen = true;
+}
+
+void FrameProfiler::writeGpuEnd(VkCommandBuffer cmd, int frameSlot) {
+    if (!m_gpuSpanOpen) {
+        return;
+    }
+    m_gpuSpanOpen = false;
+
+    const uint32_t first = static_cast<uint32_t>(frameSlot) * 2;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPool, first + 1);
+    m_slotFrame[static_cast<size_t>(frameSlot)] = m_current.frame;
+}
+
+void FrameProfiler::resolveGpuSlot(int frameSlot) {
+    quint64& frame = m_slotFrame[static_cast<size_t>(frameSlot)];
+    if (frame == 0) {
+        return;
+    }
+    const quint64 resolvedFrame = std::exchange(frame, 0);
+
+    uint64_t timestamps[2] = {};
+    const VkResult result = vkGetQueryPoolResults(
+        m_device, m_queryPool, static_cast<uint32_t>(frameSlot) * 2, 2,
+        sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) {
+        return;  // VK_NOT_READY: frame was dropped (e.g. swapchain recreated)
+    }
+
+    const uint64_t ticks = (timestamps[1] - timestamps[0]) & m_timestampMask;
+    const double gpuMs = static_cast<double>(ticks) * m_timestampPeriodNs / 1e6;
+
+    // Newest frames are at the back
+    for (auto it = m_history.rbegin(); it != m_history.rend(); ++it) {
+        if (it->frame == resolvedFrame) {
+            it->ms[static_cast<size_t>(FrameMetric::GpuFrame)] = gpuMs;
+            m_latestGpuMs = gpuMs;
+            m_latestGpuSpp = it->spp;
+            m_latestGpuFresh = true;
+            break;
+        }
+        if (it->frame < resolvedFrame) {
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// CPU Spans
+// ============================================================================
+
+void FrameProfiler::beginFrame() {
+    m_current = FrameTimingSample();
+    m_current.frame = ++m_frameCounter;
+    m_frameStart = Clock::now();
+}
+
+void FrameProfiler::recordSpan(FrameMetric metric, Clock::time_point start) {
+    m_current.ms[static_cast<size_t>(metric)] = elapsedMs(start, Clock::now());
+}
+
+bool FrameProfiler::takeLatestGpuFrame(double& gpuMs, uint32_t& spp) {
+    if (!m_latestGpuFresh) {
+        return false;
+    }
+    m_latestGpuFresh = false;
+    gpuMs = m_latestGpuMs;
+    spp = m_latestGpuSpp;
+    return true;
+}
+
+void FrameProfiler::endFrame(uint32_t samples, uint32_t spp) {
+    const Clock::time_point now = Clock::now();
+    m_current.samples = samples;
+    m_current.spp = spp;
+    m_current.ms[static_cast<size_t>(FrameMetric::CpuFrame)] = elapsedMs(m_frameStart, now);
+    if (m_hasLastFrameEnd) {
+        m_lastIntervalMs = elapsedMs(m_lastFrameEnd, now);
+        m_current.ms[static_cast<size_t>(FrameMetric::Interval)] = m_lastIntervalMs;
+    }
+    m_lastFrameEnd = now;
+    m_hasLastFrameEnd = true;
+
+    m_history.push_back(m_current);
+    while (m_history.size() > static_cast<size_t>(kHistorySize)) {
+        m_history.pop_front();
+    }
+}
+
+void FrameProfiler::reset() {
+    m_history.clear();
+    m_latestGpuFresh = false;
+    m_hasLastFrameEnd = false;
+    m_lastIntervalMs = 0.0;
+}
+
+// ============================================================================
+// Statistics / Export
+// ============================================================================
+
+FrameTimingSummary FrameProfiler::summary() const {
+    FrameTimingSummary summary;
+    summary.frameCount = static_cast<int>(m_history.size());
+    summary.gpuTimingAvailable = hasGpuTimer();
+
+    std::vector<double> values;
+    values.reserve(m_history.size());
+    for (int m = 0; m < kFrameMetricCount; ++m) {
+        values.clear();
+        for (const auto& sample : m_history) {
+            if (sample.ms[static_cast<size_t>(m)] >= 0.0) {
+                values.push_back(sample.ms[static_cast<size_t>(m)]);
+            }
+        }
+        if (values.empty()) {
+            continue;
+        }
+        std::sort(values.begin(), values.end());
+
+        FrameMetricStats& stats = summary.metrics[static_cast<size_t>(m)];
+        stats.count = static_cast<int>(values.size());
+        double sum = 0.0;
+        for (double v : values) {
+            sum += v;
+        }
+        stats.mean = sum / static_cast<double>(values.size());
+        stats.p50 = percentile(values, 0.50);
+        stats.p95 = percentile(values, 0.95);
+        stats.p99 = percentile(values, 0.99);
+        stats.max = values.back();
+    }
+    return summary;
+}
+
+bool FrameProfiler::exportToFile(const QString& path, QString* error) const {
+    if (path.isEmpty()) {
+        setError(error, QStringLiteral("Empty output path"));
+        return false;
+    }
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    if (QFileInfo(path).suffix().compare(QLatin1String("json"), Qt::CaseInsensitive) == 0) {
+        return writeJson(path, error);
+    }
+    return writeCsv(path, error);
+}
+
+bool FrameProfiler::writeCsv(const QString& path, QString* error) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        setError(error, file.errorString());
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "frame,samples,spp";
+    for (int m = 0; m < kFrameMetricCount; ++m) {
+        out << ',' << frameMetricKey(static_cast<FrameMetric>(m));
+    }
+    out << '\n';
+
+    for (const auto& sample : m_history) {
+        out << sample.frame << ',' << sample.samples << ',' << sample.spp;
+        for (double v : sample.ms) {
+            out << ',';
+            if (v >= 0.0) {
+                out << QString::number(v, 'f', 4);
+            }
+        }
+        out << '\n';
+    }
+
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        setError(error, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool FrameProfiler::writeJson(const QString& path, QString* error) const {
+    const FrameTimingSummary stats = summary();
+
+    QJsonObject summaryJson;
+    for (int m = 0; m < kFrameMetricCount; ++m) {
+        const FrameMetricStats& s = stats.metrics[static_cast<size_t>(m)];
+        QJsonObject metric;
+        metric["count"] = s.count;
+        metric["mean"] = s.mean;
+        metric["p50"] = s.p50;
+        metric["p95"] = s.p95;
+        metric["p99"] = s.p99;
+        metric["max"] = s.max;
+        summaryJson[frameMetricKey(static_cast<FrameMetric>(m))] = metric;
+    }
+
+    QJsonArray frames;
+    for (const auto& sample : m_history) {
+        QJsonObject frame;
+        frame["frame"] = static_cast<qint64>(sample.frame);
+        frame["samples"] = static_cast<qint64>(sample.samples);
+        frame["spp"] = static_cast<qint64>(sample.spp);
+        for (int m = 0; m < kFrameMetricCount; ++m) {
+            const double v = sample.ms[static_cast<size_t>(m)];
+            if (v >= 0.0) {
+                frame[frameMetricKey(static_cast<FrameMetric>(m))] = v;
+            }
+        }
+        frames.append(frame);
+    }
+
+    QJsonObject root;
+    root["generated"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["frame_count"] = stats.frameCount;
+    root["gpu_timing"] = stats.gpuTimingAvailable;
+    root["summary"] = summaryJson;
+    root["frames"] = frames;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        setError(error, file.errorString());
+        return false;
+    }
+    if (file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) < 0) {
+        setError(error, file.errorString());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file FrameProfiler.hpp
+ * @brief Per-frame CPU spans, GPU timestamps and rolling percentiles
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QString>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @enum FrameMetric
+ * @brief Timings recorded for every rendered viewport frame
+ */
+enum class FrameMetric {
+    Interval,         // Wall time since the previous rendered frame (what FPS is based on)
+    CpuFrame,         // startNextFrame() from entry to frameReady()
+    CameraUpdate,     // Keyboard camera movement
+    NodeTransforms,   // Batched transforms + acceleration structure rebuild
+    ParameterUpload,  // Coalesced parameter changes applied to the context
+    RecordFrame,      // RenderFrame() command recording
+    GpuFrame,         // GPU execution of RenderFrame() (trace, CLAHE, blit)
+    Count
+};
+
+constexpr int kFrameMetricCount = static_cast<int>(FrameMetric::Count);
+
+/**
+ * @brief Stable identifier of a metric (CSV/JSON keys)
+ */
+const char* frameMetricKey(FrameMetric metric);
+
+/**
+ * @struct FrameTimingSample
+ * @brief Timings of one frame in milliseconds (negative: not measured)
+ */
+struct FrameTimingSample {
+    quint64 frame = 0;
+    uint32_t samples = 0;   // Accumulated samples after the frame
+    uint32_t spp = 0;       // Samples per pixel rendered in this frame
+    std::array<double, kFrameMetricCount> ms{};
+
+    FrameTimingSample() { ms.fill(-1.0); }
+};
+
+/**
+ * @struct FrameMetricStats
+ * @brief Distribution of one metric over the history window
+ */
+struct FrameMetricStats {
+    int count = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @struct FrameTimingSummary
+ * @brief Rolling statistics for all metrics
+ */
+struct FrameTimingSummary {
+    std::array<FrameMetricStats, kFrameMetricCount> metrics{};
+    int frameCount = 0;
+    bool gpuTimingAvailable = false;
+
+    const FrameMetricStats& operator[](FrameMetric metric) const {
+        return metrics[static_cast<size_t>(metric)];
+    }
+};
+
+/**
+ * @class FrameProfiler
+ * @brief Collects frame timings for the interactive viewport
+ *
+ * CPU spans are measured with a steady clock. GPU time comes from a pair of
+ * timestamp queries per frame-in-flight slot written around RenderFrame();
+ * a slot's result is read back when Qt hands the slot out again, by which
+ * point its fence has signalled, so readback never stalls. GPU timings
+ * therefore arrive a few frames late and are patched into the history.
+ *
+ * RenderFrame() records tracing, CLAHE and the swapchain blit as one call,
+ * so they share a single GPU span.
+ */
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int kHistorySize = 600;
+
+    FrameProfiler() = default;
+    ~FrameProfiler();
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    /**
+     * @brief Create the timestamp query pool
+     *
+     * Does nothing (GPU metric stays unmeasured) if the queue family has no
+     * timestamp support.
+     * @param frameSlots Number of frames in flight
+     */
+    void createGpuTimer(VkPhysicalDevice physicalDevice, VkDevice device,
+                        uint32_t queueFamily, int frameSlots);
+    void destroyGpuTimer();
+    [[nodiscard]] bool hasGpuTimer() const { return m_queryPool != VK_NULL_HANDLE; }
+
+    // Per-frame recording (GUI thread, inside startNextFrame)
+    void beginFrame();
+    void recordSpan(FrameMetric metric, Clock::time_point start);
+    void writeGpuBegin(VkCommandBuffer cmd, int frameSlot);
+    void writeGpuEnd(VkCommandBuffer cmd, int frameSlot);
+    void endFrame(uint32_t samples, uint32_t spp);
+
+    /**
+     * @brief Measure a scope as one CPU span
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, FrameMetric metric)
+            : m_profiler(profiler), m_metric(metric), m_start(Clock::now()) {}
+        ~Scope() { m_profiler.recordSpan(m_metric, m_start); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameProfiler& m_profiler;
+        FrameMetric m_metric;
+        Clock::time_point m_start;
+    };
+
+    [[nodiscard]] double lastIntervalMs() const { return m_lastIntervalMs; }
+
+    /**
+     * @brief Fetch the GPU time resolved since the last call
+     * @param gpuMs Receives the frame's GPU time
+     * @param spp Receives the SPP that frame was rendered with
+     * @return false if no new GPU timing arrived
+     */
+    bool takeLatestGpuFrame(double& gpuMs, uint32_t& spp);
+
+    /**
+     * @brief Mean and p50/p95/p99/max per metric over the history
+     */
+    [[nodiscard]] FrameTimingSummary summary() const;
+
+    /**
+     * @brief Drop the history (e.g. after changing settings to compare)
+     */
+    void reset();
+
+    /**
+     * @brief Write the history as CSV (one row per frame) or JSON (summary + frames)
+     *
+     * The format follows the file extension (.json, anything else is CSV).
+     */
+    bool exportToFile(const QString& path, QString* error) const;
+
+private:
+    void resolveGpuSlot(int frameSlot);
+    bool writeCsv(const QString& path, QString* error) const;
+    bool writeJson(const QString& path, QString* error) const;
+
+    // History (oldest first)
+    std::deque<FrameTimingSample> m_history;
+    FrameTimingSample m_current;
+    quint64 m_frameCounter = 0;
+    Clock::time_point m_frameStart;
+    Clock::time_point m_lastFrameEnd;
+    bool m_hasLastFrameEnd = false;
+    double m_lastIntervalMs = 0.0;
+
+    // GPU timestamps: queries [2*slot, 2*slot+1] per frame slot
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueryPool m_queryPool = VK_NULL_HANDLE;
+    double m_timestampPeriodNs = 1.0;
+    uint64_t m_timestampMask = ~0ull;
+    std::vector<quint64> m_slotFrame;   // Frame whose timestamps a slot holds (0: none)
+    bool m_gpuSpanOpen = false;
+
+    // Most recently resolved GPU frame (consumed by takeLatestGpuFrame)
+    double m_latestGpuMs = 0.0;
+    uint32_t m_latestGpuSpp = 0;
+    bool m_latestGpuFresh = false;
+};
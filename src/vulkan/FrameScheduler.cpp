@@ -0,0 +1,62 @@
+/**
+ * @file FrameScheduler.cpp
+ * @brief Event-driven frame scheduling implementation
+ *
+ * @author wtflmao
+ */
+
+#include "FrameScheduler.hpp"
+
+#include <QTimer>
+
+void FrameScheduler::request(FrameWakeReason reason) {
+    wake(reason);
+    if (m_window) {
+        m_window->requestUpdate();  // Qt merges repeated requests into one frame
+    }
+}
+
+void FrameScheduler::requestDelayed(FrameWakeReason reason, int delayMs) {
+    wake(reason);
+    if (m_window) {
+        QTimer::singleShot(delayMs, m_window, [window = m_window]() {
+            if (window) {
+                window->requestUpdate();
+            }
+        });
+    }
+}
+
+void FrameScheduler::frameStarted() {
+    ++m_stats.framesStarted;
+    wake(FrameWakeReason::External);
+}
+
+void FrameScheduler::goIdle() {
+    if (m_idle) {
+        return;
+    }
+    m_idle = true;
+    m_idleTimer.start();
+}
+
+void FrameScheduler::wake(FrameWakeReason reason) {
+    if (!m_idle) {
+        return;
+    }
+    m_idle = false;
+    m_idleNsecs += m_idleTimer.nsecsElapsed();
+    ++m_stats.wakeups;
+    ++m_stats.wakeupsByReason[static_cast<size_t>(reason)];
+}
+
+FrameSchedulerStats FrameScheduler::stats() const {
+    FrameSchedulerStats stats = m_stats;
+    qint64 idleNsecs = m_idleNsecs;
+    if (m_idle) {
+        idleNsecs += m_idleTimer.nsecsElapsed();
+    }
+    stats.idleSeconds = idleNsecs / 1e9;
+    stats.idle = m_idle;
+    return stats;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file FrameScheduler.hpp
+ * @brief Event-driven frame requests for the viewport
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QWindow>
+#include <array>
+
+/**
+ * @enum FrameWakeReason
+ * @brief Why a frame was requested
+ */
+enum class FrameWakeReason {
+    Accumulation,   // Progressive rendering continues (never wakes from idle)
+    Input,          // Camera or node moved
+    Parameters,     // Render setting changed
+    Scene,          // Scene load finished
+    Job,            // Final render started or finished
+    Capture,        // Async readback or hover probe needs a frame
+    External,       // Qt rendered on its own (expose, resize)
+    Count
+};
+
+constexpr int kFrameWakeReasonCount = static_cast<int>(FrameWakeReason::Count);
+
+/**
+ * @struct FrameSchedulerStats
+ * @brief Render loop activity counters
+ */
+struct FrameSchedulerStats {
+    quint64 framesStarted = 0;
+    quint64 wakeups = 0;                                        // Idle -> active transitions
+    std::array<quint64, kFrameWakeReasonCount> wakeupsByReason{};
+    double idleSeconds = 0.0;                                   // Includes the current idle period
+    bool idle = false;
+};
+
+/**
+ * @class FrameScheduler
+ * @brief Requests viewport frames only when there is work
+ *
+ * The renderer reports at the end of each frame whether another one is
+ * needed; if not, the loop goes idle and nothing is requested until a
+ * change arrives through request(). Qt may still render on its own
+ * (expose, resize); such frames count as external wakeups.
+ */
+class FrameScheduler {
+public:
+    explicit FrameScheduler(QWindow* window) : m_window(window) {}
+
+    /**
+     * @brief Ask for a frame (wakes the loop if idle)
+     */
+    void request(FrameWakeReason reason);
+
+    /**
+     * @brief Ask for a frame after a delay (throttled preview)
+     */
+    void requestDelayed(FrameWakeReason reason, int delayMs);
+
+    /**
+     * @brief Call at the top of startNextFrame()
+     */
+    void frameStarted();
+
+    /**
+     * @brief Call when a frame is done and nothing more is needed
+     */
+    void goIdle();
+
+    [[nodiscard]] bool isIdle() const { return m_idle; }
+    [[nodiscard]] FrameSchedulerStats stats() const;
+
+private:
+    void wake(FrameWakeReason reason);
+
+    QPointer<QWindow> m_window;
+    bool m_idle = false;
+    QElapsedTimer m_idleTimer;
+    qint64 m_idleNsecs = 0;
+    FrameSchedulerStats m_stats;
+};
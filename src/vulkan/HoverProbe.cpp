@@ -0,0 +1,103 @@
+/**
+ * @file HoverProbe.cpp
+ * @brief Frame-paced hover probing implementation
+ *
+ * @author wtflmao
+ */
+
+#include "HoverProbe.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+void HoverProbe::setSize(int size) {
+    size = std::clamp(size, 1, kMaxSize);
+    m_size = size | 1;  // Odd, so the cursor pixel is the center
+}
+
+void HoverProbe::request(int x, int y) {
+    ++m_stats.requests;
+    if (m_requestPending) {
+        ++m_stats.coalesced;
+    }
+    m_requestPending = true;
+    m_requestX = x;
+    m_requestY = y;
+}
+
+void HoverProbe::cancel() {
+    m_requestPending = false;
+    m_offsets.clear();
+    m_cursor = 0;
+}
+
+void HoverProbe::begin(uint32_t samples) {
+    m_requestPending = false;
+
+    m_result = HoverProbeResult{};
+    m_result.x = m_requestX;
+    m_result.y = m_requestY;
+    m_result.size = m_size;
+    m_result.samples = samples;
+    m_sum = glm::vec4(0.0f);
+
+    // Nearest pixels first, so partial statistics stay centred on the cursor
+    const int radius = m_size / 2;
+    m_offsets.clear();
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            m_offsets.emplace_back(dx, dy);
+        }
+    }
+    std::stable_sort(m_offsets.begin(), m_offsets.end(),
+                     [](const glm::ivec2& a, const glm::ivec2& b) {
+                         return std::max(std::abs(a.x), std::abs(a.y)) <
+                                std::max(std::abs(b.x), std::abs(b.y));
+                     });
+    m_cursor = 0;
+}
+
+bool HoverProbe::service(uint32_t samples, int width, int height, const ReadFn& read,
+                         HoverProbeResult& result, int maxReads) {
+    if (m_requestPending) {
+        begin(samples);
+    }
+    if (m_cursor >= m_offsets.size() || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    bool updated = false;
+    const int reads = std::min(kReadsPerFrame, maxReads);
+    for (int i = 0; i < reads && m_cursor < m_offsets.size(); ++i) {
+        const glm::ivec2 offset = m_offsets[m_cursor++];
+        const int x = std::clamp(m_result.x + offset.x, 0, width - 1);
+        const int y = std::clamp(m_result.y + offset.y, 0, height - 1);
+
+        glm::vec4 value(0.0f);
+        ++m_stats.reads;
+        if (!read(x, y, value)) {
+            // Context busy or read failed: give up on this probe
+            m_offsets.clear();
+            m_cursor = 0;
+            return false;
+        }
+
+        if (m_result.pixelsRead == 0) {
+            m_result.center = value;
+            m_result.min = value;
+            m_result.max = value;
+        } else {
+            m_result.min = glm::min(m_result.min, value);
+            m_result.max = glm::max(m_result.max, value);
+        }
+        m_sum += value;
+        ++m_result.pixelsRead;
+        m_result.mean = m_sum / static_cast<float>(m_result.pixelsRead);
+        updated = true;
+    }
+
+    if (updated) {
+        result = m_result;
+    }
+    return updated;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file HoverProbe.hpp
+ * @brief Frame-paced debug value probing under the mouse cursor
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QtGlobal>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @struct HoverProbeResult
+ * @brief Debug values around one viewport position
+ */
+struct HoverProbeResult {
+    int x = 0;
+    int y = 0;
+    int size = 1;                 // Neighbourhood edge length (odd)
+    int pixelsRead = 0;           // Of size * size
+    glm::vec4 center{0.0f};
+    glm::vec4 mean{0.0f};
+    glm::vec4 min{0.0f};
+    glm::vec4 max{0.0f};
+    uint32_t samples = 0;         // Accumulated samples when the probe started
+
+    [[nodiscard]] bool isComplete() const { return pixelsRead >= size * size; }
+};
+
+/**
+ * @struct HoverProbeStats
+ * @brief Request coalescing counters
+ */
+struct HoverProbeStats {
+    quint64 requests = 0;         // Mouse events handed to the probe
+    quint64 coalesced = 0;        // Superseded before they were serviced
+    quint64 reads = 0;            // Pixel reads issued
+};
+
+/**
+ * @class HoverProbe
+ * @brief Coalesces hover queries to a fixed read budget per frame
+ *
+ * request() only records the latest cursor position; service() runs once
+ * per frame and issues at most kReadsPerFrame pixel reads, so a burst of
+ * mouse events costs what one does. The center pixel is read first and
+ * reported immediately. While the cursor rests, the rest of the NxN
+ * neighbourhood is read over the following frames and the mean/min/max
+ * are refined until complete.
+ */
+class HoverProbe {
+public:
+    /// Reads the debug value at a viewport pixel; false on failure
+    using ReadFn = std::function<bool(int x, int y, glm::vec4& value)>;
+
+    static constexpr int kReadsPerFrame = 1;
+    static constexpr int kMaxSize = 7;
+
+    /**
+     * @brief Neighbourhood edge length (rounded up to odd, 1..kMaxSize)
+     */
+    void setSize(int size);
+    [[nodiscard]] int size() const { return m_size; }
+
+    /**
+     * @brief Probe this position on the next frame (replaces any pending request)
+     */
+    void request(int x, int y);
+
+    /**
+     * @brief Drop pending and partial probes
+     */
+    void cancel();
+
+    /**
+     * @brief Whether service() still has reads to do
+     */
+    [[nodiscard]] bool hasWork() const { return m_requestPending || m_cursor < m_offsets.size(); }
+
+    /**
+     * @brief Do this frame's reads
+     * @param samples Currently accumulated samples
+     * @param width,height Readable image size (positions are clamped)
+     * @param result Receives the updated probe
+     * @param maxReads Reads left in this frame's budget (capped at kReadsPerFrame)
+     * @return true if result was updated
+     */
+    bool service(uint32_t samples, int width, int height, const ReadFn& read,
+                 HoverProbeResult& result, int maxReads = kReadsPerFrame);
+
+    [[nodiscard]] const HoverProbeStats& stats() const { return m_stats; }
+
+private:
+    void begin(uint32_t samples);
+
+    int m_size = 1;
+    HoverProbeStats m_stats;
+
+    // Latest request
+    bool m_requestPending = false;
+    int m_requestX = 0;
+    int m_requestY = 0;
+
+    // Probe in progress
+    HoverProbeResult m_result;
+    glm::vec4 m_sum{0.0f};
+    std::vector<glm::ivec2> m_offsets;   // Center first, then outward
+    size_t m_cursor = 0;
+};
@@ -0,0 +1,272 @@
+/**
+ * @file OffscreenFrameRunner.cpp
+ * @brief Offscreen render target implementation
+ *
+ * @author wtflmao
+ */
+
+#include "OffscreenFrameRunner.hpp"
+
+#include <QDebug>
+#include <cstdint>
+
+namespace {
+
+uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeBits,
+                        VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memProps{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProps);
+    for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) &&
+            (memProps.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+void setError(QString* error, const QString& message) {
+    if (error) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+OffscreenFrameRunner::~OffscreenFrameRunner() {
+    destroy();
+}
+
+bool OffscreenFrameRunner::create(VkPhysicalDevice physicalDevice, VkDevice device,
+                                  VkQueue queue, uint32_t queueFamily, VkFormat format,
+                                  uint32_t width, uint32_t height, QString* error) {
+    destroy();
+
+    m_physicalDevice = physicalDevice;
+    m_device = device;
+    m_queue = queue;
+    m_format = format;
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+    if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool) != VK_SUCCESS) {
+        setError(error, QStringLiteral("vkCreateCommandPool failed"));
+        destroy();
+        return false;
+    }
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = m_commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = static_cast<uint32_t>(kFramesInFlight);
+    if (vkAllocateCommandBuffers(m_device, &allocInfo, m_commandBuffers.data()) != VK_SUCCESS) {
+        setError(error, QStringLiteral("vkAllocateCommandBuffers failed"));
+        destroy();
+        return false;
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    for (auto& fence : m_fences) {
+        if (vkCreateFence(m_device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+            setError(error, QStringLiteral("vkCreateFence failed"));
+            destroy();
+            return false;
+        }
+    }
+
+    if (!createTarget(width, height, error)) {
+        destroy();
+        return false;
+    }
+
+    return true;
+}
+
+void OffscreenFrameRunner::destroy() {
+    if (m_device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    waitIdle();
+    destroyTarget();
+
+    for (auto& fence : m_fences) {
+        if (fence != VK_NULL_HANDLE) {
+            vkDestroyFence(m_device, fence, nullptr);
+            fence = VK_NULL_HANDLE;
+        }
+    }
+    if (m_commandPool != VK_NULL_HANDLE) {
+        // Frees the command buffers as well
+        vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+        m_commandPool = VK_NULL_HANDLE;
+    }
+    m_commandBuffers.fill(VK_NULL_HANDLE);
+    m_slotUsed.fill(false);
+    m_nextSlot = 0;
+
+    m_device = VK_NULL_HANDLE;
+    m_physicalDevice = VK_NULL_HANDLE;
+    m_queue = VK_NULL_HANDLE;
+}
+
+bool OffscreenFrameRunner::resize(uint32_t width, uint32_t height, QString* error) {
+    if (!isValid()) {
+        setError(error, QStringLiteral("Offscreen runner not created"));
+        return false;
+    }
+    if (width == m_width && height == m_height) {
+        return true;
+    }
+
+    waitIdle();
+    destroyTarget();
+    return createTarget(width, height, error);
+}
+
+bool OffscreenFrameRunner::createTarget(uint32_t width, uint32_t height, QString* error) {
+    if (width == 0 || height == 0) {
+        setError(error, QStringLiteral("Invalid offscreen target size"));
+        return false;
+    }
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = m_format;
+    imageInfo.extent = {width, height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    // Same usage a swapchain image offers to the context (blit/draw target + readback)
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                      VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                      VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(m_device, &imageInfo, nullptr, &m_image) != VK_SUCCESS) {
+        setError(error, QStringLiteral("vkCreateImage failed (%1x%2)").arg(width).arg(height));
+        return false;
+    }
+
+    VkMemoryRequirements memReqs{};
+    vkGetImageMemoryRequirements(m_device, m_image, &memReqs);
+
+    VkMemoryAllocateInfo memInfo{};
+    memInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memInfo.allocationSize = memReqs.size;
+    memInfo.memoryTypeIndex = findMemoryType(m_physicalDevice, memReqs.memoryTypeBits,
+                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (memInfo.memoryTypeIndex == UINT32_MAX) {
+        // Software ICDs may not flag any heap as device local
+        memInfo.memoryTypeIndex = findMemoryType(m_physicalDevice, memReqs.memoryTypeBits, 0);
+    }
+
+    if (memInfo.memoryTypeIndex == UINT32_MAX ||
+        vkAllocateMemory(m_device, &memInfo, nullptr, &m_imageMemory) != VK_SUCCESS) {
+        setError(error, QStringLiteral("Failed to allocate offscreen target memory"));
+        destroyTarget();
+        return false;
+    }
+
+    vkBindImageMemory(m_device, m_image, m_imageMemory, 0);
+
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+void OffscreenFrameRunner::destroyTarget() {
+    if (m_image != VK_NULL_HANDLE) {
+        vkDestroyImage(m_device, m_image, nullptr);
+        m_image = VK_NULL_HANDLE;
+    }
+    if (m_imageMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(m_device, m_imageMemory, nullptr);
+        m_imageMemory = VK_NULL_HANDLE;
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+bool OffscreenFrameRunner::canSubmit() const {
+    if (!isValid()) {
+        return false;
+    }
+    if (!m_slotUsed[m_nextSlot]) {
+        return true;
+    }
+    return vkGetFenceStatus(m_device, m_fences[m_nextSlot]) == VK_SUCCESS;
+}
+
+bool OffscreenFrameRunner::submitFrame(const RecordFn& record) {
+    if (!isValid() || m_image == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    const size_t slot = m_nextSlot;
+    VkFence fence = m_fences[slot];
+    VkCommandBuffer cmd = m_commandBuffers[slot];
+
+    if (m_slotUsed[slot]) {
+        if (vkWaitForFences(m_device, 1, &fence, VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
+            qWarning() << "OffscreenFrameRunner: vkWaitForFences failed";
+            return false;
+        }
+    }
+    vkResetFences(m_device, 1, &fence);
+    vkResetCommandBuffer(cmd, 0);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) {
+        return false;
+    }
+
+    record(cmd, m_image, m_width, m_height);
+
+    if (vkEndCommandBuffer(cmd) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmd;
+    if (vkQueueSubmit(m_queue, 1, &submitInfo, fence) != VK_SUCCESS) {
+        qWarning() << "OffscreenFrameRunner: vkQueueSubmit failed";
+        // The fence was reset but never submitted; treat the slot as free
+        m_slotUsed[slot] = false;
+        return false;
+    }
+
+    m_slotUsed[slot] = true;
+    m_nextSlot = (slot + 1) % kFramesInFlight;
+    ++m_submittedFrames;
+    return true;
+}
+
+bool OffscreenFrameRunner::waitIdle() {
+    if (m_device == VK_NULL_HANDLE) {
+        return true;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < kFramesInFlight; ++i) {
+        if (!m_slotUsed[i]) {
+            continue;
+        }
+        if (vkWaitForFences(m_device, 1, &m_fences[i], VK_TRUE, UINT64_MAX) != VK_SUCCESS) {
+            ok = false;
+        }
+        m_slotUsed[i] = false;
+    }
+    return ok;
+}
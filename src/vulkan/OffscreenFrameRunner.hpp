@@ -0,0 +1,105 @@
+/**
+ * @file OffscreenFrameRunner.hpp
+ * @brief Offscreen render target and command submission without a swapchain
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QString>
+#include <array>
+#include <functional>
+#include <vulkan/vulkan.h>
+
+/**
+ * @class OffscreenFrameRunner
+ * @brief Drives ExternalRenderContext::RenderFrame into a private image
+ *
+ * Replaces the swapchain when frames must be produced independently of
+ * presentation (headless batch rendering, final renders). Owns a device-local
+ * color image plus a small ring of command buffers and fences, so recording
+ * of frame N+1 overlaps GPU execution of frame N. No present, no vsync.
+ *
+ * All calls go through the Vulkan loader, so the device may come from Qt
+ * or from a headless vkCreateDevice.
+ */
+class OffscreenFrameRunner {
+public:
+    /// Records one frame into cmd, targeting image of the given size
+    using RecordFn = std::function<void(VkCommandBuffer cmd, VkImage target,
+                                        uint32_t width, uint32_t height)>;
+
+    OffscreenFrameRunner() = default;
+    ~OffscreenFrameRunner();
+
+    OffscreenFrameRunner(const OffscreenFrameRunner&) = delete;
+    OffscreenFrameRunner& operator=(const OffscreenFrameRunner&) = delete;
+
+    /**
+     * @brief Create target image, command pool and synchronization objects
+     * @param format Color format of the target (must match the context's target format)
+     * @param error Receives a description on failure (may be null)
+     * @return true on success
+     */
+    bool create(VkPhysicalDevice physicalDevice, VkDevice device, VkQueue queue,
+                uint32_t queueFamily, VkFormat format,
+                uint32_t width, uint32_t height, QString* error = nullptr);
+
+    /**
+     * @brief Wait for all submitted work and release every Vulkan object
+     */
+    void destroy();
+
+    /**
+     * @brief Recreate the target image at a new size (waits for idle first)
+     */
+    bool resize(uint32_t width, uint32_t height, QString* error = nullptr);
+
+    /**
+     * @brief Check whether the next submission slot is free without blocking
+     */
+    [[nodiscard]] bool canSubmit() const;
+
+    /**
+     * @brief Record and submit one frame
+     *
+     * Blocks only if the oldest in-flight frame still occupies the slot.
+     * @return false if recording or submission failed
+     */
+    bool submitFrame(const RecordFn& record);
+
+    /**
+     * @brief Block until every submitted frame has completed
+     */
+    bool waitIdle();
+
+    [[nodiscard]] bool isValid() const { return m_device != VK_NULL_HANDLE; }
+    [[nodiscard]] uint32_t width() const { return m_width; }
+    [[nodiscard]] uint32_t height() const { return m_height; }
+    [[nodiscard]] VkImage targetImage() const { return m_image; }
+    [[nodiscard]] uint64_t submittedFrames() const { return m_submittedFrames; }
+
+private:
+    static constexpr size_t kFramesInFlight = 2;
+
+    bool createTarget(uint32_t width, uint32_t height, QString* error);
+    void destroyTarget();
+
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueue m_queue = VK_NULL_HANDLE;
+    VkFormat m_format = VK_FORMAT_UNDEFINED;
+
+    VkImage m_image = VK_NULL_HANDLE;
+    VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+
+    VkCommandPool m_commandPool = VK_NULL_HANDLE;
+    std::array<VkCommandBuffer, kFramesInFlight> m_commandBuffers{};
+    std::array<VkFence, kFramesInFlight> m_fences{};
+    std::array<bool, kFramesInFlight> m_slotUsed{};
+    size_t m_nextSlot = 0;
+    uint64_t m_submittedFrames = 0;
+};
@@ -0,0 +1,28 @@
+/**
+ * @file ParameterQueueStats.hpp
+ * @brief Counters for the renderer's per-frame parameter change queue
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * @struct ParameterQueueStats
+ * @brief How many parameter updates reached the renderer vs. the SDK
+ *
+ * Setters only record state; pending changes are applied once at the top of
+ * the next frame. Counters are cumulative since the renderer was created.
+ */
+struct ParameterQueueStats {
+    quint64 updatesQueued = 0;       // Setter calls (one per changed parameter)
+    quint64 updatesApplied = 0;      // SDK setter calls actually issued
+    quint64 updatesCoalesced = 0;    // Superseded by a later update before the frame
+
+    quint64 resetsRequested = 0;     // Accumulation resets asked for
+    quint64 resetsApplied = 0;       // At most one per frame
+
+    quint64 framesWithChanges = 0;   // Frames that applied at least one change
+};
@@ -0,0 +1,209 @@
+/**
+ * @file PipelineCacheManager.cpp
+ * @brief Versioned pipeline cache implementation
+ *
+ * @author wtflmao
+ */
+
+#include "PipelineCacheManager.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef QUANTILOOM_SDK_VERSION
+#define QUANTILOOM_SDK_VERSION "unknown"
+#endif
+
+namespace {
+
+// VkPipelineCacheHeaderVersionOne: size, version, vendorID, deviceID, UUID
+constexpr qsizetype kHeaderBytes = 16 + VK_UUID_SIZE;
+
+} // namespace
+
+QString PipelineCacheManager::baseDirectory() {
+    // Same roots the SDK uses for its default cache location
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+#ifdef Q_OS_WIN
+    return cacheDir + "/Quantiloom/cache/pipelines";
+#else
+    return cacheDir + "/Quantiloom/pipelines";
+#endif
+}
+
+QString PipelineCacheManager::cacheKey(const VkPhysicalDeviceProperties& properties) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(reinterpret_cast<const char*>(properties.pipelineCacheUUID),
+                                VK_UUID_SIZE));
+    hash.addData(QByteArray::number(properties.driverVersion));
+    hash.addData(QByteArrayView(QUANTILOOM_SDK_VERSION));
+
+    // Readable prefix, hashed suffix for everything that invalidates the cache
+    return QStringLiteral("%1-%2-%3")
+        .arg(properties.vendorID, 4, 16, QLatin1Char('0'))
+        .arg(properties.deviceID, 4, 16, QLatin1Char('0'))
+        .arg(QString::fromLatin1(hash.result().toHex().left(16)));
+}
+
+bool PipelineCacheManager::validateHeader(const QByteArray& header,
+                                          const VkPhysicalDeviceProperties& properties,
+                                          QString* error) {
+    const auto fail = [error](const QString& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    if (header.size() < kHeaderBytes) {
+        return fail(QObject::tr("Truncated header (%1 bytes)").arg(header.size()));
+    }
+
+    // Header fields are little-endian on every platform we ship
+    const auto* data = reinterpret_cast<const uchar*>(header.constData());
+    const quint32 headerSize = qFromLittleEndian<quint32>(data);
+    const quint32 headerVersion = qFromLittleEndian<quint32>(data + 4);
+    const quint32 vendorID = qFromLittleEndian<quint32>(data + 8);
+    const quint32 deviceID = qFromLittleEndian<quint32>(data + 12);
+
+    if (headerSize < kHeaderBytes || headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        return fail(QObject::tr("Unknown header (size %1, version %2)")
+            .arg(headerSize).arg(headerVersion));
+    }
+    if (vendorID != properties.vendorID || deviceID != properties.deviceID) {
+        return fail(QObject::tr("Written by another device (%1:%2)")
+            .arg(vendorID, 4, 16, QLatin1Char('0')).arg(deviceID, 4, 16, QLatin1Char('0')));
+    }
+    if (std::memcmp(data + 16, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return fail(QObject::tr("Pipeline cache UUID mismatch (driver changed)"));
+    }
+    return true;
+}
+
+void PipelineCacheManager::open(const VkPhysicalDeviceProperties& properties, bool recordStats) {
+    m_stats = PipelineCacheStats{};
+    m_stats.key = cacheKey(properties);
+    m_stats.directory = baseDirectory() + "/" + m_stats.key;
+
+    QDir().mkpath(m_stats.directory);
+    const QString path = m_stats.directory + "/" + kCacheFileName;
+
+    QFile file(path);
+    if (!file.exists()) {
+        m_stats.state = PipelineCacheState::Missing;
+    } else if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "PipelineCacheManager: Cannot read" << path << "-" << file.errorString();
+        m_stats.state = PipelineCacheState::Invalid;
+    } else {
+        QString error;
+        const QByteArray header = file.read(kHeaderBytes);
+        m_stats.cacheBytes = file.size();
+        file.close();
+
+        if (validateHeader(header, properties, &error)) {
+            m_stats.state = PipelineCacheState::Hit;
+            // Touch so pruning sees this key as recently used
+            QFile::setFileTime(path, QDateTime::currentDateTime(),
+                               QFileDevice::FileModificationTime);
+        } else {
+            qWarning() << "PipelineCacheManager: Discarding" << path << "-" << error;
+            QFile::remove(path);
+            m_stats.cacheBytes = 0;
+            m_stats.state = PipelineCacheState::Invalid;
+        }
+    }
+
+    QSettings settings;
+    settings.beginGroup("pipeline_cache");
+    m_stats.hits = settings.value("hits", 0).toULongLong();
+    m_stats.misses = settings.value("misses", 0).toULongLong();
+    if (recordStats) {
+        if (m_stats.isHit()) {
+            settings.setValue("hits", ++m_stats.hits);
+        } else {
+            settings.setValue("misses", ++m_stats.misses);
+        }
+    }
+    settings.endGroup();
+
+    pruneStaleKeys();
+
+    qDebug() << "PipelineCacheManager:" << stateName(m_stats.state) << "for key" << m_stats.key
+             << "(" << m_stats.cacheBytes << "bytes;" << m_stats.hits << "hits /"
+             << m_stats.misses << "misses)";
+}
+
+void PipelineCacheManager::warmupFinished(double elapsedMs, bool background) {
+    m_stats.warmupMs = elapsedMs;
+    m_stats.warmedInBackground = background;
+    m_stats.cacheBytes = QFileInfo(m_stats.directory + "/" + kCacheFileName).size();
+}
+
+void PipelineCacheManager::pruneStaleKeys() const {
+    QDir base(baseDirectory());
+    QFileInfoList keys = base.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    if (keys.size() <= kMaxCachedKeys) {
+        return;
+    }
+
+    // Most recently used first (the cache file's mtime, else the directory's)
+    const auto lastUsed = [](const QFileInfo& dir) {
+        const QFileInfo cache(dir.filePath() + "/" + kCacheFileName);
+        return cache.exists() ? cache.lastModified() : dir.lastModified();
+    };
+    std::sort(keys.begin(), keys.end(), [&](const QFileInfo& a, const QFileInfo& b) {
+        return lastUsed(a) > lastUsed(b);
+    });
+
+    for (qsizetype i = kMaxCachedKeys; i < keys.size(); ++i) {
+        if (keys[i].fileName() == m_stats.key) {
+            continue;
+        }
+        qDebug() << "PipelineCacheManager: Removing stale cache" << keys[i].fileName();
+        QDir(keys[i].filePath()).removeRecursively();
+    }
+}
+
+QString PipelineCacheManager::stateName(PipelineCacheState state) {
+    switch (state) {
+        case PipelineCacheState::Hit:
+            return QObject::tr("hit");
+        case PipelineCacheState::Missing:
+            return QObject::tr("miss");
+        case PipelineCacheState::Invalid:
+            return QObject::tr("miss (invalid cache discarded)");
+        case PipelineCacheState::Unknown:
+        default:
+            return QObject::tr("unknown");
+    }
+}
+
+PipelineWarmupResultPtr runPipelineWarmup(quantiloom::ExternalRenderContext::InitParams params,
+                                          int queueIndex) {
+    auto result = std::make_shared<PipelineWarmupResult>();
+    result->queueIndex = queueIndex;
+
+    QElapsedTimer timer;
+    timer.start();
+    auto created = quantiloom::ExternalRenderContext::Create(params);
+    result->elapsedMs = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+
+    if (!created) {
+        result->error = QString::fromStdString(created.error());
+        return result;
+    }
+    result->context = std::move(created.value());
+    return result;
+}
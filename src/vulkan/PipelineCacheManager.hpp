@@ -0,0 +1,136 @@
+/**
+ * @file PipelineCacheManager.hpp
+ * @brief Versioned pipeline cache location, validation and warm-up
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QString>
+#include <memory>
+#include <vulkan/vulkan.h>
+
+#include <renderer/ExternalRenderContext.hpp>
+
+/**
+ * @enum PipelineCacheState
+ * @brief What open() found for the current device
+ */
+enum class PipelineCacheState {
+    Unknown,    // open() not called yet
+    Hit,        // Cache present with a header matching this device
+    Missing,    // No cache for this device / driver / SDK yet
+    Invalid     // Cache present but unusable (truncated or foreign header); removed
+};
+
+/**
+ * @struct PipelineCacheStats
+ * @brief Cache outcome of this launch plus counters across launches
+ */
+struct PipelineCacheStats {
+    PipelineCacheState state = PipelineCacheState::Unknown;
+    QString key;                  // Device / driver / SDK key (directory name)
+    QString directory;
+    qint64 cacheBytes = 0;        // Size at open(), refreshed after warm-up
+    double warmupMs = -1.0;       // Context creation time (-1: not measured)
+    bool warmedInBackground = false;
+
+    // Persisted across launches (QSettings group "pipeline_cache")
+    quint64 hits = 0;
+    quint64 misses = 0;           // Includes invalid caches
+
+    [[nodiscard]] bool isHit() const { return state == PipelineCacheState::Hit; }
+};
+
+/**
+ * @class PipelineCacheManager
+ * @brief Keys the SDK's pipeline cache by device, driver and SDK version
+ *
+ * The SDK reads and writes pipeline_cache.bin inside InitParams::pipelineCacheDir.
+ * Pointing that at a directory per cache key means a driver or SDK update
+ * starts a fresh cache rather than handing the driver stale data, and
+ * switching GPUs does not evict the other one's cache. Before use the file's
+ * Vulkan header (VkPipelineCacheHeaderVersionOne) is checked against the
+ * device; a mismatching or truncated file is deleted so it counts as a miss
+ * instead of being trusted because it exists.
+ *
+ * Only the kMaxCachedKeys most recently used key directories are kept.
+ */
+class PipelineCacheManager {
+public:
+    static constexpr int kMaxCachedKeys = 4;
+    static constexpr const char* kCacheFileName = "pipeline_cache.bin";
+
+    /**
+     * @brief Resolve, validate and account the cache for a device
+     * @param recordStats Update the persisted hit/miss counters
+     */
+    void open(const VkPhysicalDeviceProperties& properties, bool recordStats = true);
+
+    /**
+     * @brief Directory to pass as InitParams::pipelineCacheDir (empty before open())
+     */
+    [[nodiscard]] const QString& directory() const { return m_stats.directory; }
+
+    /**
+     * @brief Whether creating a context will compile pipelines from scratch
+     */
+    [[nodiscard]] bool needsWarmup() const { return m_stats.state != PipelineCacheState::Hit; }
+
+    /**
+     * @brief Record the context creation that filled the cache
+     */
+    void warmupFinished(double elapsedMs, bool background);
+
+    [[nodiscard]] const PipelineCacheStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Root of all keyed cache directories
+     */
+    static QString baseDirectory();
+
+    /**
+     * @brief Cache key: vendor, device, driver version, pipelineCacheUUID, SDK version
+     */
+    static QString cacheKey(const VkPhysicalDeviceProperties& properties);
+
+    /**
+     * @brief Check a cache file's Vulkan header against the device
+     * @return true if the header matches
+     */
+    static bool validateHeader(const QByteArray& header,
+                               const VkPhysicalDeviceProperties& properties,
+                               QString* error = nullptr);
+
+    static QString stateName(PipelineCacheState state);
+
+private:
+    void pruneStaleKeys() const;
+
+    PipelineCacheStats m_stats;
+};
+
+/**
+ * @struct PipelineWarmupResult
+ * @brief Context created off the GUI thread while pipelines compiled
+ */
+struct PipelineWarmupResult {
+    std::unique_ptr<quantiloom::ExternalRenderContext> context;
+    QString error;
+    int queueIndex = 0;
+    double elapsedMs = 0.0;
+};
+
+using PipelineWarmupResultPtr = std::shared_ptr<PipelineWarmupResult>;
+
+/**
+ * @brief Create the first render context on a worker (QtConcurrent::run entry point)
+ *
+ * Context creation is where the SDK compiles (or loads from cache) its
+ * pipelines. params must use a queue nothing else submits to meanwhile.
+ * The context only fills the cache; the renderer re-creates its live one
+ * on Qt's graphics queue.
+ */
+PipelineWarmupResultPtr runPipelineWarmup(quantiloom::ExternalRenderContext::InitParams params,
+                                          int queueIndex);
@@ -7,6 +7,11 @@
 
 #include "QuantiloomVulkanRenderer.hpp"
 #include "QuantiloomVulkanWindow.hpp"
+#include "SceneLoader.hpp"
+#include "SceneCache.hpp"
+#include "FinalRenderJob.hpp"
+#include "config/ConfigManager.hpp"
+#include "StartupTrace.hpp"
 
 #include <renderer/ExternalRenderContext.hpp>
 #include <renderer/LightingParams.hpp>
@@ -17,31 +22,91 @@
 
 #include <QVulkanFunctions>
 #include <QFile>
-#include <QFileInfo>
 #include <QDir>
 #include <QObject>
 #include <QDebug>
-#include <QProgressDialog>
-#include <QApplication>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QThread>
+#include <QElapsedTimer>
 #include <QTimer>
-#include <QStandardPaths>
+
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <utility>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+namespace {
+
+// Preview frame interval while a final render job runs (~15 fps)
+constexpr int kThrottledFrameIntervalMs = 66;
+
+// Adaptive SPP stays at 1 this long after the last camera/node change
+constexpr auto kInteractionHold = std::chrono::milliseconds(150);
+
+// Synchronous ReadPixelValue round trips per frame, shared by the hover
+// probe, convergence checkpoints and ROI statistics (in that priority)
+constexpr int kPixelReadsPerFrame = 16;
+
+quantiloom::ExternalRenderContext::InitParams makeInitParams(QuantiloomVulkanWindow* window,
+                                                             VkQueue queue,
+                                                             const QSize& renderSize,
+                                                             const QString& pipelineCacheDir) {
+    quantiloom::ExternalRenderContext::InitParams params{};
+    params.instance = window->vulkanInstance()->vkInstance();
+    params.physicalDevice = window->physicalDevice();
+    params.device = window->device();
+    params.graphicsQueue = queue;
+    params.graphicsQueueFamily = static_cast<quantiloom::u32>(window->graphicsQueueFamilyIndex());
+    params.targetColorFormat = window->colorFormat();
+    params.width = static_cast<quantiloom::u32>(renderSize.width());
+    params.height = static_cast<quantiloom::u32>(renderSize.height());
+    // Keyed per device / driver / SDK (see PipelineCacheManager); when empty the
+    // SDK falls back to its platform default under the user cache directory
+    if (!pipelineCacheDir.isEmpty()) {
+        params.pipelineCacheDir = pipelineCacheDir.toStdString();
+    }
+    return params;
+}
+
+} // namespace
+
 QuantiloomVulkanRenderer::QuantiloomVulkanRenderer(QuantiloomVulkanWindow* window)
     : m_window(window)
     , m_lastFrameTime(std::chrono::high_resolution_clock::now())
+    , m_scheduler(window)
+    , m_renderResizeTimer(std::make_unique<QTimer>())
 {
+    m_renderResizeTimer->setSingleShot(true);
+    m_renderResizeTimer->setInterval(RenderResolutionSettings::kSettleMs);
+    QObject::connect(m_renderResizeTimer.get(), &QTimer::timeout, m_window,
+                     [this]() { onRenderResizeSettled(); });
 }
 
 QuantiloomVulkanRenderer::~QuantiloomVulkanRenderer() {
+    destroyFinalRender();
+    waitForPipelineWarmup();
+
+    // A worker may still hold the context; cancel and wait before releasing it
+    cancelSceneLoad();
+    waitForSceneLoad();
+    m_completedLoad.reset();
+
     // Release resources in proper order
     m_renderContext.reset();
 }
 
 void QuantiloomVulkanRenderer::initResources() {
     qDebug() << "QuantiloomVulkanRenderer::initResources() - Vulkan device ready";
+    StartupTrace::end("Vulkan device creation");
+
+    m_profiler.createGpuTimer(m_window->physicalDevice(), m_window->device(),
+                              m_window->graphicsQueueFamilyIndex(),
+                              m_window->concurrentFrameCount());
+    m_readback.create(m_window->physicalDevice(), m_window->device(),
+                      m_window->concurrentFrameCount());
     // Note: Swapchain is not ready yet, full initialization happens in initSwapChainResources()
 }
 
@@ -56,14 +121,30 @@ void QuantiloomVulkanRenderer::initSwapChainResources() {
         return;
     }
 
+    // Context still being created by the pipeline warm-up; it resizes when done
+    if (m_warmupWatcher) {
+        qDebug() << "  Pipeline warm-up in progress, deferring resize";
+        return;
+    }
+
     // If already initialized, just resize
     if (m_renderContext) {
-        qDebug() << "  Resizing existing context...";
-        m_renderContext->Resize(
-            static_cast<quantiloom::u32>(swapSize.width()),
-            static_cast<quantiloom::u32>(swapSize.height())
-        );
-        resetAccumulation();
+        if (m_contextBusy) {
+            // Context is loading on a worker; resize once it is handed back
+            qDebug() << "  Scene load in progress, deferring resize";
+            m_resizePending = true;
+            return;
+        }
+        // The current internal size keeps rendering (scaled to the new swapchain)
+        // and accumulating; reallocate only once the window stops changing size
+        if (targetRenderSize() == m_contextSize) {
+            m_renderResizeTimer->stop();
+            qDebug() << "  Render size unchanged, keeping accumulation";
+        } else {
+            m_renderResizeTimer->start();
+            qDebug() << "  Render size" << m_contextSize << "->" << targetRenderSize()
+                     << "once the resize settles";
+        }
         return;
     }
 
@@ -83,33 +164,46 @@ void QuantiloomVulkanRenderer::initSwapChainResources() {
         return;
     }
 
-    // Get graphics queue using device functions
+    // Get graphics queues using device functions. Queue 0 is shared with Qt;
+    // any extra queues let scene loads build a new context without stalling frames.
     QVulkanDeviceFunctions* df = inst->deviceFunctions(device);
-    VkQueue graphicsQueue;
-    df->vkGetDeviceQueue(device, m_window->graphicsQueueFamilyIndex(), 0, &graphicsQueue);
+    const uint32_t queueFamily = m_window->graphicsQueueFamilyIndex();
+    const uint32_t queueCount = m_window->queueCountForFamily(queueFamily);
+    m_queues.clear();
+    for (uint32_t i = 0; i < queueCount; ++i) {
+        VkQueue queue = VK_NULL_HANDLE;
+        df->vkGetDeviceQueue(device, queueFamily, i, &queue);
+        m_queues.append(queue);
+    }
+    m_liveQueueIndex = 0;
 
-    qDebug() << "  VkQueue:" << graphicsQueue;
-    qDebug() << "  Queue family:" << m_window->graphicsQueueFamilyIndex();
+    qDebug() << "  VkQueue:" << m_queues[0] << "(" << m_queues.size() << "queue(s) in family)";
+    qDebug() << "  Queue family:" << queueFamily;
     qDebug() << "  Color format:" << m_window->colorFormat();
 
+    // Validate the versioned pipeline cache before anything compiles against it
+    // (counters are recorded once per session, not on every minimize/restore)
+    m_pipelineCache.open(*m_window->physicalDeviceProperties(),
+                         m_pipelineCache.stats().state == PipelineCacheState::Unknown);
+
+    if (m_pipelineCache.needsWarmup() && m_queues.size() > 1) {
+        // Compile on a worker with a spare queue; frames present empty meanwhile
+        // and a scene requested before then waits in m_pendingScenePath
+        startPipelineWarmup();
+        return;
+    }
+
     // Initialize libQuantiloom with external handles
-    quantiloom::ExternalRenderContext::InitParams params{};
-    params.instance = vkInstance;
-    params.physicalDevice = physDevice;
-    params.device = device;
-    params.graphicsQueue = graphicsQueue;
-    params.graphicsQueueFamily = static_cast<quantiloom::u32>(m_window->graphicsQueueFamilyIndex());
-    params.targetColorFormat = m_window->colorFormat();
-    params.width = static_cast<quantiloom::u32>(swapSize.width());
-    params.height = static_cast<quantiloom::u32>(swapSize.height());
-    // Note: pipelineCacheDir uses platform-specific default in ExternalRenderContext:
-    //   Windows: %LOCALAPPDATA%/Quantiloom/cache/
-    //   Linux:   ~/.cache/Quantiloom/
-    //   macOS:   ~/Library/Caches/Quantiloom/
+    quantiloom::ExternalRenderContext::InitParams params =
+        makeInitParams(m_window, m_queues[0], targetRenderSize(), m_pipelineCache.directory());
 
     qDebug() << "Creating ExternalRenderContext...";
 
+    QElapsedTimer timer;
+    timer.start();
+    StartupTrace::begin("ExternalRenderContext::Create");
     auto result = quantiloom::ExternalRenderContext::Create(params);
+    StartupTrace::end("ExternalRenderContext::Create");
     if (!result) {
         qCritical() << "Failed to create ExternalRenderContext:"
                     << QString::fromStdString(result.error());
@@ -118,55 +212,289 @@ void QuantiloomVulkanRenderer::initSwapChainResources() {
 
     qDebug() << "ExternalRenderContext created successfully!";
 
+    m_pipelineCache.warmupFinished(static_cast<double>(timer.nsecsElapsed()) / 1.0e6, false);
     m_renderContext = std::move(result.value());
+    m_contextSize = targetRenderSize();
+    m_liveQueueIndex = 0;
+    finishContextInit();
+}
+
+void QuantiloomVulkanRenderer::finishContextInit() {
     m_initialized = true;
+    emit m_window->pipelineCacheReady(m_pipelineCache.stats());
+    emit m_window->renderSizeChanged(m_contextSize);
+
+    // Set initial camera
+    m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
+    m_renderContext->SetCameraFOV(m_cameraFovY);
 
-    // Load pending scene if any
+    // Load pending scene if any (hands the context to a worker)
     if (!m_pendingScenePath.isEmpty()) {
-        loadScene(m_pendingScenePath);
+        QString path = m_pendingScenePath;
         m_pendingScenePath.clear();
+        loadScene(path);
     }
+}
 
-    // Set initial camera
-    m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-    m_renderContext->SetCameraFOV(m_cameraFovY);
+void QuantiloomVulkanRenderer::startPipelineWarmup() {
+    const int warmupQueue = 1;
+    const auto params = makeInitParams(m_window, m_queues[warmupQueue], targetRenderSize(),
+                                       m_pipelineCache.directory());
+
+    qDebug() << "  Pipeline cache" << PipelineCacheManager::stateName(m_pipelineCache.stats().state)
+             << "- compiling pipelines in the background on queue" << warmupQueue;
+
+    m_warmupWatcher = std::make_unique<QFutureWatcher<PipelineWarmupResultPtr>>();
+    QObject::connect(m_warmupWatcher.get(), &QFutureWatcherBase::finished, m_window,
+                     [this]() { onPipelineWarmupFinished(); });
+    StartupTrace::begin("ExternalRenderContext::Create (background warm-up)");
+    m_warmupWatcher->setFuture(QtConcurrent::run(runPipelineWarmup, params, warmupQueue));
+
+    emit m_window->pipelineWarmupStarted();
+}
+
+void QuantiloomVulkanRenderer::waitForPipelineWarmup() {
+    if (!m_warmupWatcher) {
+        return;
+    }
+    // The context (if any) is dropped with the result, before the device goes away
+    m_warmupWatcher->disconnect();
+    m_warmupWatcher->waitForFinished();
+    m_warmupWatcher.reset();
+}
+
+void QuantiloomVulkanRenderer::onPipelineWarmupFinished() {
+    if (!m_warmupWatcher) {
+        return;
+    }
+
+    PipelineWarmupResultPtr result;
+    if (m_warmupWatcher->future().resultCount() > 0) {
+        result = m_warmupWatcher->result();
+    }
+
+    // Still inside the watcher's signal; delete it later
+    m_warmupWatcher.release()->deleteLater();
+    StartupTrace::end("ExternalRenderContext::Create (background warm-up)");
+
+    if (!result || !result->context) {
+        qCritical() << "Failed to create ExternalRenderContext:"
+                    << (result ? result->error : QStringLiteral("warm-up aborted"));
+        return;
+    }
+
+    qDebug() << "ExternalRenderContext created in the background in" << result->elapsedMs << "ms";
+    m_pipelineCache.warmupFinished(result->elapsedMs, true);
+
+    // The warm-up context submits its internal work on its own queue, unordered
+    // with our frames on Qt's. The cache is warm now, so the live context is
+    // re-created on queue 0 from cache hits (sized for the current swapchain).
+    result->context.reset();
+    const auto params =
+        makeInitParams(m_window, m_queues[0], targetRenderSize(), m_pipelineCache.directory());
+    StartupTrace::begin("ExternalRenderContext::Create");
+    auto created = quantiloom::ExternalRenderContext::Create(params);
+    StartupTrace::end("ExternalRenderContext::Create");
+    if (!created) {
+        qCritical() << "Failed to create ExternalRenderContext:"
+                    << QString::fromStdString(created.error());
+        return;
+    }
+
+    m_renderContext = std::move(created.value());
+    m_contextSize = targetRenderSize();
+    m_liveQueueIndex = 0;
+
+    // Settings changed during the warm-up were only stored
+    applyRenderState();
+    finishContextInit();
+    m_scheduler.request(FrameWakeReason::Scene);
+}
+
+QSize QuantiloomVulkanRenderer::targetRenderSize() const {
+    return m_renderResolution.renderSize(m_window->swapChainImageSize());
+}
+
+void QuantiloomVulkanRenderer::waitForGraphicsQueue() {
+    if (m_liveQueueIndex == 0 || m_queues.isEmpty()) {
+        return;
+    }
+    // The SDK waits for its own submits; this orders them after our frames
+    QVulkanDeviceFunctions* df = m_window->vulkanInstance()->deviceFunctions(m_window->device());
+    df->vkQueueWaitIdle(m_queues[0]);
+}
+
+bool QuantiloomVulkanRenderer::resizeContextToTarget() {
+    const QSize size = targetRenderSize();
+    if (size.isEmpty() || size == m_contextSize) {
+        return false;
+    }
+    waitForGraphicsQueue();
+    m_renderContext->Resize(static_cast<quantiloom::u32>(size.width()),
+                            static_cast<quantiloom::u32>(size.height()));
+    m_contextSize = size;
+    emit m_window->renderSizeChanged(m_contextSize);
+    return true;
+}
+
+void QuantiloomVulkanRenderer::onRenderResizeSettled() {
+    if (!m_renderContext || m_warmupWatcher) {
+        return;  // The warm-up result is sized when it arrives
+    }
+    if (m_contextBusy) {
+        m_resizePending = true;
+        return;
+    }
+    if (resizeContextToTarget()) {
+        qDebug() << "Render size settled at" << m_contextSize;
+        resetAccumulation();
+    }
+}
+
+void QuantiloomVulkanRenderer::setRenderResolution(const RenderResolutionSettings& settings) {
+    if (settings == m_renderResolution) {
+        return;
+    }
+    m_renderResolution = settings;
+    m_renderResizeTimer->stop();
+    onRenderResizeSettled();
 }
 
 void QuantiloomVulkanRenderer::releaseSwapChainResources() {
-    // Nothing to do - render context manages its own resources
+    // Only presentation state is tied to the swapchain; the context keeps its
+    // scene, acceleration structures and accumulation. Qt has waited for the
+    // device, so copies from the old swapchain images are complete: deliver them now.
+    m_readback.resolveAll();
 }
 
 void QuantiloomVulkanRenderer::releaseResources() {
+    // Only reached when the device itself goes away (surface destroyed, device
+    // lost, window closed): minimize keeps everything (PersistentResources).
+    // The scene has to be reloaded into the next device's context, and a
+    // running final render cannot survive.
+    if (m_finalRenderJob) {
+        destroyFinalRender();
+        emit m_window->finalRenderFinished(false, QObject::tr("Final render interrupted"));
+    }
+
     // Save current scene path for reload after window restore
-    if (!m_currentScenePath.isEmpty()) {
+    if (m_sceneLoading) {
+        // Abandon the in-flight load and restart it after restore
+        m_pendingScenePath = m_queuedScenePath.isEmpty() ? m_loadingScenePath : m_queuedScenePath;
+        cancelSceneLoad();
+        waitForSceneLoad();
+        m_completedLoad.reset();
+        m_sceneLoading = false;
+        m_contextBusy = false;
+        m_frameHeld = false;
+        m_resizePending = false;
+        m_loadingScenePath.clear();
+        qDebug() << "Scene load interrupted, will reload:" << m_pendingScenePath;
+    } else if (!m_currentScenePath.isEmpty()) {
         m_pendingScenePath = m_currentScenePath;
         qDebug() << "Saved scene path for restore:" << m_pendingScenePath;
     }
+    waitForPipelineWarmup();
     m_renderContext.reset();
+    m_contextSize = QSize();
+    m_renderResizeTimer->stop();
+    m_profiler.destroyGpuTimer();
+    failDisplayReadbacks();
+    m_readback.destroy();
+    m_pendingNodeTransforms.clear();
+    m_pendingMaterials.clear();
+    m_queues.clear();
+    m_liveQueueIndex = 0;
     m_initialized = false;
 }
 
 void QuantiloomVulkanRenderer::startNextFrame() {
-    static uint64_t frameCounter = 0;
-    frameCounter++;
-
     auto now = std::chrono::high_resolution_clock::now();
     float deltaTime = std::chrono::duration<float>(now - m_lastFrameTime).count();
     m_lastFrameTime = now;
+    m_scheduler.frameStarted();
+    m_profiler.beginFrame();
+
+    // Qt has waited for this slot's fence: its readback (if any) is complete
+    m_readback.frameSlotReady(m_window->currentFrame());
+
+    // Swap in a finished scene load at the frame boundary
+    if (m_completedLoad) {
+        completeSceneLoad();
+    }
 
     // Update camera based on input
-    updateCamera(deltaTime);
+    {
+        FrameProfiler::Scope span(m_profiler, FrameMetric::CameraUpdate);
+        updateCamera(deltaTime);
+    }
+
+    recordFrame();
+}
+
+void QuantiloomVulkanRenderer::recordFrame() {
+    if (m_contextBusy) {
+        // The worker owns the context; hold this frame (the last image stays
+        // on screen) and call frameReady() once the load hands it back.
+        m_frameHeld = true;
+        return;
+    }
+
+    static uint64_t frameCounter = 0;
+    frameCounter++;
+
+    // One acceleration structure rebuild for all transforms since the last frame
+    // (an open edit batch applies its own on close)
+    const bool editBatchOpen = m_window->inEditBatch();
+    if (!editBatchOpen) {
+        FrameProfiler::Scope span(m_profiler, FrameMetric::NodeTransforms);
+        flushNodeTransforms();
+    }
+
+    // Pick this frame's SPP from measured cost (may queue an SPP change)
+    updateAdaptiveSpp();
+
+    // Everything set since the last frame, with at most one accumulation reset
+    {
+        FrameProfiler::Scope span(m_profiler, FrameMetric::ParameterUpload);
+        if (!editBatchOpen) {
+            flushMaterials();
+        }
+        applyPendingParameters();
+    }
 
     if (!m_renderContext || !m_renderContext->HasScene()) {
-        // No scene loaded yet, just present empty frame
+        // No scene loaded yet, just present empty frame (then idle until a change)
+        failDisplayReadbacks();
+        m_hoverProbe.cancel();
         m_window->frameReady();
-        m_window->requestUpdate();
+        notifyFirstFrame();
+        requestNextFrame();
         return;
     }
 
+    // Image sequence recording (PNG frames ride on this frame's readback)
+    captureSequenceFrame();
+
+    // Pixel probes share one read budget per frame
+    m_pixelReadBudget = kPixelReadsPerFrame;
+
+    // At most one debug pixel read per frame, however fast the mouse moves
+    serviceHoverProbe();
+
+    // Probe the accumulated image at sample checkpoints (a bounded slice of the grid per frame)
+    checkConvergence();
+
+    // Region statistics: whatever is left of the budget
+    serviceRoiStatistics();
+
     // Log every 100 frames to track progress
     if (frameCounter % 100 == 0) {
-        qDebug() << "Frame" << frameCounter << "- samples:" << m_sampleCount;
+        qDebug() << "Frame" << frameCounter << "- samples:" << m_sampleCount
+                 << "- parameter updates:" << m_parameterStats.updatesQueued
+                 << "(" << m_parameterStats.updatesCoalesced << "coalesced),"
+                 << "resets:" << m_parameterStats.resetsApplied << "/"
+                 << m_parameterStats.resetsRequested;
     }
 
     // Get current command buffer and swapchain image
@@ -174,30 +502,90 @@ void QuantiloomVulkanRenderer::startNextFrame() {
     int swapChainIndex = m_window->currentSwapChainImageIndex();
     VkImage targetImage = m_window->swapChainImage(swapChainIndex);
     QSize swapSize = m_window->swapChainImageSize();
+    const int frameSlot = m_window->currentFrame();
 
     // Render frame using libQuantiloom
-    // ExternalRenderContext handles layout transitions and blit to swapchain
-    m_renderContext->RenderFrame(
-        cmd,
-        targetImage,
-        VK_IMAGE_LAYOUT_UNDEFINED,  // Qt doesn't guarantee initial layout
-        static_cast<quantiloom::u32>(swapSize.width()),
-        static_cast<quantiloom::u32>(swapSize.height())
-    );
+    // ExternalRenderContext handles layout transitions and the (scaling) blit
+    // from the internal render size to the swapchain
+    m_profiler.writeGpuBegin(cmd, frameSlot);
+    {
+        FrameProfiler::Scope span(m_profiler, FrameMetric::RecordFrame);
+        m_renderContext->RenderFrame(
+            cmd,
+            targetImage,
+            VK_IMAGE_LAYOUT_UNDEFINED,  // Qt doesn't guarantee initial layout
+            static_cast<quantiloom::u32>(swapSize.width()),
+            static_cast<quantiloom::u32>(swapSize.height())
+        );
+    }
+    m_profiler.writeGpuEnd(cmd, frameSlot);
+
+    // Requested captures copy this frame's image; delivered when the slot returns
+    recordDisplayReadback(cmd, frameSlot, targetImage, swapSize);
 
     // Update sample count
     m_sampleCount = m_renderContext->GetAccumulatedSamples();
+    m_profiler.endFrame(m_sampleCount, m_frameSpp);
 
-    // Calculate frame time
-    auto frameEnd = std::chrono::high_resolution_clock::now();
-    m_lastFrameTimeMs = std::chrono::duration<float, std::milli>(frameEnd - now).count();
-
-    // Emit frame rendered signal
-    emit m_window->frameRendered(m_lastFrameTimeMs, m_sampleCount);
+    // Emit frame rendered signal (frame-to-frame time, not just CPU recording)
+    emit m_window->frameRendered(static_cast<float>(m_profiler.lastIntervalMs()), m_sampleCount);
 
     // Signal frame ready and request next frame
     m_window->frameReady();
-    m_window->requestUpdate();
+    notifyFirstFrame();
+    requestNextFrame();
+}
+
+void QuantiloomVulkanRenderer::notifyFirstFrame() {
+    if (m_firstFramePresented) {
+        return;
+    }
+    m_firstFramePresented = true;
+    StartupTrace::finish("First frame presented");
+    emit m_window->firstFramePresented();
+}
+
+void QuantiloomVulkanRenderer::requestNextFrame() {
+    if (!m_window->isExposed()) {
+        // Minimized or hidden: accumulation pauses with everything kept resident,
+        // and the expose event on restore requests the next frame
+        m_scheduler.goIdle();
+        return;
+    }
+    if (!wantsContinuousFrames()) {
+        // Converged or nothing to render: the last image stays on screen
+        // until a change requests a frame through the scheduler
+        m_scheduler.goIdle();
+        return;
+    }
+    if (m_finalRenderJob) {
+        // Leave the GPU to the final render; keep the preview interactive
+        m_scheduler.requestDelayed(FrameWakeReason::Accumulation, kThrottledFrameIntervalMs);
+        return;
+    }
+    m_scheduler.request(FrameWakeReason::Accumulation);
+}
+
+bool QuantiloomVulkanRenderer::wantsContinuousFrames() const {
+    // Work queued for the next frame
+    if (m_pendingChanges != 0 || !m_pendingNodeTransforms.isEmpty() ||
+        !m_pendingMaterials.isEmpty() || m_completedLoad) {
+        return true;
+    }
+    // Captures waiting for a frame, or for their frame slot to come around
+    if (!m_readbackRequests.empty() || m_readback.hasPending() || m_hoverProbe.hasWork()) {
+        return true;
+    }
+    // Held movement keys move the camera every frame
+    if (m_moveForward || m_moveBackward || m_moveLeft || m_moveRight || m_moveUp || m_moveDown) {
+        return true;
+    }
+    // Progressive accumulation still improving the image
+    if (!contextReady() || !m_renderContext->HasScene()) {
+        return false;
+    }
+    // Region statistics sweep still running or behind the accumulation
+    return !m_convergence.isConverged() || m_roiStatistics.hasWork(m_sampleCount);
 }
 
 void QuantiloomVulkanRenderer::loadScene(const QString& filePath) {
@@ -215,83 +603,383 @@ void QuantiloomVulkanRenderer::loadScene(const QString& filePath) {
         return;
     }
 
-    // Check if this is the first run (no pipeline cache)
-    QProgressDialog* progressDialog = nullptr;
-    if (isFirstRun()) {
-        qDebug() << "  First run detected - showing shader compilation dialog";
+    if (m_finalRenderJob) {
+        // Scene swaps wait for device idle, which would race the job's queue
+        emit m_window->sceneLoaded(false,
+            QObject::tr("Stop the final render before loading another scene"));
+        return;
+    }
 
-        // Create modal progress dialog
-        // Note: Using nullptr as parent since QVulkanWindow is not a QWidget
-        progressDialog = new QProgressDialog(
-            QObject::tr("Compiling and loading shaders...\nIt may take a few minutes."),
-            QString(),  // No cancel button
-            0, 0,       // Indeterminate progress
-            nullptr
-        );
-        progressDialog->setWindowTitle(QObject::tr("Initializing"));
-        progressDialog->setWindowModality(Qt::ApplicationModal);
-        progressDialog->setMinimumDuration(0);  // Show immediately
-        progressDialog->setCancelButton(nullptr);  // Remove cancel button
-        progressDialog->setAutoClose(true);
-        progressDialog->setAutoReset(true);
-        progressDialog->setMinimumWidth(350);
-
-        // Make dialog non-closable
-        progressDialog->setWindowFlags(
-            Qt::Dialog | Qt::CustomizeWindowHint | Qt::WindowTitleHint
-        );
+    if (m_sceneLoading) {
+        // Supersede the running load; it is started once the worker returns
+        qDebug() << "  Load in progress, queueing after cancellation";
+        m_queuedScenePath = filePath;
+        if (m_loadCancelFlag) {
+            m_loadCancelFlag->store(true);
+        }
+        return;
+    }
+
+    startSceneLoad(filePath);
+}
+
+void QuantiloomVulkanRenderer::startSceneLoad(const QString& filePath) {
+    SceneLoadRequest request;
+    request.scenePath = filePath;
+    request.environmentMapPath = m_environmentMapPath;
+    request.firstRun = isFirstRun();
+    request.useSceneCache = SceneCache::isEnabled();
+
+    // With a scene on screen and a spare queue, build the new scene in a fresh
+    // context so the current one keeps rendering until the swap. Otherwise load
+    // in place and hold frames while the worker owns the context.
+    int loaderQueue = -1;
+    if (m_renderContext->HasScene()) {
+        for (int i = 1; i < m_queues.size(); ++i) {
+            if (i != m_liveQueueIndex) {
+                loaderQueue = i;
+                break;
+            }
+        }
+    }
+
+    if (loaderQueue > 0) {
+        request.createContext = true;
+        request.queueIndex = loaderQueue;
+        request.createParams = makeInitParams(m_window, m_queues[loaderQueue], targetRenderSize(),
+                                              m_pipelineCache.directory());
+        qDebug() << "  Loading into new context on queue" << loaderQueue;
+    } else {
+        request.targetContext = m_renderContext.get();
+        m_contextBusy = true;
+        qDebug() << "  Loading in place (frames held until done)";
+    }
+
+    m_loadCancelFlag = request.cancelFlag;
+    m_loadingScenePath = filePath;
+    m_sceneLoading = true;
+
+    m_loadWatcher = std::make_unique<QFutureWatcher<SceneLoadResultPtr>>();
+    auto* watcher = m_loadWatcher.get();
+    QObject::connect(watcher, &QFutureWatcherBase::progressValueChanged, m_window,
+                     [this, watcher](int value) {
+                         emit m_window->sceneLoadProgress(value, watcher->progressText());
+                     });
+    QObject::connect(watcher, &QFutureWatcherBase::progressTextChanged, m_window,
+                     [this, watcher](const QString& text) {
+                         emit m_window->sceneLoadProgress(watcher->progressValue(), text);
+                     });
+    QObject::connect(watcher, &QFutureWatcherBase::finished, m_window,
+                     [this]() { onSceneLoadFinished(); });
+    watcher->setFuture(QtConcurrent::run(runSceneLoad, request));
+
+    emit m_window->sceneLoadStarted(filePath);
+}
 
-        // Show dialog and process events to ensure it's displayed
-        progressDialog->show();
-        progressDialog->raise();
-        progressDialog->activateWindow();
-        QApplication::processEvents();
+void QuantiloomVulkanRenderer::cancelSceneLoad() {
+    m_queuedScenePath.clear();
+    if (m_loadCancelFlag) {
+        m_loadCancelFlag->store(true);
+    }
+}
+
+void QuantiloomVulkanRenderer::waitForSceneLoad() {
+    if (!m_loadWatcher) {
+        return;
+    }
+    m_loadWatcher->disconnect();
+    m_loadWatcher->waitForFinished();
+    m_loadWatcher.reset();
+}
+
+void QuantiloomVulkanRenderer::onSceneLoadFinished() {
+    if (!m_loadWatcher) {
+        return;
     }
 
-    // Determine file type and call appropriate loader
-    std::string path = filePath.toStdString();
-    quantiloom::Result<void, quantiloom::String> result;
+    SceneLoadResultPtr result;
+    if (m_loadWatcher->future().resultCount() > 0) {
+        result = m_loadWatcher->result();
+    }
+    if (!result) {
+        result = std::make_shared<SceneLoadResult>();
+        result->error = QObject::tr("Scene loading failed");
+    }
 
-    if (filePath.endsWith(".usd", Qt::CaseInsensitive) ||
-        filePath.endsWith(".usda", Qt::CaseInsensitive) ||
-        filePath.endsWith(".usdc", Qt::CaseInsensitive) ||
-        filePath.endsWith(".usdz", Qt::CaseInsensitive)) {
-        qDebug() << "  Calling LoadSceneFromUsd...";
-        result = m_renderContext->LoadSceneFromUsd(path);
+    // Still inside the watcher's signal; delete it later
+    m_loadWatcher.release()->deleteLater();
+
+    // Swap at the next frame boundary, or finish the held frame now
+    m_completedLoad = std::move(result);
+    if (m_frameHeld) {
+        // Qt is still waiting on that frame; its scheduler and profiler
+        // bookkeeping already ran, so only swap and record it (a queued
+        // in-place load holds it again)
+        m_frameHeld = false;
+        completeSceneLoad();
+        recordFrame();
     } else {
-        qDebug() << "  Calling LoadSceneFromGltf...";
-        result = m_renderContext->LoadSceneFromGltf(path);
+        m_scheduler.request(FrameWakeReason::Scene);
     }
+}
 
-    // Close progress dialog
-    if (progressDialog) {
-        progressDialog->close();
-        progressDialog->deleteLater();
+void QuantiloomVulkanRenderer::completeSceneLoad() {
+    SceneLoadResultPtr result = std::move(m_completedLoad);
+    m_sceneLoading = false;
+    m_contextBusy = false;
+    m_loadCancelFlag.reset();
+    m_loadingScenePath.clear();
+
+    bool needsResize = m_resizePending;
+    m_resizePending = false;
+
+    if (result->success && result->context) {
+        // In-flight frames may still reference the old context's resources
+        QVulkanDeviceFunctions* df = m_window->vulkanInstance()->deviceFunctions(m_window->device());
+        df->vkDeviceWaitIdle(m_window->device());
+
+        m_renderContext = std::move(result->context);
+        m_contextSize = QSize();
+        m_liveQueueIndex = result->queueIndex;
+        needsResize = true;  // Swapchain may have changed since the request
+        qDebug() << "  Swapped in new render context (queue" << m_liveQueueIndex << ")";
     }
 
-    qDebug() << "  Scene load returned";
+    if (needsResize) {
+        resizeContextToTarget();
+    }
 
-    if (result) {
+    if (result->success) {
         qDebug() << "  Scene loaded successfully!";
-        m_currentScenePath = filePath;  // Save for restore after minimize
+        m_pendingNodeTransforms.clear();  // Node indices referred to the old scene
+        m_pendingMaterials.clear();
+        m_currentScenePath = result->scenePath;  // Save for restore after minimize
+
+        // Re-apply stored render settings (new context, or restore after minimize)
+        applyRenderState();
 
-        // Re-apply stored render settings (important for restore after minimize)
-        if (m_hasLightingParams) {
-            qDebug() << "  Re-applying stored LightingParams";
-            m_renderContext->SetLightingParams(m_lightingParams);
+        // Environment map requested while the worker was busy
+        if (!m_environmentMapPath.isEmpty() && m_environmentMapPath != result->environmentMapPath) {
+            loadEnvironmentMap(m_environmentMapPath);
         }
-        m_renderContext->SetSpectralMode(m_spectralMode);
-        m_renderContext->SetDebugMode(m_debugMode);
-        m_renderContext->SetSPP(m_targetSPP);
-        m_renderContext->SetWavelength(m_wavelength);
 
         resetAccumulation();
-        emit m_window->sceneLoaded(true, QObject::tr("Scene loaded successfully"));
+        emit m_window->sceneLoaded(true,
+            (result->fromCache ? QObject::tr("Scene loaded from cache (%1 meshes, %2 textures)")
+                               : QObject::tr("Scene loaded (%1 meshes, %2 textures)"))
+                .arg(result->meshCount).arg(result->textureCount));
+    } else if (result->canceled) {
+        qDebug() << "  Scene load canceled";
+        emit m_window->sceneLoadCanceled();
     } else {
-        qCritical() << "  Failed to load scene:" << QString::fromStdString(result.error());
-        emit m_window->sceneLoaded(false,
-            QObject::tr("Failed to load scene: %1").arg(QString::fromStdString(result.error())));
+        qCritical() << "  Failed to load scene:" << result->error;
+        emit m_window->sceneLoaded(false, result->error);
+    }
+
+    // A newer request arrived while this one was running
+    if (!m_queuedScenePath.isEmpty()) {
+        QString next = m_queuedScenePath;
+        m_queuedScenePath.clear();
+        startSceneLoad(next);
+    }
+}
+
+void QuantiloomVulkanRenderer::applyRenderState() {
+    if (m_hasLightingParams) {
+        qDebug() << "  Re-applying stored LightingParams";
+        m_renderContext->SetLightingParams(m_lightingParams);
+    }
+    m_renderContext->SetSpectralMode(m_spectralMode);
+    m_renderContext->SetDebugMode(m_debugMode);
+    m_renderContext->SetSPP(m_frameSpp);
+    m_renderContext->SetWavelength(m_wavelength);
+    m_renderContext->SetAtmosphericConfig(m_atmosphericConfig);
+    m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
+    m_renderContext->SetCameraFOV(m_cameraFovY);
+
+    quantiloom::ExternalRenderContext::CLAHEParams clahe;
+    clahe.enabled = m_displayEnhancementEnabled;
+    clahe.clipLimit = m_claheClipLimit;
+    clahe.tileSize = m_claheTileSize;
+    clahe.luminanceOnly = m_claheLuminanceOnly;
+    clahe.normalizeOutput = true;
+    m_renderContext->SetCLAHEParams(clahe);
+
+    // Queued parameters are covered; a queued reset still applies
+    m_pendingChanges &= ~static_cast<uint32_t>(PendingParameterMask);
+}
+
+// ============================================================================
+// Final Render
+// ============================================================================
+
+bool QuantiloomVulkanRenderer::startFinalRender(const QString& outputPath, uint32_t width,
+                                                uint32_t height, uint32_t spp, QString* error) {
+    const auto fail = [error](const QString& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    if (m_finalRenderJob) {
+        return fail(QObject::tr("A final render is already running"));
+    }
+    if (m_sceneLoading) {
+        return fail(QObject::tr("Wait for the scene to finish loading"));
+    }
+    if (!contextReady() || !m_renderContext->HasScene() || m_currentScenePath.isEmpty()) {
+        return fail(QObject::tr("No scene loaded"));
+    }
+    if (outputPath.isEmpty() || width == 0 || height == 0 || spp == 0) {
+        return fail(QObject::tr("Invalid final render settings"));
+    }
+
+    // Snapshot must include edits still waiting for the next frame
+    flushNodeTransforms();
+    flushMaterials();
+
+    FinalRenderSettings settings;
+    settings.scenePath = m_currentScenePath;
+    settings.environmentMapPath = m_renderContext->HasEnvironmentMap() ? m_environmentMapPath : QString();
+    settings.outputPath = outputPath;
+    settings.width = width;
+    settings.height = height;
+    settings.targetSpp = spp;
+    settings.frameSpp = m_targetSPP;  // Configured SPP, not the adaptive preview value
+    settings.spectralMode = m_spectralMode;
+    settings.wavelength = m_wavelength;
+    settings.lighting = m_lightingParams;
+    settings.hasLightingParams = m_hasLightingParams;
+    settings.atmosphericConfig = m_atmosphericConfig;
+    settings.cameraPosition = m_cameraPosition;
+    settings.cameraTarget = m_cameraTarget;
+    settings.cameraUp = m_cameraUp;
+    settings.cameraFovY = m_cameraFovY;
+    if (const auto* scene = m_renderContext->GetScene()) {
+        settings.materials = scene->materials;
+        settings.nodeTransforms.reserve(scene->nodes.size());
+        for (const auto& node : scene->nodes) {
+            settings.nodeTransforms.push_back(node.transform);
+        }
+    }
+
+    // A queue nobody on the GUI thread submits to lets the job run on a worker
+    int jobQueue = -1;
+    for (int i = 1; i < m_queues.size(); ++i) {
+        if (i != m_liveQueueIndex) {
+            jobQueue = i;
+            break;
+        }
+    }
+    const bool sharedQueue = jobQueue < 0;
+    // The job sets its own output size
+    const auto params = makeInitParams(m_window, m_queues[sharedQueue ? 0 : jobQueue],
+                                       targetRenderSize(), m_pipelineCache.directory());
+
+    auto* job = new FinalRenderJob(std::move(settings), params, sharedQueue);
+    m_finalRenderJob = job;
+    m_finalRenderReceiver = std::make_unique<QObject>();
+    QObject* receiver = m_finalRenderReceiver.get();
+
+    QObject::connect(job, &FinalRenderJob::statusChanged, receiver,
+                     [this, job](const QString& status) {
+                         if (job == m_finalRenderJob) {
+                             emit m_window->finalRenderStatus(status);
+                         }
+                     });
+    QObject::connect(job, &FinalRenderJob::progressChanged, receiver,
+                     [this, job](uint32_t samples, uint32_t target, double samplesPerSecond) {
+                         if (job == m_finalRenderJob) {
+                             emit m_window->finalRenderProgress(samples, target, samplesPerSecond);
+                         }
+                     });
+    QObject::connect(job, &FinalRenderJob::pausedChanged, receiver,
+                     [this, job](bool paused) {
+                         if (job == m_finalRenderJob) {
+                             emit m_window->finalRenderPaused(paused);
+                         }
+                     });
+    QObject::connect(job, &FinalRenderJob::finished, receiver,
+                     [this, job](bool success, const QString& message) {
+                         if (job == m_finalRenderJob) {
+                             onFinalRenderFinished(success, message);
+                         }
+                     });
+
+    if (sharedQueue) {
+        qDebug() << "Final render: sharing queue 0 with the preview (GUI thread slices)";
+    } else {
+        qDebug() << "Final render: worker thread on queue" << jobQueue;
+        m_finalRenderThread = std::make_unique<QThread>();
+        m_finalRenderThread->setObjectName(QStringLiteral("FinalRender"));
+        job->moveToThread(m_finalRenderThread.get());
+        m_finalRenderThread->start();
+    }
+
+    job->start();
+    return true;
+}
+
+void QuantiloomVulkanRenderer::setFinalRenderPaused(bool paused) {
+    if (!m_finalRenderJob) {
+        return;
     }
+    if (paused) {
+        m_finalRenderJob->pause();
+    } else {
+        m_finalRenderJob->resume();
+    }
+}
+
+void QuantiloomVulkanRenderer::stopFinalRender() {
+    if (m_finalRenderJob) {
+        // Reported through finished() once the job has released its resources
+        m_finalRenderJob->cancel();
+    }
+}
+
+void QuantiloomVulkanRenderer::onFinalRenderFinished(bool success, const QString& message) {
+    // Called from the job's finished() signal: the job (and, when sharing the
+    // GUI thread, its call stack) is still live, so tear down asynchronously.
+    FinalRenderJob* job = m_finalRenderJob;
+    m_finalRenderJob = nullptr;
+    m_finalRenderReceiver.release()->deleteLater();
+
+    if (m_finalRenderThread) {
+        QThread* thread = m_finalRenderThread.release();
+        QObject::connect(thread, &QThread::finished, job, &QObject::deleteLater);
+        QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+        thread->quit();
+    } else {
+        job->deleteLater();
+    }
+
+    emit m_window->finalRenderFinished(success, message);
+    m_scheduler.request(FrameWakeReason::Job);
+}
+
+void QuantiloomVulkanRenderer::destroyFinalRender() {
+    if (!m_finalRenderJob) {
+        return;
+    }
+
+    // Synchronous teardown (window resources released or renderer destroyed).
+    // Dropping the receiver disconnects the job and discards its queued signals.
+    FinalRenderJob* job = m_finalRenderJob;
+    m_finalRenderJob = nullptr;
+    m_finalRenderReceiver.reset();
+
+    if (m_finalRenderThread) {
+        // Stop the timer and release the context on the job's own thread
+        QMetaObject::invokeMethod(job, &FinalRenderJob::cancel, Qt::BlockingQueuedConnection);
+        m_finalRenderThread->quit();
+        m_finalRenderThread->wait();
+        m_finalRenderThread.reset();
+    } else {
+        job->cancel();
+    }
+    delete job;
 }
 
 void QuantiloomVulkanRenderer::resetCamera() {
@@ -302,10 +990,7 @@ void QuantiloomVulkanRenderer::resetCamera() {
     m_orbitYaw = 0.0f;
     m_orbitPitch = 0.0f;
 
-    if (m_renderContext) {
-        m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingCamera, true);
 }
 
 void QuantiloomVulkanRenderer::setCamera(const glm::vec3& position, const glm::vec3& lookAt,
@@ -323,11 +1008,7 @@ void QuantiloomVulkanRenderer::setCamera(const glm::vec3& position, const glm::v
     m_orbitPitch = glm::degrees(std::asin(dir.y));
     m_orbitYaw = glm::degrees(std::atan2(dir.x, dir.z));
 
-    if (m_renderContext) {
-        m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-        m_renderContext->SetCameraFOV(fovY);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingCamera | PendingCameraFov, true);
 
     qDebug() << "Camera set: pos=(" << position.x << "," << position.y << "," << position.z
              << ") lookAt=(" << lookAt.x << "," << lookAt.y << "," << lookAt.z
@@ -336,53 +1017,83 @@ void QuantiloomVulkanRenderer::setCamera(const glm::vec3& position, const glm::v
 
 void QuantiloomVulkanRenderer::setSPP(uint32_t spp) {
     m_targetSPP = spp;
-    if (m_renderContext) {
-        m_renderContext->SetSPP(spp);
+    m_adaptiveSpp.setMaxSpp(spp);
+    m_frameSpp = m_adaptiveSppEnabled ? m_adaptiveSpp.currentSpp() : spp;
+    queueParameterChange(PendingSpp, false);
+}
+
+void QuantiloomVulkanRenderer::setAdaptiveSpp(bool enabled, float budgetMs) {
+    m_adaptiveSpp.setBudgetMs(budgetMs);
+    m_adaptiveSpp.setMaxSpp(m_targetSPP);
+    if (enabled != m_adaptiveSppEnabled) {
+        m_adaptiveSppEnabled = enabled;
+        m_adaptiveSpp.reset();
+        m_frameSpp = enabled ? m_adaptiveSpp.currentSpp() : m_targetSPP;
+        queueParameterChange(PendingSpp, false);
     }
+
+    qDebug() << "Adaptive SPP" << (enabled ? "enabled" : "disabled")
+             << "- budget" << budgetMs << "ms, max" << m_targetSPP << "SPP";
 }
 
 void QuantiloomVulkanRenderer::setWavelength(float wavelength_nm) {
     m_wavelength = wavelength_nm;
-    if (m_renderContext) {
-        m_renderContext->SetWavelength(wavelength_nm);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingWavelength, true);
 }
 
 void QuantiloomVulkanRenderer::setSpectralMode(quantiloom::SpectralMode mode) {
     m_spectralMode = mode;  // Store for restore
-    if (m_renderContext) {
-        m_renderContext->SetSpectralMode(mode);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingSpectralMode, true);
 }
 
 void QuantiloomVulkanRenderer::setDebugMode(quantiloom::DebugVisualizationMode mode) {
     m_debugMode = mode;  // Store for restore
-    if (m_renderContext) {
-        m_renderContext->SetDebugMode(mode);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingDebugMode, true);
 }
 
 void QuantiloomVulkanRenderer::setLightingParams(const quantiloom::LightingParams& params) {
     m_lightingParams = params;  // Store for restore
     m_hasLightingParams = true;
-    if (m_renderContext) {
-        m_renderContext->SetLightingParams(params);
-        resetAccumulation();
+    queueParameterChange(PendingLighting, true);
+}
+
+void QuantiloomVulkanRenderer::updateMaterial(int index, const quantiloom::Material& updated) {
+    if (!material(index)) {
+        return;
     }
+    m_pendingMaterials.insert(index, updated);
+    markInteraction();
+    m_scheduler.request(FrameWakeReason::Input);
 }
 
-void QuantiloomVulkanRenderer::updateMaterial(int index, const quantiloom::Material& material) {
-    if (m_renderContext && index >= 0) {
-        m_renderContext->UpdateMaterial(static_cast<quantiloom::u32>(index), material);
-        resetAccumulation();
+const quantiloom::Material* QuantiloomVulkanRenderer::material(int index) const {
+    const auto* scene = getScene();
+    if (!scene || index < 0 || static_cast<size_t>(index) >= scene->materials.size()) {
+        return nullptr;
     }
+    auto it = m_pendingMaterials.constFind(index);
+    return it != m_pendingMaterials.cend() ? &it.value()
+                                           : &scene->materials[static_cast<size_t>(index)];
+}
+
+bool QuantiloomVulkanRenderer::flushMaterials() {
+    if (m_pendingMaterials.isEmpty() || !contextReady()) {
+        return false;
+    }
+
+    QHash<int, quantiloom::Material> pending;
+    pending.swap(m_pendingMaterials);
+
+    waitForGraphicsQueue();
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        m_renderContext->UpdateMaterial(static_cast<quantiloom::u32>(it.key()), it.value());
+    }
+    resetAccumulation();
+    return true;
 }
 
 const quantiloom::Scene* QuantiloomVulkanRenderer::getScene() const {
-    return m_renderContext ? m_renderContext->GetScene() : nullptr;
+    return contextReady() ? m_renderContext->GetScene() : nullptr;
 }
 
 void QuantiloomVulkanRenderer::getCameraInfo(glm::vec3& position, glm::vec3& forward,
@@ -404,6 +1115,11 @@ void QuantiloomVulkanRenderer::updateCameraMovement(
     m_moveUp = up;
     m_moveDown = down;
     m_moveFast = fast;
+
+    // Movement is applied per frame; make sure frames are coming
+    if (forward || backward || left || right || up || down) {
+        m_scheduler.request(FrameWakeReason::Input);
+    }
 }
 
 void QuantiloomVulkanRenderer::orbitCamera(float deltaX, float deltaY) {
@@ -423,10 +1139,7 @@ void QuantiloomVulkanRenderer::orbitCamera(float deltaX, float deltaY) {
 
     m_cameraPosition = m_cameraTarget + glm::vec3(x, y, z);
 
-    if (m_renderContext) {
-        m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingCamera, true);
 }
 
 void QuantiloomVulkanRenderer::panCamera(float deltaX, float deltaY) {
@@ -440,10 +1153,7 @@ void QuantiloomVulkanRenderer::panCamera(float deltaX, float deltaY) {
     m_cameraPosition += pan;
     m_cameraTarget += pan;
 
-    if (m_renderContext) {
-        m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingCamera, true);
 }
 
 void QuantiloomVulkanRenderer::zoomCamera(float delta) {
@@ -459,10 +1169,7 @@ void QuantiloomVulkanRenderer::zoomCamera(float delta) {
 
     m_cameraPosition = m_cameraTarget + glm::vec3(x, y, z);
 
-    if (m_renderContext) {
-        m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-        resetAccumulation();
-    }
+    queueParameterChange(PendingCamera, true);
 }
 
 void QuantiloomVulkanRenderer::updateCamera(float deltaTime) {
@@ -490,44 +1197,194 @@ void QuantiloomVulkanRenderer::updateCamera(float deltaTime) {
         m_cameraPosition += movement;
         m_cameraTarget += movement;
 
-        if (m_renderContext) {
-            m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
-            resetAccumulation();
-        }
+        queueParameterChange(PendingCamera, true);
     }
 }
 
+void QuantiloomVulkanRenderer::queueNodeTransform(int nodeIndex, const glm::mat4& transform) {
+    if (nodeIndex < 0) {
+        return;
+    }
+    m_pendingNodeTransforms.insert(nodeIndex, transform);
+    markInteraction();
+    m_scheduler.request(FrameWakeReason::Input);
+}
+
+bool QuantiloomVulkanRenderer::flushNodeTransforms() {
+    if (m_pendingNodeTransforms.isEmpty() || !contextReady()) {
+        return false;
+    }
+
+    QHash<int, glm::mat4> pending;
+    pending.swap(m_pendingNodeTransforms);
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        m_renderContext->SetNodeTransform(static_cast<quantiloom::u32>(it.key()), it.value());
+    }
+    waitForGraphicsQueue();
+    m_renderContext->RebuildAccelerationStructure();
+    resetAccumulation();
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        emit m_window->nodeTransformChanged(it.key(), it.value());
+    }
+    return true;
+}
+
+void QuantiloomVulkanRenderer::commitEdits() {
+    // Both queue an accumulation reset; the next frame applies just one
+    flushNodeTransforms();
+    flushMaterials();
+}
+
 void QuantiloomVulkanRenderer::resetAccumulation() {
-    m_sampleCount = 0;
-    if (m_renderContext) {
+    queueParameterChange(0, true);
+}
+
+void QuantiloomVulkanRenderer::queueParameterChange(uint32_t changes, bool resetsAccumulation) {
+    if (changes & PendingCamera) {
+        markInteraction();
+    }
+
+    const uint32_t parameters = changes & PendingParameterMask;
+    m_parameterStats.updatesQueued += std::popcount(parameters);
+    m_parameterStats.updatesCoalesced += std::popcount(parameters & m_pendingChanges);
+    m_pendingChanges |= parameters;
+
+    if (resetsAccumulation) {
+        ++m_parameterStats.resetsRequested;
+        m_pendingChanges |= PendingAccumulationReset;
+        m_sampleCount = 0;
+    }
+
+    m_scheduler.request((changes & PendingCamera) ? FrameWakeReason::Input
+                                                  : FrameWakeReason::Parameters);
+}
+
+void QuantiloomVulkanRenderer::applyPendingParameters() {
+    // Kept pending while a worker owns the context (or none exists yet)
+    if (m_pendingChanges == 0 || !contextReady()) {
+        return;
+    }
+
+    const uint32_t changes = std::exchange(m_pendingChanges, 0u);
+
+    if (changes & PendingCamera) {
+        m_renderContext->SetCameraLookAt(m_cameraPosition, m_cameraTarget, m_cameraUp);
+    }
+    if (changes & PendingCameraFov) {
+        m_renderContext->SetCameraFOV(m_cameraFovY);
+    }
+    if (changes & PendingSpp) {
+        m_renderContext->SetSPP(m_frameSpp);
+    }
+    if (changes & PendingWavelength) {
+        m_renderContext->SetWavelength(m_wavelength);
+    }
+    if (changes & PendingSpectralMode) {
+        m_renderContext->SetSpectralMode(m_spectralMode);
+    }
+    if (changes & PendingDebugMode) {
+        m_renderContext->SetDebugMode(m_debugMode);
+    }
+    if ((changes & PendingLighting) && m_hasLightingParams) {
+        m_renderContext->SetLightingParams(m_lightingParams);
+    }
+    if (changes & PendingAtmosphere) {
+        m_renderContext->SetAtmosphericConfig(m_atmosphericConfig);
+    }
+    if (changes & PendingClahe) {
+        quantiloom::ExternalRenderContext::CLAHEParams params;
+        params.enabled = m_displayEnhancementEnabled;
+        params.clipLimit = m_claheClipLimit;
+        params.tileSize = m_claheTileSize;
+        params.luminanceOnly = m_claheLuminanceOnly;
+        params.normalizeOutput = true;
+        m_renderContext->SetCLAHEParams(params);
+    }
+    m_parameterStats.updatesApplied += std::popcount(changes & PendingParameterMask);
+
+    if (changes & PendingAccumulationReset) {
         m_renderContext->ResetAccumulation();
+        m_sampleCount = 0;
+        m_convergence.reset();
+        ++m_parameterStats.resetsApplied;
+    }
+    ++m_parameterStats.framesWithChanges;
+}
+
+void QuantiloomVulkanRenderer::setConvergenceSettings(const ConvergenceSettings& settings) {
+    m_convergence.setSettings(settings);  // Also clears a converged state
+    m_scheduler.request(FrameWakeReason::Parameters);
+
+    qDebug() << "Convergence auto-stop" << (settings.enabled ? "enabled" : "disabled")
+             << "- threshold" << settings.threshold << ", max" << settings.maxSamples << "samples";
+}
+
+void QuantiloomVulkanRenderer::checkConvergence() {
+    if (!m_convergence.isCheckpointDue(m_sampleCount)) {
+        return;
+    }
+
+    const QSize size = m_window->swapChainImageSize();
+    const bool converged = m_convergence.checkpoint(
+        m_sampleCount, size.width(), size.height(),
+        [this](int x, int y, glm::vec4& value) { return readBudgetedPixel(x, y, value); },
+        m_pixelReadBudget);
+    if (converged) {
+        qDebug() << "Accumulation converged at" << m_sampleCount << "samples (relative change"
+                 << m_convergence.lastRelativeChange() << ")";
+        emit m_window->accumulationConverged(m_sampleCount, m_convergence.lastRelativeChange());
+    }
+}
+
+void QuantiloomVulkanRenderer::markInteraction() {
+    m_lastInteraction = std::chrono::steady_clock::now();
+}
+
+void QuantiloomVulkanRenderer::updateAdaptiveSpp() {
+    if (!m_adaptiveSppEnabled) {
+        return;
+    }
+
+    // GPU time isolates the trace cost; the interval is a vsync-bound fallback
+    double frameMs = 0.0;
+    uint32_t measuredSpp = 0;
+    if (m_profiler.takeLatestGpuFrame(frameMs, measuredSpp)) {
+        m_adaptiveSpp.addMeasurement(frameMs, measuredSpp);
+    } else if (!m_profiler.hasGpuTimer() && m_profiler.lastIntervalMs() > 0.0) {
+        m_adaptiveSpp.addMeasurement(m_profiler.lastIntervalMs(), m_frameSpp);
+    }
+
+    const bool interacting =
+        std::chrono::steady_clock::now() - m_lastInteraction < kInteractionHold;
+    const uint32_t spp = m_adaptiveSpp.update(interacting);
+    if (spp != m_frameSpp) {
+        // Internal change: bypasses the queue counters meant for user edits
+        m_frameSpp = spp;
+        m_pendingChanges |= PendingSpp;
     }
 }
 
 bool QuantiloomVulkanRenderer::isFirstRun() const {
-    // Check if pipeline cache file exists
-    // If it doesn't exist, this is the first run and shader compilation will be slow
-    //
-    // Cache location follows platform conventions:
-    //   Windows: %LOCALAPPDATA%/Quantiloom/cache/pipeline_cache.bin
-    //   Linux:   ~/.cache/Quantiloom/pipeline_cache.bin
-    //   macOS:   ~/Library/Caches/Quantiloom/pipeline_cache.bin
-    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-#ifdef Q_OS_WIN
-    // Windows: QStandardPaths returns %LOCALAPPDATA%, add /Quantiloom/cache
-    QString cachePath = cacheDir + "/Quantiloom/cache/pipeline_cache.bin";
-#else
-    // Linux/macOS: QStandardPaths returns ~/.cache or ~/Library/Caches
-    QString cachePath = cacheDir + "/Quantiloom/pipeline_cache.bin";
-#endif
-    return !QFileInfo::exists(cachePath);
+    // Pipelines compile from scratch only until one context has been created
+    // against the (validated) cache for this device
+    return m_pipelineCache.needsWarmup() && m_pipelineCache.stats().warmupMs < 0.0;
 }
 
 bool QuantiloomVulkanRenderer::readDebugPixel(int x, int y, glm::vec4& outValue) {
-    if (!m_renderContext) {
+    if (!contextReady()) {
         return false;
     }
 
+    // Callers work in swapchain pixels; the accumulation is at the render size
+    const QSize swapSize = m_window->swapChainImageSize();
+    if (!swapSize.isEmpty() && swapSize != m_contextSize) {
+        x = std::clamp(x * m_contextSize.width() / swapSize.width(), 0, m_contextSize.width() - 1);
+        y = std::clamp(y * m_contextSize.height() / swapSize.height(), 0, m_contextSize.height() - 1);
+    }
+
+    waitForGraphicsQueue();
     auto result = m_renderContext->ReadPixelValue(
         static_cast<quantiloom::u32>(x),
         static_cast<quantiloom::u32>(y)
@@ -541,6 +1398,58 @@ bool QuantiloomVulkanRenderer::readDebugPixel(int x, int y, glm::vec4& outValue)
     return false;
 }
 
+bool QuantiloomVulkanRenderer::readBudgetedPixel(int x, int y, glm::vec4& outValue) {
+    --m_pixelReadBudget;
+    return readDebugPixel(x, y, outValue);
+}
+
+void QuantiloomVulkanRenderer::requestHoverProbe(int x, int y) {
+    m_hoverProbe.request(x, y);
+    m_scheduler.request(FrameWakeReason::Capture);
+}
+
+void QuantiloomVulkanRenderer::serviceHoverProbe() {
+    if (!m_hoverProbe.hasWork()) {
+        return;
+    }
+
+    const QSize size = m_window->swapChainImageSize();
+    HoverProbeResult result;
+    if (m_hoverProbe.service(m_sampleCount, size.width(), size.height(),
+                             [this](int x, int y, glm::vec4& value) {
+                                 return readBudgetedPixel(x, y, value);
+                             },
+                             result, m_pixelReadBudget)) {
+        emit m_window->hoverProbed(result);
+    }
+}
+
+void QuantiloomVulkanRenderer::setRoi(const QRect& region) {
+    m_roiStatistics.setRegion(region);
+    m_scheduler.request(FrameWakeReason::Capture);
+}
+
+void QuantiloomVulkanRenderer::setRoiChannel(RoiChannel channel) {
+    m_roiStatistics.setChannel(channel);
+    m_scheduler.request(FrameWakeReason::Capture);
+}
+
+void QuantiloomVulkanRenderer::serviceRoiStatistics() {
+    if (!m_roiStatistics.hasWork(m_sampleCount)) {
+        return;
+    }
+
+    const QSize size = m_window->swapChainImageSize();
+    RoiStats stats;
+    if (m_roiStatistics.service(m_sampleCount, size.width(), size.height(),
+                                [this](int x, int y, glm::vec4& value) {
+                                    return readBudgetedPixel(x, y, value);
+                                },
+                                stats, m_pixelReadBudget)) {
+        emit m_window->roiStatisticsUpdated(stats);
+    }
+}
+
 QString QuantiloomVulkanRenderer::formatDebugValue(const glm::vec4& v) const {
     using quantiloom::DebugVisualizationMode;
 
@@ -645,10 +1554,11 @@ QString QuantiloomVulkanRenderer::formatDebugValue(const glm::vec4& v) const {
 }
 
 std::unique_ptr<quantiloom::Image> QuantiloomVulkanRenderer::captureScreenshot() {
-    if (!m_renderContext) {
+    if (!contextReady()) {
         return nullptr;
     }
 
+    waitForGraphicsQueue();
     auto result = m_renderContext->CaptureScreenshot();
     if (!result.has_value()) {
         qWarning() << "Screenshot capture failed:" << QString::fromStdString(result.error());
@@ -659,10 +1569,11 @@ std::unique_ptr<quantiloom::Image> QuantiloomVulkanRenderer::captureScreenshot()
 }
 
 std::unique_ptr<quantiloom::Image> QuantiloomVulkanRenderer::captureDisplayImage() {
-    if (!m_renderContext) {
+    if (!contextReady()) {
         return nullptr;
     }
 
+    waitForGraphicsQueue();
     auto result = m_renderContext->CaptureDisplayImage();
     if (!result.has_value()) {
         qWarning() << "Display image capture failed:" << QString::fromStdString(result.error());
@@ -672,41 +1583,88 @@ std::unique_ptr<quantiloom::Image> QuantiloomVulkanRenderer::captureDisplayImage
     return std::make_unique<quantiloom::Image>(std::move(result.value()));
 }
 
+void QuantiloomVulkanRenderer::captureDisplayImageAsync(AsyncReadbackRing::Callback callback) {
+    if (!callback) {
+        return;
+    }
+    if (!m_readback.isValid() || !m_window->supportsGrab() ||
+        !AsyncReadbackRing::isFormatSupported(m_window->colorFormat())) {
+        qWarning() << "Async capture unavailable (swapchain not readable or format"
+                   << m_window->colorFormat() << "unsupported)";
+        callback(QImage());
+        return;
+    }
+
+    m_readbackRequests.push_back(std::move(callback));
+    m_scheduler.request(FrameWakeReason::Capture);
+}
+
+void QuantiloomVulkanRenderer::recordDisplayReadback(VkCommandBuffer cmd, int frameSlot,
+                                                     VkImage image, const QSize& size) {
+    if (m_readbackRequests.empty()) {
+        return;
+    }
+
+    // One copy serves every request made since the last frame
+    auto requests = std::make_shared<std::vector<AsyncReadbackRing::Callback>>(
+        std::exchange(m_readbackRequests, {}));
+    const bool recorded = m_readback.recordCopy(
+        cmd, frameSlot, image, m_window->colorFormat(),
+        static_cast<uint32_t>(size.width()), static_cast<uint32_t>(size.height()),
+        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,  // RenderFrame leaves the swapchain image ready to present
+        [requests](const QImage& captured) {
+            for (const auto& callback : *requests) {
+                callback(captured);
+            }
+        });
+
+    if (!recorded) {
+        // Slot still busy (should not happen) or staging allocation failed: retry next frame
+        m_readbackRequests = std::move(*requests);
+    }
+}
+
+void QuantiloomVulkanRenderer::captureSequenceFrame() {
+    if (!m_sequenceCapture || !m_sequenceCapture->shouldCapture(m_sampleCount)) {
+        return;
+    }
+
+    const int index = m_sequenceCapture->beginCapture();
+    if (m_sequenceCapture->settings().format == ImageExportFormat::EXR) {
+        // HDR values are only available through the SDK's synchronous capture
+        m_sequenceCapture->submit(index, captureScreenshot());
+        return;
+    }
+
+    QPointer<SequenceCapture> sequence = m_sequenceCapture;
+    captureDisplayImageAsync([sequence, index](const QImage& image) {
+        if (sequence) {
+            sequence->submit(index, image);
+        }
+    });
+}
+
+void QuantiloomVulkanRenderer::failDisplayReadbacks() {
+    for (const auto& callback : std::exchange(m_readbackRequests, {})) {
+        callback(QImage());
+    }
+}
+
 // ============================================================================
 // Atmospheric Configuration
 // ============================================================================
 
 void QuantiloomVulkanRenderer::setAtmosphericPreset(const QString& preset) {
     m_atmosphericPreset = preset;
-    std::string presetStr = preset.toLower().toStdString();
-
-    if (presetStr == "clear_day") {
-        m_atmosphericConfig = quantiloom::AtmosphericConfig::ClearDay();
-    } else if (presetStr == "hazy") {
-        m_atmosphericConfig = quantiloom::AtmosphericConfig::Hazy();
-    } else if (presetStr == "polluted_urban") {
-        m_atmosphericConfig = quantiloom::AtmosphericConfig::PollutedUrban();
-    } else if (presetStr == "mountain_top") {
-        m_atmosphericConfig = quantiloom::AtmosphericConfig::MountainTop();
-    } else if (presetStr == "mars") {
-        m_atmosphericConfig = quantiloom::AtmosphericConfig::Mars();
-    } else {
-        m_atmosphericConfig = quantiloom::AtmosphericConfig::Disabled();
-    }
-
-    if (m_renderContext) {
-        m_renderContext->SetAtmosphericConfig(m_atmosphericConfig);
-    }
+    m_atmosphericConfig = ConfigManager::atmosphericConfigForPreset(preset);
+    queueParameterChange(PendingAtmosphere, false);
 
     qDebug() << "Atmospheric preset set to:" << preset;
 }
 
 void QuantiloomVulkanRenderer::setAtmosphericConfig(const quantiloom::AtmosphericConfig& config) {
     m_atmosphericConfig = config;
-
-    if (m_renderContext) {
-        m_renderContext->SetAtmosphericConfig(m_atmosphericConfig);
-    }
+    queueParameterChange(PendingAtmosphere, false);
 }
 
 // ============================================================================
@@ -714,18 +1672,27 @@ void QuantiloomVulkanRenderer::setAtmosphericConfig(const quantiloom::Atmospheri
 // ============================================================================
 
 bool QuantiloomVulkanRenderer::loadEnvironmentMap(const QString& hdrPath) {
-    if (!m_renderContext) {
-        qWarning() << "Cannot load environment map: render context not initialized";
+    if (hdrPath.isEmpty()) {
+        qWarning() << "Empty environment map path";
         return false;
     }
 
-    if (hdrPath.isEmpty()) {
-        qWarning() << "Empty environment map path";
+    // Remembered so scene loads (new contexts) get the same environment
+    m_environmentMapPath = hdrPath;
+
+    if (m_sceneLoading) {
+        qDebug() << "Environment map deferred until scene load completes:" << hdrPath;
+        return true;
+    }
+
+    if (!m_renderContext) {
+        qWarning() << "Cannot load environment map: render context not initialized";
         return false;
     }
 
     qDebug() << "Loading environment map:" << hdrPath;
 
+    waitForGraphicsQueue();
     auto result = m_renderContext->LoadEnvironmentMap(hdrPath.toStdString());
     if (!result.has_value()) {
         qWarning() << "Failed to load environment map:"
@@ -734,11 +1701,12 @@ bool QuantiloomVulkanRenderer::loadEnvironmentMap(const QString& hdrPath) {
     }
 
     qDebug() << "Environment map loaded successfully";
+    resetAccumulation();  // Lighting changed; also wakes an idle viewport
     return true;
 }
 
 bool QuantiloomVulkanRenderer::hasEnvironmentMap() const {
-    return m_renderContext && m_renderContext->HasEnvironmentMap();
+    return contextReady() && m_renderContext->HasEnvironmentMap();
 }
 
 // ============================================================================
@@ -774,16 +1742,8 @@ void QuantiloomVulkanRenderer::setDisplayEnhancement(bool enabled, float clipLim
     m_claheTileSize = tileSize;
     m_claheLuminanceOnly = luminanceOnly;
 
-    // Pass CLAHE params to libQuantiloom for GPU processing
-    if (m_renderContext) {
-        quantiloom::ExternalRenderContext::CLAHEParams params;
-        params.enabled = enabled;
-        params.clipLimit = clipLimit;
-        params.tileSize = tileSize;
-        params.luminanceOnly = luminanceOnly;
-        params.normalizeOutput = true;
-        m_renderContext->SetCLAHEParams(params);
-    }
+    // Passed to libQuantiloom for GPU processing on the next frame
+    queueParameterChange(PendingClahe, false);
 
     qDebug() << "Display enhancement:" << (enabled ? "ENABLED" : "disabled")
              << "- CLAHE clip=" << clipLimit
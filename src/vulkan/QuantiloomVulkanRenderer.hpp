@@ -9,19 +9,44 @@
 
 #include <QVulkanWindowRenderer>
 #include <QString>
+#include <QSize>
 #include <QFuture>
+#include <QFutureWatcher>
+#include <QVector>
+#include <QHash>
+#include <QPointer>
+#include <atomic>
 #include <memory>
 #include <chrono>
+#include <vector>
+#include <vulkan/vulkan.h>
 
 #include <glm/glm.hpp>
 #include <core/Types.hpp>
 #include <renderer/LightingParams.hpp>
 #include <renderer/AtmosphericConfig.hpp>
+#include <scene/Material.hpp>
 #include <postprocess/SensorModel.hpp>
 #include <postprocess/GenericSensor.hpp>
 
+#include "ParameterQueueStats.hpp"
+#include "FrameProfiler.hpp"
+#include "AdaptiveSppController.hpp"
+#include "ConvergenceMonitor.hpp"
+#include "FrameScheduler.hpp"
+#include "AsyncReadbackRing.hpp"
+#include "HoverProbe.hpp"
+#include "RoiStatistics.hpp"
+#include "PipelineCacheManager.hpp"
+#include "RenderResolution.hpp"
+#include "export/SequenceCapture.hpp"
+
 class QuantiloomVulkanWindow;
 class QProgressDialog;
+class QThread;
+class QTimer;
+class FinalRenderJob;
+struct SceneLoadResult;
 
 namespace quantiloom {
 class ExternalRenderContext;
@@ -51,19 +76,168 @@ public:
     void startNextFrame() override;
 
     // Scene management
+    /**
+     * @brief Load a scene asynchronously
+     *
+     * Parsing, decoding and upload run on a worker thread; progress is
+     * reported through QuantiloomVulkanWindow::sceneLoadProgress and the
+     * result through sceneLoaded. A call while a load is running cancels
+     * it and loads the new file afterwards.
+     */
     void loadScene(const QString& filePath);
+
+    /**
+     * @brief Request cancellation of the running scene load
+     *
+     * Takes effect between load stages; the previous scene stays active.
+     */
+    void cancelSceneLoad();
+
+    /**
+     * @brief Check whether a scene load is in progress
+     */
+    bool isSceneLoading() const { return m_sceneLoading; }
+
     void resetCamera();
 
+    // Final render
+    /**
+     * @brief Start an offline render job (see QuantiloomVulkanWindow::startFinalRender)
+     *
+     * The job gets its own context on a spare graphics queue and runs on a
+     * worker thread; without a spare queue it shares Qt's queue and runs in
+     * time slices on the GUI thread. Either way the preview is throttled.
+     */
+    bool startFinalRender(const QString& outputPath, uint32_t width, uint32_t height,
+                          uint32_t spp, QString* error);
+    void setFinalRenderPaused(bool paused);
+    void stopFinalRender();
+    bool isFinalRenderActive() const { return m_finalRenderJob != nullptr; }
+
     // Render settings
+    /**
+     * @brief Set samples per frame (upper limit while adaptive SPP is on)
+     */
     void setSPP(uint32_t spp);
+
+    /**
+     * @brief Adapt samples per frame to hold a frame-time budget
+     *
+     * Uses GPU frame time when timestamps are available, otherwise the
+     * frame interval. Drops to 1 SPP while the camera or a node moves.
+     */
+    void setAdaptiveSpp(bool enabled, float budgetMs);
+    bool isAdaptiveSppEnabled() const { return m_adaptiveSppEnabled; }
+
+    /**
+     * @brief SPP used for the most recent frame
+     */
+    uint32_t currentFrameSpp() const { return m_frameSpp; }
+
+    /**
+     * @brief Stop requesting frames once accumulation has converged
+     *
+     * Any parameter change, camera move or accumulation reset resumes
+     * rendering.
+     */
+    void setConvergenceSettings(const ConvergenceSettings& settings);
+
+    /**
+     * @brief Set how the internal render size follows the window
+     *
+     * Applied at once; window resizes are applied once they settle, and
+     * accumulation is only reset when the internal size actually changes.
+     */
+    void setRenderResolution(const RenderResolutionSettings& settings);
+
+    /**
+     * @brief Size the viewport is currently traced at (empty before init)
+     */
+    QSize renderSize() const { return m_contextSize; }
+    bool isAccumulationConverged() const { return m_convergence.isConverged(); }
+
+    /**
+     * @brief Render loop activity (wakeups, idle time)
+     */
+    FrameSchedulerStats frameSchedulerStats() const { return m_scheduler.stats(); }
+
+    /**
+     * @brief Pipeline cache outcome for this device (hit/miss, warm-up time)
+     */
+    const PipelineCacheStats& pipelineCacheStats() const { return m_pipelineCache.stats(); }
+
     void setWavelength(float wavelength_nm);
     void setSpectralMode(quantiloom::SpectralMode mode);
     void setDebugMode(quantiloom::DebugVisualizationMode mode);
     void setLightingParams(const quantiloom::LightingParams& params);
-    void updateMaterial(int index, const quantiloom::Material& material);
+    const quantiloom::LightingParams& lightingParams() const { return m_lightingParams; }
+
+    // Materials
+    /**
+     * @brief Queue a material for the next frame
+     *
+     * Only the last material queued per index is uploaded, so a slider
+     * drag costs one upload per frame rather than one per value change.
+     */
+    void updateMaterial(int index, const quantiloom::Material& updated);
+
+    /**
+     * @brief Material as it will be once queued updates are applied
+     *
+     * Valid until the next updateMaterial() or frame; null if out of range.
+     */
+    const quantiloom::Material* material(int index) const;
+
+    /**
+     * @brief Upload queued materials now
+     * @return true if any material was uploaded
+     */
+    bool flushMaterials();
+
+    // Node transforms
+    /**
+     * @brief Queue a node transform for the next frame
+     *
+     * All transforms queued before a frame are applied together with a
+     * single acceleration structure rebuild (last transform per node wins).
+     */
+    void queueNodeTransform(int nodeIndex, const glm::mat4& transform);
+
+    /**
+     * @brief Apply queued node transforms now
+     *
+     * Call before reading node transforms back from the scene (e.g. on
+     * drag end). Does nothing while a scene load owns the context.
+     * @return true if any transform was applied
+     */
+    bool flushNodeTransforms();
+
+    /**
+     * @brief Apply queued node transforms and materials together
+     *
+     * Called when an edit batch closes: one acceleration structure rebuild
+     * and one accumulation reset for everything the batch queued.
+     */
+    void commitEdits();
+
+    /**
+     * @brief Request an accumulation reset
+     *
+     * Deferred like the parameter setters: any number of requests before a
+     * frame result in a single ResetAccumulation().
+     */
     void resetAccumulation();
     uint32_t currentSampleCount() const { return m_sampleCount; }
 
+    /**
+     * @brief Counters of the per-frame parameter change queue
+     */
+    const ParameterQueueStats& parameterQueueStats() const { return m_parameterStats; }
+
+    // Frame profiling (CPU spans + GPU timestamps around RenderFrame)
+    FrameProfiler& frameProfiler() { return m_profiler; }
+    const FrameProfiler& frameProfiler() const { return m_profiler; }
+
     // Camera setup from config
     void setCamera(const glm::vec3& position, const glm::vec3& lookAt,
                    const glm::vec3& up, float fovY);
@@ -74,9 +248,12 @@ public:
     // Camera info for gizmo
     void getCameraInfo(glm::vec3& position, glm::vec3& forward,
                        glm::vec3& right, glm::vec3& up) const;
+    float cameraFovY() const { return m_cameraFovY; }
 
-    // Render context access (for transform operations)
-    quantiloom::ExternalRenderContext* getRenderContext() { return m_renderContext.get(); }
+    // Render context access (for transform operations; null while a worker owns it)
+    quantiloom::ExternalRenderContext* getRenderContext() {
+        return contextReady() ? m_renderContext.get() : nullptr;
+    }
 
     // Camera control
     void updateCameraMovement(bool forward, bool backward, bool left, bool right,
@@ -95,6 +272,32 @@ public:
      */
     bool readDebugPixel(int x, int y, glm::vec4& outValue);
 
+    // readDebugPixel() charged to this frame's shared read budget
+    bool readBudgetedPixel(int x, int y, glm::vec4& outValue);
+
+    /**
+     * @brief Probe debug values at a viewport position on the next frame
+     *
+     * Repeated requests before that frame collapse into the latest one;
+     * results arrive through QuantiloomVulkanWindow::hoverProbed.
+     */
+    void requestHoverProbe(int x, int y);
+
+    /**
+     * @brief Set the probed neighbourhood (NxN, odd)
+     */
+    void setHoverProbeSize(int size) { m_hoverProbe.setSize(size); }
+    const HoverProbeStats& hoverProbeStats() const { return m_hoverProbe.stats(); }
+
+    /**
+     * @brief Track statistics over a viewport rectangle (empty rect stops)
+     *
+     * Reduced a few reads per frame; each completed sweep arrives through
+     * QuantiloomVulkanWindow::roiStatisticsUpdated.
+     */
+    void setRoi(const QRect& region);
+    void setRoiChannel(RoiChannel channel);
+
     /**
      * @brief Format debug pixel value based on current debug mode
      * @param pixel Raw pixel value from readDebugPixel
@@ -119,6 +322,21 @@ public:
      */
     std::unique_ptr<quantiloom::Image> captureDisplayImage();
 
+    /**
+     * @brief Capture the next presented frame without stalling the render loop
+     *
+     * The copy is recorded into the next frame's command buffer and the
+     * callback runs on this thread a frame or two later. Requests made
+     * before the same frame share one copy. The image is the 8-bit display
+     * image (CLAHE included); a null QImage means the capture was lost.
+     */
+    void captureDisplayImageAsync(AsyncReadbackRing::Callback callback);
+
+    /**
+     * @brief Attach the image sequence recorder (polled every frame)
+     */
+    void setSequenceCapture(SequenceCapture* capture) { m_sequenceCapture = capture; }
+
     // ========================================================================
     // Atmospheric Configuration
     // ========================================================================
@@ -201,13 +419,88 @@ public:
     bool isClaheLuminanceOnly() const { return m_claheLuminanceOnly; }
 
 private:
+    // Render parameters waiting for the next frame (bit set in m_pendingChanges)
+    enum PendingChange : uint32_t {
+        PendingCamera         = 1u << 0,
+        PendingCameraFov      = 1u << 1,
+        PendingSpp            = 1u << 2,
+        PendingWavelength     = 1u << 3,
+        PendingSpectralMode   = 1u << 4,
+        PendingDebugMode      = 1u << 5,
+        PendingLighting       = 1u << 6,
+        PendingAtmosphere     = 1u << 7,
+        PendingClahe          = 1u << 8,
+        PendingParameterMask  = (1u << 9) - 1,
+        PendingAccumulationReset = 1u << 31
+    };
+
+    void queueParameterChange(uint32_t changes, bool resetsAccumulation);
+    void applyPendingParameters();
+    void updateAdaptiveSpp();
+    void checkConvergence();
+    void markInteraction();
+
     void updateCamera(float deltaTime);
 
-    // Check if this is the first run (no pipeline cache)
-    bool isFirstRun() const;
+    // Context is usable from the GUI thread (not owned by a load worker)
+    bool contextReady() const { return m_renderContext && !m_contextBusy; }
+
+    /**
+     * @brief Wait for Qt's graphics queue before an SDK call that submits internally
+     *
+     * A context swapped in from a loader queue submits its own work (acceleration
+     * structure rebuilds, material uploads, readbacks) on that queue, unordered
+     * with frames in flight on queue 0. No-op while the context lives on queue 0.
+     */
+    void waitForGraphicsQueue();
+
+    // Async scene loading
+    void startSceneLoad(const QString& filePath);
+    void onSceneLoadFinished();
+    void completeSceneLoad();
+
+    /**
+     * @brief Internal render size for the current swapchain
+     */
+    QSize targetRenderSize() const;
 
-    // Show shader compilation progress dialog
-    void showShaderCompilationDialog();
+    /**
+     * @brief Resize the context to targetRenderSize() if it differs
+     * @return true if the context was resized (its accumulation is gone)
+     */
+    bool resizeContextToTarget();
+
+    /**
+     * @brief Apply a settled window size (render resolution timer)
+     */
+    void onRenderResizeSettled();
+    void waitForSceneLoad();
+    void applyRenderState();
+
+    // Final render job
+    void onFinalRenderFinished(bool success, const QString& message);
+    void destroyFinalRender();
+    void requestNextFrame();
+    bool wantsContinuousFrames() const;
+
+    // Rest of startNextFrame() once the context is free (also finishes a held frame)
+    void recordFrame();
+    void recordDisplayReadback(VkCommandBuffer cmd, int frameSlot, VkImage image,
+                               const QSize& size);
+    void failDisplayReadbacks();
+    void captureSequenceFrame();
+    void serviceHoverProbe();
+    void serviceRoiStatistics();
+    void notifyFirstFrame();
+
+    // Context creation / background pipeline warm-up
+    void finishContextInit();
+    void startPipelineWarmup();
+    void waitForPipelineWarmup();
+    void onPipelineWarmupFinished();
+
+    // Whether the next context creation compiles pipelines from scratch
+    bool isFirstRun() const;
 
     QuantiloomVulkanWindow* m_window;
 
@@ -216,11 +509,31 @@ private:
 
     // Frame timing
     std::chrono::high_resolution_clock::time_point m_lastFrameTime;
-    float m_lastFrameTimeMs = 0.0f;
+    FrameScheduler m_scheduler;   // Frames are requested only while there is work
+    FrameProfiler m_profiler;
+
+    // Async display readback (staging buffer per frame slot)
+    AsyncReadbackRing m_readback;
+    std::vector<AsyncReadbackRing::Callback> m_readbackRequests;  // Waiting for the next frame
+    QPointer<SequenceCapture> m_sequenceCapture;   // Owned by MainWindow
+
+    // Debug value probe under the cursor (serviced once per frame)
+    HoverProbe m_hoverProbe;
+    RoiStatistics m_roiStatistics;   // Region statistics, same per-frame pacing
+    int m_pixelReadBudget = 0;       // ReadPixelValue calls left this frame (all probes)
 
     // Accumulation state
     uint32_t m_sampleCount = 0;
     uint32_t m_targetSPP = 4;  // Default SPP for preview
+    uint32_t m_frameSpp = 4;   // Passed to SetSPP (m_targetSPP unless adaptive)
+
+    // Adaptive SPP
+    AdaptiveSppController m_adaptiveSpp;
+    bool m_adaptiveSppEnabled = false;
+    std::chrono::steady_clock::time_point m_lastInteraction;
+
+    // Convergence auto-stop
+    ConvergenceMonitor m_convergence;
 
     // Camera state
     glm::vec3 m_cameraPosition{0.0f, 1.0f, 5.0f};
@@ -266,12 +579,53 @@ private:
     int m_claheTileSize = 8;
     bool m_claheLuminanceOnly = true;
 
+    // Environment map path (re-applied to contexts created by scene loads)
+    QString m_environmentMapPath;
+
     // Initialization state
     bool m_initialized = false;
     QString m_pendingScenePath;
-    QString m_currentScenePath;  // Track loaded scene for restore after minimize
-
-    // First run shader compilation tracking
-    bool m_isFirstRun = false;
-    bool m_shaderCompilationChecked = false;
+    QString m_currentScenePath;  // Track loaded scene for reload after device loss
+    QSize m_contextSize;         // Size the live context was created / resized at
+
+    // Internal render size policy; swapchain resizes apply after the timer settles
+    RenderResolutionSettings m_renderResolution;
+    std::unique_ptr<QTimer> m_renderResizeTimer;
+
+    // Graphics family queues: [0] shared with Qt, extra ones used by scene loads
+    QVector<VkQueue> m_queues;
+    int m_liveQueueIndex = 0;    // Queue the current context was created on
+
+    // Async scene loading state
+    std::unique_ptr<QFutureWatcher<std::shared_ptr<SceneLoadResult>>> m_loadWatcher;
+    std::shared_ptr<std::atomic_bool> m_loadCancelFlag;
+    std::shared_ptr<SceneLoadResult> m_completedLoad;  // Waiting for the next frame boundary
+    QString m_loadingScenePath;
+    QString m_queuedScenePath;   // Requested while another load was running
+    bool m_sceneLoading = false;
+    bool m_contextBusy = false;  // In-place load: worker owns m_renderContext
+    bool m_frameHeld = false;    // startNextFrame() returned without frameReady()
+    bool m_resizePending = false;
+
+    // Parameter changes waiting for the next frame (PendingChange bits)
+    uint32_t m_pendingChanges = 0;
+    ParameterQueueStats m_parameterStats;
+
+    // Node transforms waiting for the next frame (node index -> transform)
+    QHash<int, glm::mat4> m_pendingNodeTransforms;
+
+    // Materials waiting for the next frame (material index -> material)
+    QHash<int, quantiloom::Material> m_pendingMaterials;
+
+    // Final render job (preview is throttled while it runs)
+    FinalRenderJob* m_finalRenderJob = nullptr;
+    std::unique_ptr<QThread> m_finalRenderThread;   // Null when sharing the GUI thread
+    std::unique_ptr<QObject> m_finalRenderReceiver;  // GUI-thread context for job signals
+
+    // Versioned pipeline cache; on a miss the first context is created on a worker
+    PipelineCacheManager m_pipelineCache;
+    std::unique_ptr<QFutureWatcher<PipelineWarmupResultPtr>> m_warmupWatcher;
+
+    // Startup trace ends at the first presented frame
+    bool m_firstFramePresented = false;
 };
@@ -7,10 +7,12 @@
 
 #include "QuantiloomVulkanWindow.hpp"
 #include "QuantiloomVulkanRenderer.hpp"
+#include "RayTracingDeviceRequirements.hpp"
 #include "../editing/SelectionManager.hpp"
 #include "../editing/TransformGizmo.hpp"
 #include "../editing/UndoStack.hpp"
 #include "../editing/Commands.hpp"
+#include "StartupTrace.hpp"
 
 #include <core/Image.hpp>
 
@@ -19,6 +21,7 @@
 #include <QWheelEvent>
 #include <QHoverEvent>
 #include <QDebug>
+#include <algorithm>
 
 #include <renderer/ExternalRenderContext.hpp>
 #include <renderer/LightingParams.hpp>
@@ -29,84 +32,47 @@
 QuantiloomVulkanWindow::QuantiloomVulkanWindow(QWindow* parent)
     : QVulkanWindow(parent)
 {
+    // Keep the device and renderer resources when the window is minimized or
+    // hidden; by default QVulkanWindow releases everything on unexpose, which
+    // would throw away the loaded scene, its acceleration structures and the
+    // accumulated image. Only swapchain changes (resize) reach the renderer now.
+    setFlags(QVulkanWindow::PersistentResources);
+
     // Request required device extensions for ray tracing
-    setDeviceExtensions({
-        // Ray tracing core extensions
-        "VK_KHR_acceleration_structure",
-        "VK_KHR_ray_tracing_pipeline",
-        "VK_KHR_ray_query",  // Required if shaders use RayQuery capability
-        "VK_KHR_deferred_host_operations",
-        // Required by ray tracing
-        "VK_KHR_buffer_device_address",
-        "VK_KHR_spirv_1_4",
-        "VK_KHR_shader_float_controls",
-        // Dynamic rendering (Vulkan 1.3 core, but request as extension for compatibility)
-        "VK_KHR_dynamic_rendering",
-        // Synchronization2 (Vulkan 1.3 core)
-        "VK_KHR_synchronization2",
-        // Maintenance extensions often required
-        "VK_KHR_maintenance3",
-        "VK_KHR_maintenance4",
-        // Descriptor indexing for bindless textures
-        "VK_EXT_descriptor_indexing",
-        // Scalar block layout
-        "VK_EXT_scalar_block_layout"
-    });
+    QByteArrayList extensions;
+    for (const char* name : requiredRayTracingDeviceExtensions()) {
+        extensions.append(QByteArray(name));
+    }
+    setDeviceExtensions(extensions);
 
     // Enable required Vulkan features for ray tracing using Qt 6.7+ API
     // Reference: https://doc.qt.io/qt-6/qvulkanwindow.html#setEnabledFeaturesModifier
     setEnabledFeaturesModifier([this](VkPhysicalDeviceFeatures2& features) {
         qDebug() << "QuantiloomVulkanWindow: Enabling ray tracing device features...";
-
-        // Initialize feature structures with sType
-        m_bufferDeviceAddressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
-        m_bufferDeviceAddressFeatures.bufferDeviceAddress = VK_TRUE;
-
-        m_accelerationStructureFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
-        m_accelerationStructureFeatures.accelerationStructure = VK_TRUE;
-
-        m_rayTracingPipelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
-        m_rayTracingPipelineFeatures.rayTracingPipeline = VK_TRUE;
-
-        m_rayQueryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR;
-        m_rayQueryFeatures.rayQuery = VK_TRUE;
-
-        m_dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
-        m_dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
-
-        m_synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
-        m_synchronization2Features.synchronization2 = VK_TRUE;
-
-        m_descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
-        m_descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
-        m_descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
-        m_descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount = VK_TRUE;
-        m_descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
-
-        m_scalarBlockLayoutFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SCALAR_BLOCK_LAYOUT_FEATURES;
-        m_scalarBlockLayoutFeatures.scalarBlockLayout = VK_TRUE;
-
-        // Build pNext chain (matches VulkanContext order):
-        // features -> bufferDeviceAddress -> accelerationStructure -> rayTracingPipeline
-        //          -> rayQuery -> dynamicRendering -> synchronization2
-        //          -> descriptorIndexing -> scalarBlockLayout
-        features.pNext = &m_bufferDeviceAddressFeatures;
-        m_bufferDeviceAddressFeatures.pNext = &m_accelerationStructureFeatures;
-        m_accelerationStructureFeatures.pNext = &m_rayTracingPipelineFeatures;
-        m_rayTracingPipelineFeatures.pNext = &m_rayQueryFeatures;
-        m_rayQueryFeatures.pNext = &m_dynamicRenderingFeatures;
-        m_dynamicRenderingFeatures.pNext = &m_synchronization2Features;
-        m_synchronization2Features.pNext = &m_descriptorIndexingFeatures;
-        m_descriptorIndexingFeatures.pNext = &m_scalarBlockLayoutFeatures;
-        m_scalarBlockLayoutFeatures.pNext = nullptr;
-
-        // Enable required Vulkan 1.0 features
-        features.features.shaderInt64 = VK_TRUE;
-        features.features.samplerAnisotropy = VK_TRUE;
-
+        m_rayTracingFeatures.enable(features);
         qDebug() << "  Ray tracing features enabled via pNext chain (including rayQuery, synchronization2)";
     });
 
+    // Request extra queues in graphics-capable families so scene loads can build
+    // and upload a new context on their own queue while Qt keeps presenting.
+    setQueueCreateInfoModifier([this](const VkQueueFamilyProperties* properties,
+                                      uint32_t queueFamilyCount,
+                                      QList<VkDeviceQueueCreateInfo>& createInfos) {
+        // Called right before vkCreateDevice; the span ends in initResources()
+        StartupTrace::begin("Vulkan device creation");
+        for (auto& info : createInfos) {
+            if (info.queueFamilyIndex >= queueFamilyCount) {
+                continue;
+            }
+            const VkQueueFamilyProperties& family = properties[info.queueFamilyIndex];
+            if (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+                info.queueCount = std::min(family.queueCount, kMaxGraphicsQueues);
+                info.pQueuePriorities = m_queuePriorities.data();
+            }
+            m_queueCounts.insert(info.queueFamilyIndex, info.queueCount);
+        }
+    });
+
     qDebug() << "QuantiloomVulkanWindow: Requested ray tracing device extensions";
 }
 
@@ -114,6 +80,11 @@ QuantiloomVulkanWindow::~QuantiloomVulkanWindow() = default;
 
 QVulkanWindowRenderer* QuantiloomVulkanWindow::createRenderer() {
     m_renderer = new QuantiloomVulkanRenderer(this);
+    m_renderer->setSequenceCapture(m_sequenceCapture);
+    m_renderer->setHoverProbeSize(m_hoverProbeSize);
+    m_renderer->setRenderResolution(m_renderResolution);
+    m_renderer->setRoiChannel(m_roiChannel);
+    m_renderer->setRoi(m_roi);
 
     // Load pending scene if set before renderer was created
     if (!m_pendingScenePath.isEmpty()) {
@@ -133,6 +104,51 @@ void QuantiloomVulkanWindow::loadScene(const QString& filePath) {
     }
 }
 
+void QuantiloomVulkanWindow::cancelSceneLoad() {
+    if (m_renderer) {
+        m_renderer->cancelSceneLoad();
+    }
+}
+
+bool QuantiloomVulkanWindow::isSceneLoading() const {
+    return m_renderer && m_renderer->isSceneLoading();
+}
+
+uint32_t QuantiloomVulkanWindow::queueCountForFamily(uint32_t queueFamilyIndex) const {
+    return m_queueCounts.value(queueFamilyIndex, 1);
+}
+
+// ============================================================================
+// Final Render
+// ============================================================================
+
+bool QuantiloomVulkanWindow::startFinalRender(const QString& outputPath, uint32_t width,
+                                              uint32_t height, uint32_t spp, QString* error) {
+    if (!m_renderer) {
+        if (error) {
+            *error = tr("Renderer not initialized");
+        }
+        return false;
+    }
+    return m_renderer->startFinalRender(outputPath, width, height, spp, error);
+}
+
+void QuantiloomVulkanWindow::setFinalRenderPaused(bool paused) {
+    if (m_renderer) {
+        m_renderer->setFinalRenderPaused(paused);
+    }
+}
+
+void QuantiloomVulkanWindow::stopFinalRender() {
+    if (m_renderer) {
+        m_renderer->stopFinalRender();
+    }
+}
+
+bool QuantiloomVulkanWindow::isFinalRenderActive() const {
+    return m_renderer && m_renderer->isFinalRenderActive();
+}
+
 void QuantiloomVulkanWindow::resetCamera() {
     if (m_renderer) {
         m_renderer->resetCamera();
@@ -152,6 +168,45 @@ void QuantiloomVulkanWindow::setSPP(uint32_t spp) {
     }
 }
 
+void QuantiloomVulkanWindow::setAdaptiveSpp(bool enabled, float budgetMs) {
+    if (m_renderer) {
+        m_renderer->setAdaptiveSpp(enabled, budgetMs);
+    }
+}
+
+uint32_t QuantiloomVulkanWindow::currentFrameSpp() const {
+    return m_renderer ? m_renderer->currentFrameSpp() : 0;
+}
+
+void QuantiloomVulkanWindow::setConvergenceSettings(const ConvergenceSettings& settings) {
+    if (m_renderer) {
+        m_renderer->setConvergenceSettings(settings);
+    }
+}
+
+bool QuantiloomVulkanWindow::isAccumulationConverged() const {
+    return m_renderer && m_renderer->isAccumulationConverged();
+}
+
+FrameSchedulerStats QuantiloomVulkanWindow::frameSchedulerStats() const {
+    return m_renderer ? m_renderer->frameSchedulerStats() : FrameSchedulerStats{};
+}
+
+PipelineCacheStats QuantiloomVulkanWindow::pipelineCacheStats() const {
+    return m_renderer ? m_renderer->pipelineCacheStats() : PipelineCacheStats{};
+}
+
+void QuantiloomVulkanWindow::setRenderResolution(const RenderResolutionSettings& settings) {
+    m_renderResolution = settings;
+    if (m_renderer) {
+        m_renderer->setRenderResolution(settings);
+    }
+}
+
+QSize QuantiloomVulkanWindow::renderSize() const {
+    return m_renderer ? m_renderer->renderSize() : QSize();
+}
+
 void QuantiloomVulkanWindow::setWavelength(float wavelength_nm) {
     if (m_renderer) {
         m_renderer->setWavelength(wavelength_nm);
@@ -162,6 +217,30 @@ uint32_t QuantiloomVulkanWindow::currentSampleCount() const {
     return m_renderer ? m_renderer->currentSampleCount() : 0;
 }
 
+ParameterQueueStats QuantiloomVulkanWindow::parameterQueueStats() const {
+    return m_renderer ? m_renderer->parameterQueueStats() : ParameterQueueStats{};
+}
+
+FrameTimingSummary QuantiloomVulkanWindow::frameTimingSummary() const {
+    return m_renderer ? m_renderer->frameProfiler().summary() : FrameTimingSummary{};
+}
+
+void QuantiloomVulkanWindow::resetFrameTimings() {
+    if (m_renderer) {
+        m_renderer->frameProfiler().reset();
+    }
+}
+
+bool QuantiloomVulkanWindow::exportFrameTimings(const QString& path, QString* error) {
+    if (!m_renderer) {
+        if (error) {
+            *error = tr("Renderer not initialized");
+        }
+        return false;
+    }
+    return m_renderer->frameProfiler().exportToFile(path, error);
+}
+
 void QuantiloomVulkanWindow::setSpectralMode(quantiloom::SpectralMode mode) {
     if (m_renderer) {
         m_renderer->setSpectralMode(mode);
@@ -180,12 +259,20 @@ void QuantiloomVulkanWindow::setLightingParams(const quantiloom::LightingParams&
     }
 }
 
-void QuantiloomVulkanWindow::updateMaterial(int index, const quantiloom::Material& material) {
+quantiloom::LightingParams QuantiloomVulkanWindow::lightingParams() const {
+    return m_renderer ? m_renderer->lightingParams() : quantiloom::CreateDefaultLightingParams();
+}
+
+void QuantiloomVulkanWindow::updateMaterial(int index, const quantiloom::Material& updated) {
     if (m_renderer) {
-        m_renderer->updateMaterial(index, material);
+        m_renderer->updateMaterial(index, updated);
     }
 }
 
+const quantiloom::Material* QuantiloomVulkanWindow::material(int index) const {
+    return m_renderer ? m_renderer->material(index) : nullptr;
+}
+
 void QuantiloomVulkanWindow::resetAccumulation() {
     if (m_renderer) {
         m_renderer->resetAccumulation();
@@ -200,6 +287,45 @@ bool QuantiloomVulkanWindow::readDebugPixel(int x, int y, glm::vec4& outValue) {
     return m_renderer ? m_renderer->readDebugPixel(x, y, outValue) : false;
 }
 
+void QuantiloomVulkanWindow::requestHoverProbe(int x, int y) {
+    if (m_renderer) {
+        m_renderer->requestHoverProbe(x, y);
+    }
+}
+
+void QuantiloomVulkanWindow::setHoverProbeSize(int size) {
+    m_hoverProbeSize = size;
+    if (m_renderer) {
+        m_renderer->setHoverProbeSize(size);
+    }
+}
+
+void QuantiloomVulkanWindow::setRoiSelectMode(bool enabled) {
+    if (!enabled) {
+        m_roiDragging = false;
+    }
+    if (m_roiSelectMode == enabled) {
+        return;
+    }
+    m_roiSelectMode = enabled;
+    emit roiSelectModeChanged(enabled);
+}
+
+void QuantiloomVulkanWindow::setRoi(const QRect& region) {
+    m_roi = region.normalized();
+    if (m_renderer) {
+        m_renderer->setRoi(m_roi);
+    }
+    emit roiChanged(m_roi);
+}
+
+void QuantiloomVulkanWindow::setRoiChannel(RoiChannel channel) {
+    m_roiChannel = channel;
+    if (m_renderer) {
+        m_renderer->setRoiChannel(channel);
+    }
+}
+
 QString QuantiloomVulkanWindow::formatDebugValue(const glm::vec4& pixel) const {
     return m_renderer ? m_renderer->formatDebugValue(pixel) : QString("--");
 }
@@ -216,6 +342,21 @@ std::unique_ptr<quantiloom::Image> QuantiloomVulkanWindow::captureDisplayImage()
     return m_renderer ? m_renderer->captureDisplayImage() : nullptr;
 }
 
+void QuantiloomVulkanWindow::setSequenceCapture(SequenceCapture* capture) {
+    m_sequenceCapture = capture;
+    if (m_renderer) {
+        m_renderer->setSequenceCapture(capture);
+    }
+}
+
+void QuantiloomVulkanWindow::captureDisplayImageAsync(AsyncReadbackRing::Callback callback) {
+    if (m_renderer) {
+        m_renderer->captureDisplayImageAsync(std::move(callback));
+    } else if (callback) {
+        callback(QImage());
+    }
+}
+
 // ============================================================================
 // Atmospheric Configuration
 // ============================================================================
@@ -270,14 +411,24 @@ void QuantiloomVulkanWindow::setEditingComponents(SelectionManager* selection,
 }
 
 void QuantiloomVulkanWindow::setNodeTransform(int nodeIndex, const glm::mat4& transform) {
-    if (!m_renderer) return;
+    if (m_renderer) {
+        m_renderer->queueNodeTransform(nodeIndex, transform);
+    }
+}
 
-    auto* ctx = m_renderer->getRenderContext();
-    if (ctx && nodeIndex >= 0) {
-        qDebug() << "QuantiloomVulkanWindow::setNodeTransform - node:" << nodeIndex;
-        ctx->SetNodeTransform(static_cast<quantiloom::u32>(nodeIndex), transform);
-        ctx->RebuildAccelerationStructure();
-        m_renderer->resetAccumulation();
+void QuantiloomVulkanWindow::flushNodeTransforms() {
+    if (m_renderer) {
+        m_renderer->flushNodeTransforms();
+    }
+}
+
+void QuantiloomVulkanWindow::beginEditBatch() {
+    m_editBatchDepth++;
+}
+
+void QuantiloomVulkanWindow::endEditBatch() {
+    if (m_editBatchDepth > 0 && --m_editBatchDepth == 0 && m_renderer) {
+        m_renderer->commitEdits();
     }
 }
 
@@ -293,6 +444,10 @@ void QuantiloomVulkanWindow::getCameraInfo(glm::vec3& position, glm::vec3& forwa
     }
 }
 
+float QuantiloomVulkanWindow::cameraFovY() const {
+    return m_renderer ? m_renderer->cameraFovY() : 45.0f;
+}
+
 void QuantiloomVulkanWindow::setEditMode(bool edit) {
     if (m_editMode != edit) {
         m_editMode = edit;
@@ -359,11 +514,13 @@ void QuantiloomVulkanWindow::keyPressEvent(QKeyEvent* event) {
     // Undo/Redo
     if (m_undoStack) {
         if (event->matches(QKeySequence::Undo)) {
+            SceneEditBatch batch(this);
             m_undoStack->undo();
             event->accept();
             return;
         }
         if (event->matches(QKeySequence::Redo)) {
+            SceneEditBatch batch(this);
             m_undoStack->redo();
             event->accept();
             return;
@@ -417,6 +574,14 @@ void QuantiloomVulkanWindow::keyReleaseEvent(QKeyEvent* event) {
 }
 
 void QuantiloomVulkanWindow::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && m_roiSelectMode) {
+        // Region selection takes the drag instead of selection / gizmo
+        m_roiDragging = true;
+        m_roiDragStart = event->position().toPoint();
+        event->accept();
+        return;
+    }
+
     if (event->button() == Qt::LeftButton) {
         // Always emit for debug value display (regardless of edit mode)
         QPointF pos = event->position();
@@ -464,6 +629,19 @@ void QuantiloomVulkanWindow::mousePressEvent(QMouseEvent* event) {
 }
 
 void QuantiloomVulkanWindow::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && m_roiDragging) {
+        const QRect region = QRect(m_roiDragStart, event->position().toPoint()).normalized();
+        setRoiSelectMode(false);
+        // A click without a drag keeps the previous region
+        if (region.width() > 1 && region.height() > 1) {
+            setRoi(region);
+        } else {
+            emit roiChanged(m_roi);
+        }
+        event->accept();
+        return;
+    }
+
     if (event->button() == Qt::LeftButton && m_transformDragging) {
         m_transformDragging = false;
         if (m_gizmo && m_gizmo->isDragging()) {
@@ -483,6 +661,13 @@ void QuantiloomVulkanWindow::mouseReleaseEvent(QMouseEvent* event) {
 }
 
 void QuantiloomVulkanWindow::mouseMoveEvent(QMouseEvent* event) {
+    if (m_roiDragging) {
+        // Preview only; statistics start on release
+        emit roiChanged(QRect(m_roiDragStart, event->position().toPoint()).normalized());
+        event->accept();
+        return;
+    }
+
     // Transform dragging has priority
     if (m_transformDragging && m_gizmo && m_gizmo->isDragging()) {
         m_gizmo->updateDrag(event->position());
@@ -9,12 +9,26 @@
 
 #include <QVulkanWindow>
 #include <QString>
+#include <QHash>
+#include <QPointer>
+#include <array>
 #include <memory>
 #include <vulkan/vulkan.h>
 
 #include <glm/glm.hpp>
 #include <core/Types.hpp>
 
+#include "RayTracingDeviceRequirements.hpp"
+#include "ParameterQueueStats.hpp"
+#include "FrameProfiler.hpp"
+#include "ConvergenceMonitor.hpp"
+#include "FrameScheduler.hpp"
+#include "AsyncReadbackRing.hpp"
+#include "HoverProbe.hpp"
+#include "RoiStatistics.hpp"
+#include "PipelineCacheManager.hpp"
+#include "RenderResolution.hpp"
+
 namespace quantiloom {
 class Scene;
 struct Material;
@@ -24,6 +38,7 @@ struct SensorParams;
 }
 
 class QuantiloomVulkanRenderer;
+class SequenceCapture;
 class SelectionManager;
 class TransformGizmo;
 class UndoStack;
@@ -49,11 +64,63 @@ public:
     QVulkanWindowRenderer* createRenderer() override;
 
     /**
-     * @brief Load a scene from file
+     * @brief Load a scene from file (asynchronous)
      * @param filePath Path to glTF or TOML scene file
      */
     void loadScene(const QString& filePath);
 
+    /**
+     * @brief Cancel the running scene load, keeping the previous scene
+     */
+    void cancelSceneLoad();
+
+    /**
+     * @brief Check whether a scene load is in progress
+     */
+    bool isSceneLoading() const;
+
+    /**
+     * @brief Number of queues created in a queue family
+     *
+     * The graphics family gets extra queues when available so scene loads
+     * can upload without sharing Qt's queue.
+     */
+    uint32_t queueCountForFamily(uint32_t queueFamilyIndex) const;
+
+    // ========================================================================
+    // Final Render
+    // ========================================================================
+
+    /**
+     * @brief Start an offline render of the current scene to an EXR file
+     *
+     * Uses a snapshot of the current camera, lighting and edits. The preview
+     * keeps running at a reduced frame rate until the job finishes.
+     * @param outputPath EXR output file
+     * @param width Output width (independent of the window size)
+     * @param height Output height
+     * @param spp Target samples per pixel
+     * @param error Receives the reason if the job cannot start
+     * @return true if the job was started
+     */
+    bool startFinalRender(const QString& outputPath, uint32_t width, uint32_t height,
+                          uint32_t spp, QString* error = nullptr);
+
+    /**
+     * @brief Pause or resume the running final render
+     */
+    void setFinalRenderPaused(bool paused);
+
+    /**
+     * @brief Cancel the running final render (no file is written)
+     */
+    void stopFinalRender();
+
+    /**
+     * @brief Check whether a final render job is running
+     */
+    bool isFinalRenderActive() const;
+
     /**
      * @brief Reset camera to default position
      */
@@ -70,6 +137,49 @@ public:
      */
     void setSPP(uint32_t spp);
 
+    /**
+     * @brief Enable adaptive samples per frame within a frame-time budget
+     *
+     * The SPP set with setSPP() becomes the upper limit.
+     */
+    void setAdaptiveSpp(bool enabled, float budgetMs);
+
+    /**
+     * @brief Get the SPP used for the most recent frame
+     */
+    uint32_t currentFrameSpp() const;
+
+    /**
+     * @brief Configure convergence auto-stop of the progressive preview
+     */
+    void setConvergenceSettings(const ConvergenceSettings& settings);
+
+    /**
+     * @brief Check whether the preview stopped because it converged
+     */
+    bool isAccumulationConverged() const;
+
+    /**
+     * @brief Get render loop activity (wakeups by reason, idle time)
+     */
+    FrameSchedulerStats frameSchedulerStats() const;
+
+    /**
+     * @brief Get the pipeline cache outcome (hit/miss counters, warm-up time)
+     */
+    PipelineCacheStats pipelineCacheStats() const;
+
+    /**
+     * @brief Set how the viewport's internal render size follows the window
+     */
+    void setRenderResolution(const RenderResolutionSettings& settings);
+    const RenderResolutionSettings& renderResolution() const { return m_renderResolution; }
+
+    /**
+     * @brief Size the viewport is traced at (empty before the context exists)
+     */
+    QSize renderSize() const;
+
     /**
      * @brief Set spectral wavelength for mono-band mode
      */
@@ -91,9 +201,19 @@ public:
     void setLightingParams(const quantiloom::LightingParams& params);
 
     /**
-     * @brief Update material at specified index
+     * @brief Current lighting parameters (defaults before the renderer exists)
      */
-    void updateMaterial(int index, const quantiloom::Material& material);
+    quantiloom::LightingParams lightingParams() const;
+
+    /**
+     * @brief Update material at specified index (uploaded with the next frame)
+     */
+    void updateMaterial(int index, const quantiloom::Material& updated);
+
+    /**
+     * @brief Material including updates not yet uploaded (may be null)
+     */
+    const quantiloom::Material* material(int index) const;
 
     /**
      * @brief Reset render accumulation
@@ -105,6 +225,27 @@ public:
      */
     uint32_t currentSampleCount() const;
 
+    /**
+     * @brief Get counters of the renderer's per-frame parameter queue
+     */
+    ParameterQueueStats parameterQueueStats() const;
+
+    /**
+     * @brief Get rolling frame timing statistics (CPU spans and GPU time)
+     */
+    FrameTimingSummary frameTimingSummary() const;
+
+    /**
+     * @brief Clear the frame timing history
+     */
+    void resetFrameTimings();
+
+    /**
+     * @brief Write the frame timing history to a .csv or .json file
+     * @param error Receives a description on failure (may be null)
+     */
+    bool exportFrameTimings(const QString& path, QString* error);
+
     /**
      * @brief Get current scene (may be null)
      */
@@ -119,6 +260,33 @@ public:
      */
     bool readDebugPixel(int x, int y, glm::vec4& outValue);
 
+    /**
+     * @brief Probe debug values on the next frame (coalesced, see hoverProbed)
+     */
+    void requestHoverProbe(int x, int y);
+
+    /**
+     * @brief Set the hover probe neighbourhood (NxN, odd)
+     */
+    void setHoverProbeSize(int size);
+
+    /**
+     * @brief Arm region selection: the next left drag defines the ROI
+     */
+    void setRoiSelectMode(bool enabled);
+    bool isRoiSelectMode() const { return m_roiSelectMode; }
+
+    /**
+     * @brief Set (or clear, with an empty rect) the statistics region
+     */
+    void setRoi(const QRect& region);
+    const QRect& roi() const { return m_roi; }
+
+    /**
+     * @brief Scalar reduced over the region
+     */
+    void setRoiChannel(RoiChannel channel);
+
     /**
      * @brief Format debug value based on current debug mode
      * @param pixel Raw pixel value
@@ -144,6 +312,19 @@ public:
      */
     std::unique_ptr<quantiloom::Image> captureDisplayImage();
 
+    /**
+     * @brief Capture the next presented frame without stalling rendering
+     *
+     * The callback receives the 8-bit display image a frame or two later
+     * (null QImage on failure).
+     */
+    void captureDisplayImageAsync(AsyncReadbackRing::Callback callback);
+
+    /**
+     * @brief Attach the image sequence recorder (checked every frame)
+     */
+    void setSequenceCapture(SequenceCapture* capture);
+
     // ========================================================================
     // Atmospheric Configuration
     // ========================================================================
@@ -209,15 +390,38 @@ public:
 
     /**
      * @brief Set node transform
+     *
+     * Batched: applied at the start of the next frame together with every
+     * other transform set since the previous frame, followed by a single
+     * acceleration structure rebuild.
      */
     void setNodeTransform(int nodeIndex, const glm::mat4& transform);
 
+    /**
+     * @brief Apply batched node transforms immediately
+     *
+     * Needed before reading transforms back from getScene().
+     */
+    void flushNodeTransforms();
+
+    /**
+     * @brief Open / close a scene edit batch (nestable, see SceneEditBatch)
+     */
+    void beginEditBatch();
+    void endEditBatch();
+    [[nodiscard]] bool inEditBatch() const { return m_editBatchDepth > 0; }
+
     /**
      * @brief Get camera info for gizmo
      */
     void getCameraInfo(glm::vec3& position, glm::vec3& forward,
                        glm::vec3& right, glm::vec3& up) const;
 
+    /**
+     * @brief Get camera vertical field of view in degrees (for picking rays)
+     */
+    float cameraFovY() const;
+
     /**
      * @brief Check if in edit mode (vs camera mode)
      */
@@ -231,7 +435,7 @@ public:
 signals:
     /**
      * @brief Emitted after each frame is rendered
-     * @param frameTimeMs Frame render time in milliseconds
+     * @param frameTimeMs Time since the previous rendered frame in milliseconds
      * @param sampleCount Current accumulated sample count
      */
     void frameRendered(float frameTimeMs, uint32_t sampleCount);
@@ -243,6 +447,77 @@ signals:
      */
     void sceneLoaded(bool success, const QString& message);
 
+    /**
+     * @brief Emitted when an asynchronous scene load starts
+     * @param filePath Scene being loaded
+     */
+    void sceneLoadStarted(const QString& filePath);
+
+    /**
+     * @brief Emitted when pipelines start compiling in the background (cache miss)
+     */
+    void pipelineWarmupStarted();
+
+    /**
+     * @brief Emitted once the render context exists and the pipeline cache is filled
+     */
+    void pipelineCacheReady(const PipelineCacheStats& stats);
+
+    /**
+     * @brief Emitted when the internal render size changes (accumulation restarts)
+     */
+    void renderSizeChanged(const QSize& size);
+
+    /**
+     * @brief Emitted once, after the first frame is handed to presentation
+     */
+    void firstFramePresented();
+
+    /**
+     * @brief Emitted as a scene load advances
+     * @param percent Progress in [0, 100]
+     * @param status Current stage description
+     */
+    void sceneLoadProgress(int percent, const QString& status);
+
+    /**
+     * @brief Emitted when a scene load was canceled (previous scene kept)
+     */
+    void sceneLoadCanceled();
+
+    /**
+     * @brief Emitted when the final render changes stage
+     * @param status Stage description (preparing, rendering, writing)
+     */
+    void finalRenderStatus(const QString& status);
+
+    /**
+     * @brief Emitted periodically while a final render accumulates
+     * @param samples Accumulated samples per pixel
+     * @param targetSpp Samples per pixel at which the job completes
+     * @param samplesPerSecond Average accumulation rate (excluding pauses)
+     */
+    void finalRenderProgress(uint32_t samples, uint32_t targetSpp, double samplesPerSecond);
+
+    /**
+     * @brief Emitted when the final render is paused or resumed
+     */
+    void finalRenderPaused(bool paused);
+
+    /**
+     * @brief Emitted when a final render completes, fails or is canceled
+     * @param success True if the EXR was written
+     * @param message Output path or error description
+     */
+    void finalRenderFinished(bool success, const QString& message);
+
+    /**
+     * @brief Emitted when the preview stops accumulating because it converged
+     * @param samples Accumulated samples at that point
+     * @param relativeChange Last measured relative change (negative: never measured)
+     */
+    void accumulationConverged(uint32_t samples, double relativeChange);
+
     /**
      * @brief Emitted when user clicks in viewport (for selection picking)
      * @param screenPos Screen position of click
@@ -261,6 +536,33 @@ signals:
      */
     void mouseHovered(int x, int y);
 
+    /**
+     * @brief Hover probe result (center first, then refined neighbourhood stats)
+     */
+    void hoverProbed(const HoverProbeResult& result);
+
+    /**
+     * @brief Emitted when region selection is armed or finished
+     */
+    void roiSelectModeChanged(bool enabled);
+
+    /**
+     * @brief Emitted while dragging and when the region is set or cleared
+     */
+    void roiChanged(const QRect& region);
+
+    /**
+     * @brief Statistics of one complete sweep over the region
+     */
+    void roiStatisticsUpdated(const RoiStats& stats);
+
+    /**
+     * @brief Emitted after a (batched) node transform was applied to the render context
+     * @param nodeIndex Scene node index
+     * @param transform New node transform
+     */
+    void nodeTransformChanged(int nodeIndex, const glm::mat4& transform);
+
 protected:
     void keyPressEvent(QKeyEvent* event) override;
     void keyReleaseEvent(QKeyEvent* event) override;
@@ -275,6 +577,16 @@ private:
 
     QuantiloomVulkanRenderer* m_renderer = nullptr;
     QString m_pendingScenePath;
+    QPointer<SequenceCapture> m_sequenceCapture;  // Handed to the renderer on creation
+    int m_hoverProbeSize = 1;
+    RenderResolutionSettings m_renderResolution;
+
+    // Region statistics (forwarded to the renderer on creation)
+    QRect m_roi;
+    RoiChannel m_roiChannel = RoiChannel::Luminance;
+    bool m_roiSelectMode = false;
+    bool m_roiDragging = false;
+    QPoint m_roiDragStart;
 
     // Camera control state
     bool m_mousePressed = false;
@@ -288,22 +600,45 @@ private:
     bool m_shiftHeld = false;
 
     // Vulkan feature structures (must persist during device creation)
-    VkPhysicalDeviceBufferDeviceAddressFeatures m_bufferDeviceAddressFeatures{};
-    VkPhysicalDeviceRayTracingPipelineFeaturesKHR m_rayTracingPipelineFeatures{};
-    VkPhysicalDeviceAccelerationStructureFeaturesKHR m_accelerationStructureFeatures{};
-    VkPhysicalDeviceDynamicRenderingFeatures m_dynamicRenderingFeatures{};
-    VkPhysicalDeviceDescriptorIndexingFeatures m_descriptorIndexingFeatures{};
-    VkPhysicalDeviceScalarBlockLayoutFeatures m_scalarBlockLayoutFeatures{};
-    VkPhysicalDeviceRayQueryFeaturesKHR m_rayQueryFeatures{};
-    VkPhysicalDeviceSynchronization2Features m_synchronization2Features{};
+    RayTracingFeatureChain m_rayTracingFeatures;
+
+    // Queue creation (priorities must persist during device creation)
+    static constexpr uint32_t kMaxGraphicsQueues = 3;
+    std::array<float, kMaxGraphicsQueues> m_queuePriorities{1.0f, 0.5f, 0.5f};
+    QHash<uint32_t, uint32_t> m_queueCounts;  // Family index -> queues created
 
     // Editing components (owned by MainWindow)
     SelectionManager* m_selection = nullptr;
     TransformGizmo* m_gizmo = nullptr;
     UndoStack* m_undoStack = nullptr;
+    int m_editBatchDepth = 0;
 
     // Edit mode state
     bool m_editMode = true;  // Default to edit mode
     bool m_transformDragging = false;
     QPointF m_transformDragStart;
 };
+
+/**
+ * @class SceneEditBatch
+ * @brief Scope whose node transform and material edits are applied together
+ *
+ * Edits made through the window inside the scope stay queued; when the
+ * outermost scope closes they are applied with one acceleration structure
+ * rebuild and one accumulation reset, and are visible through getScene().
+ */
+class SceneEditBatch {
+public:
+    explicit SceneEditBatch(QuantiloomVulkanWindow* window) : m_window(window) {
+        if (m_window) m_window->beginEditBatch();
+    }
+    ~SceneEditBatch() {
+        if (m_window) m_window->endEditBatch();
+    }
+
+    SceneEditBatch(const SceneEditBatch&) = delete;
+    SceneEditBatch& operator=(const SceneEditBatch&) = delete;
+
+private:
+    QuantiloomVulkanWindow* m_window;
+};
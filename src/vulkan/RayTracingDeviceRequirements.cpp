@@ -0,0 +1,82 @@
+/**
+ * @file RayTracingDeviceRequirements.cpp
+ * @brief Ray tracing device extension list and feature chain
+ *
+ * @author wtflmao
+ */
+
+#include "RayTracingDeviceRequirements.hpp"
+
+const std::vector<const char*>& requiredRayTracingDeviceExtensions() {
+    static const std::vector<const char*> extensions = {
+        // Ray tracing core extensions
+        "VK_KHR_acceleration_structure",
+        "VK_KHR_ray_tracing_pipeline",
+        "VK_KHR_ray_query",  // Required if shaders use RayQuery capability
+        "VK_KHR_deferred_host_operations",
+        // Required by ray tracing
+        "VK_KHR_buffer_device_address",
+        "VK_KHR_spirv_1_4",
+        "VK_KHR_shader_float_controls",
+        // Dynamic rendering (Vulkan 1.3 core, but request as extension for compatibility)
+        "VK_KHR_dynamic_rendering",
+        // Synchronization2 (Vulkan 1.3 core)
+        "VK_KHR_synchronization2",
+        // Maintenance extensions often required
+        "VK_KHR_maintenance3",
+        "VK_KHR_maintenance4",
+        // Descriptor indexing for bindless textures
+        "VK_EXT_descriptor_indexing",
+        // Scalar block layout
+        "VK_EXT_scalar_block_layout"
+    };
+    return extensions;
+}
+
+void RayTracingFeatureChain::enable(VkPhysicalDeviceFeatures2& features) {
+    // Initialize feature structures with sType
+    bufferDeviceAddress.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    bufferDeviceAddress.bufferDeviceAddress = VK_TRUE;
+
+    accelerationStructure.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR;
+    accelerationStructure.accelerationStructure = VK_TRUE;
+
+    rayTracingPipeline.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR;
+    rayTracingPipeline.rayTracingPipeline = VK_TRUE;
+
+    rayQuery.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR;
+    rayQuery.rayQuery = VK_TRUE;
+
+    dynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+    dynamicRendering.dynamicRendering = VK_TRUE;
+
+    synchronization2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+    synchronization2.synchronization2 = VK_TRUE;
+
+    descriptorIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    descriptorIndexing.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    descriptorIndexing.runtimeDescriptorArray = VK_TRUE;
+    descriptorIndexing.descriptorBindingVariableDescriptorCount = VK_TRUE;
+    descriptorIndexing.descriptorBindingPartiallyBound = VK_TRUE;
+
+    scalarBlockLayout.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SCALAR_BLOCK_LAYOUT_FEATURES;
+    scalarBlockLayout.scalarBlockLayout = VK_TRUE;
+
+    // Build pNext chain (matches VulkanContext order):
+    // features -> bufferDeviceAddress -> accelerationStructure -> rayTracingPipeline
+    //          -> rayQuery -> dynamicRendering -> synchronization2
+    //          -> descriptorIndexing -> scalarBlockLayout
+    features.pNext = &bufferDeviceAddress;
+    bufferDeviceAddress.pNext = &accelerationStructure;
+    accelerationStructure.pNext = &rayTracingPipeline;
+    rayTracingPipeline.pNext = &rayQuery;
+    rayQuery.pNext = &dynamicRendering;
+    dynamicRendering.pNext = &synchronization2;
+    synchronization2.pNext = &descriptorIndexing;
+    descriptorIndexing.pNext = &scalarBlockLayout;
+    scalarBlockLayout.pNext = nullptr;
+
+    // Enable required Vulkan 1.0 features
+    features.features.shaderInt64 = VK_TRUE;
+    features.features.samplerAnisotropy = VK_TRUE;
+}
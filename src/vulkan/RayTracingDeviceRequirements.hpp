@@ -0,0 +1,47 @@
+/**
+ * @file RayTracingDeviceRequirements.hpp
+ * @brief Device extensions and feature chain required by libQuantiloom
+ *
+ * Shared by the interactive QVulkanWindow path and the headless batch
+ * renderer so both create identical ray tracing capable devices.
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief Device extensions required for ray tracing rendering
+ */
+const std::vector<const char*>& requiredRayTracingDeviceExtensions();
+
+/**
+ * @struct RayTracingFeatureChain
+ * @brief Owns the feature structures linked into VkPhysicalDeviceFeatures2::pNext
+ *
+ * The structures must outlive device creation, so the chain is kept as a
+ * member of whoever creates the device. Not copyable (holds self pointers).
+ */
+struct RayTracingFeatureChain {
+    VkPhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddress{};
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructure{};
+    VkPhysicalDeviceRayTracingPipelineFeaturesKHR rayTracingPipeline{};
+    VkPhysicalDeviceRayQueryFeaturesKHR rayQuery{};
+    VkPhysicalDeviceDynamicRenderingFeatures dynamicRendering{};
+    VkPhysicalDeviceSynchronization2Features synchronization2{};
+    VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexing{};
+    VkPhysicalDeviceScalarBlockLayoutFeatures scalarBlockLayout{};
+
+    RayTracingFeatureChain() = default;
+    RayTracingFeatureChain(const RayTracingFeatureChain&) = delete;
+    RayTracingFeatureChain& operator=(const RayTracingFeatureChain&) = delete;
+
+    /**
+     * @brief Enable all required features and link the chain into features.pNext
+     * @param features Root features structure passed to vkCreateDevice
+     */
+    void enable(VkPhysicalDeviceFeatures2& features);
+};
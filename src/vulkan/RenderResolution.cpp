@@ -0,0 +1,26 @@
+/**
+ * @file RenderResolution.cpp
+ * @brief Viewport render resolution implementation
+ *
+ * @author wtflmao
+ */
+
+#include "RenderResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+QSize RenderResolutionSettings::renderSize(const QSize& swapChainSize) const {
+    if (swapChainSize.isEmpty()) {
+        return {};
+    }
+
+    // Keep the window's aspect ratio so the stretch to the swapchain is uniform
+    // and picking (done in window coordinates) stays exact
+    const double factor = fixedHeight > 0
+        ? static_cast<double>(fixedHeight) / swapChainSize.height()
+        : std::clamp(scale, 0.1, 1.0);
+    const int width = static_cast<int>(std::lround(swapChainSize.width() * factor));
+    const int height = static_cast<int>(std::lround(swapChainSize.height() * factor));
+    return {std::max(width, kMinDimension), std::max(height, kMinDimension)};
+}
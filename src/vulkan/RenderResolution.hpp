@@ -0,0 +1,34 @@
+/**
+ * @file RenderResolution.hpp
+ * @brief Viewport render resolution, decoupled from the swapchain
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QSize>
+
+/**
+ * @struct RenderResolutionSettings
+ * @brief How the viewport's internal render size follows the window
+ *
+ * The render context traces at this size; RenderFrame scales the result
+ * to the swapchain image. While the window is being resized the old size
+ * keeps rendering (and accumulating) and the image is stretched, and the
+ * context is reallocated once the size has settled for kSettleMs.
+ */
+struct RenderResolutionSettings {
+    static constexpr int kSettleMs = 250;
+    static constexpr int kMinDimension = 16;
+
+    double scale = 1.0;      // Of the window size, when fixedHeight is 0
+    int fixedHeight = 0;     // > 0: this many rows, width from the window aspect
+
+    bool operator==(const RenderResolutionSettings&) const = default;
+
+    /**
+     * @brief Internal render size for a swapchain size (empty if the swapchain is)
+     */
+    [[nodiscard]] QSize renderSize(const QSize& swapChainSize) const;
+};
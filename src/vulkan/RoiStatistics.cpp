@@ -0,0 +1,157 @@
+/**
+ * @file RoiStatistics.cpp
+ * @brief Region-of-interest statistics implementation
+ *
+ * @author wtflmao
+ */
+
+#include "RoiStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void RoiStatistics::setRegion(const QRect& region) {
+    m_region = region.normalized();
+    m_sweeping = false;
+    m_published = false;
+    m_values.clear();
+    m_cursor = 0;
+}
+
+void RoiStatistics::setChannel(RoiChannel channel) {
+    if (channel == m_channel) {
+        return;
+    }
+    m_channel = channel;
+    // Values already read are of the wrong channel
+    m_sweeping = false;
+    m_published = false;
+}
+
+bool RoiStatistics::hasWork(uint32_t samples) const {
+    if (!isActive()) {
+        return false;
+    }
+    if (m_sweeping || !m_published) {
+        return true;
+    }
+    // Accumulation restarted, or doubled since the last sweep
+    return samples < m_publishedSamples || samples >= std::max(1u, m_publishedSamples) * 2;
+}
+
+void RoiStatistics::restartSweep(uint32_t samples, int width, int height) {
+    m_clipped = m_region.intersected(QRect(0, 0, width, height));
+    m_columns = std::min(kMaxGrid, m_clipped.width());
+    m_rows = std::min(kMaxGrid, m_clipped.height());
+    m_values.clear();
+    m_values.reserve(static_cast<size_t>(m_columns) * static_cast<size_t>(std::max(0, m_rows)));
+    m_cursor = 0;
+    m_sweepSamples = samples;
+    m_sweeping = !m_clipped.isEmpty();
+}
+
+bool RoiStatistics::service(uint32_t samples, int width, int height, const ReadFn& read,
+                            RoiStats& stats, int maxReads) {
+    if (!hasWork(samples) || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // Accumulation restarted mid-sweep: the values read so far are stale
+    if (m_sweeping && samples < m_sweepSamples) {
+        m_sweeping = false;
+    }
+    if (!m_sweeping) {
+        restartSweep(samples, width, height);
+        if (!m_sweeping) {
+            return false;  // Region entirely outside the image
+        }
+    }
+
+    const size_t total = static_cast<size_t>(m_columns) * static_cast<size_t>(m_rows);
+    const int reads = std::min(kReadsPerFrame, maxReads);
+    for (int i = 0; i < reads && m_cursor < total; ++i, ++m_cursor) {
+        // Centre of each grid cell
+        const int col = static_cast<int>(m_cursor % static_cast<size_t>(m_columns));
+        const int row = static_cast<int>(m_cursor / static_cast<size_t>(m_columns));
+        const int x = m_clipped.left() + (2 * col + 1) * m_clipped.width() / (2 * m_columns);
+        const int y = m_clipped.top() + (2 * row + 1) * m_clipped.height() / (2 * m_rows);
+
+        glm::vec4 value(0.0f);
+        if (!read(x, y, value)) {
+            // Context busy or read failed: drop the sweep, retry at the next checkpoint
+            m_sweeping = false;
+            m_published = true;
+            m_publishedSamples = samples;
+            return false;
+        }
+        m_values.push_back(scalar(value));
+    }
+
+    if (m_cursor < total) {
+        return false;
+    }
+
+    m_sweeping = false;
+    publish(stats);
+    return true;
+}
+
+float RoiStatistics::scalar(const glm::vec4& value) const {
+    switch (m_channel) {
+        case RoiChannel::Red:
+            return value.r;
+        case RoiChannel::Green:
+            return value.g;
+        case RoiChannel::Blue:
+            return value.b;
+        case RoiChannel::Luminance:
+        default:
+            return 0.2126f * value.r + 0.7152f * value.g + 0.0722f * value.b;
+    }
+}
+
+void RoiStatistics::publish(RoiStats& stats) {
+    stats = RoiStats{};
+    stats.region = m_clipped;
+    stats.channel = m_channel;
+    stats.gridColumns = m_columns;
+    stats.gridRows = m_rows;
+    stats.count = static_cast<int>(m_values.size());
+    stats.samples = m_sweepSamples;
+    stats.sweep = ++m_sweepCount;
+
+    m_published = true;
+    m_publishedSamples = m_sweepSamples;
+
+    if (m_values.empty()) {
+        return;
+    }
+
+    // Two-pass mean / variance (a few hundred values at most)
+    const auto [minIt, maxIt] = std::minmax_element(m_values.begin(), m_values.end());
+    stats.min = *minIt;
+    stats.max = *maxIt;
+
+    double sum = 0.0;
+    for (float v : m_values) {
+        sum += v;
+    }
+    stats.mean = sum / static_cast<double>(m_values.size());
+
+    double squares = 0.0;
+    for (float v : m_values) {
+        const double d = v - stats.mean;
+        squares += d * d;
+    }
+    stats.stddev = std::sqrt(squares / static_cast<double>(m_values.size()));
+
+    const double range = stats.max - stats.min;
+    for (float v : m_values) {
+        int bin = 0;
+        if (range > 0.0) {
+            bin = static_cast<int>((v - stats.min) / range * RoiStats::kHistogramBins);
+            bin = std::clamp(bin, 0, RoiStats::kHistogramBins - 1);
+        }
+        ++stats.histogram[static_cast<size_t>(bin)];
+    }
+}
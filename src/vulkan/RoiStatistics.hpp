@@ -0,0 +1,117 @@
+/**
+ * @file RoiStatistics.hpp
+ * @brief Live statistics over a viewport rectangle (debug / spectral values)
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QRect>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @enum RoiChannel
+ * @brief Scalar reduced over the region
+ */
+enum class RoiChannel {
+    Luminance,   // Rec. 709 weights
+    Red,         // Scalar debug modes (temperature, emissivity, ...) live here
+    Green,
+    Blue
+};
+
+/**
+ * @struct RoiStats
+ * @brief Result of one complete sweep over the region
+ */
+struct RoiStats {
+    static constexpr int kHistogramBins = 32;
+
+    QRect region;
+    RoiChannel channel = RoiChannel::Luminance;
+    int gridColumns = 0;
+    int gridRows = 0;
+    int count = 0;                  // Values reduced (an estimate when below the region's pixels)
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    std::array<uint32_t, kHistogramBins> histogram{};   // Spans [min, max]
+    uint32_t samples = 0;           // Accumulated samples when the sweep started
+    uint64_t sweep = 0;             // Increments per published result
+};
+
+/**
+ * @class RoiStatistics
+ * @brief Reduces a stratified grid of readbacks over a rectangle
+ *
+ * The region is covered by up to kMaxGrid x kMaxGrid cell centres (one per
+ * pixel for small regions). Each frame service() reads up to kReadsPerFrame
+ * of them (less when the renderer's shared read budget is spent), so the
+ * per-frame cost is bounded regardless of region size and no full-frame
+ * copy is made. Larger regions are therefore estimated from the cell
+ * centres. When a sweep completes the statistics are published; the next
+ * sweep starts once the accumulated sample count has doubled (or
+ * accumulation restarted), so results follow convergence at the rate the
+ * noise actually changes. Once accumulation stops the sweeps stop too.
+ */
+class RoiStatistics {
+public:
+    /// Reads the debug value at a viewport pixel; false on failure
+    using ReadFn = std::function<bool(int x, int y, glm::vec4& value)>;
+
+    static constexpr int kMaxGrid = 16;
+    static constexpr int kReadsPerFrame = 16;
+
+    /**
+     * @brief Start tracking a region (empty rect clears)
+     */
+    void setRegion(const QRect& region);
+    void clear() { setRegion(QRect()); }
+    [[nodiscard]] const QRect& region() const { return m_region; }
+    [[nodiscard]] bool isActive() const { return !m_region.isEmpty(); }
+
+    void setChannel(RoiChannel channel);
+    [[nodiscard]] RoiChannel channel() const { return m_channel; }
+
+    /**
+     * @brief Whether service() would read anything at this sample count
+     */
+    [[nodiscard]] bool hasWork(uint32_t samples) const;
+
+    /**
+     * @brief Do this frame's reads
+     * @param width,height Readable image size (the region is clipped to it)
+     * @param maxReads Reads left in this frame's budget (capped at kReadsPerFrame)
+     * @return true if a sweep completed and stats was written
+     */
+    bool service(uint32_t samples, int width, int height, const ReadFn& read, RoiStats& stats,
+                 int maxReads = kReadsPerFrame);
+
+private:
+    void restartSweep(uint32_t samples, int width, int height);
+    float scalar(const glm::vec4& value) const;
+    void publish(RoiStats& stats);
+
+    QRect m_region;
+    RoiChannel m_channel = RoiChannel::Luminance;
+
+    // Current sweep
+    QRect m_clipped;
+    int m_columns = 0;
+    int m_rows = 0;
+    std::vector<float> m_values;
+    size_t m_cursor = 0;
+    bool m_sweeping = false;
+    uint32_t m_sweepSamples = 0;
+
+    // Last published sweep
+    bool m_published = false;
+    uint32_t m_publishedSamples = 0;
+    uint64_t m_sweepCount = 0;
+};
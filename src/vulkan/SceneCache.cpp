@@ -0,0 +1,544 @@
+/**
+ * @file SceneCache.cpp
+ * @brief Packed glTF scene cache implementation
+ *
+ * @author wtflmao
+ */
+
+#include "SceneCache.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace {
+
+constexpr quint32 kGlbMagic = 0x46546C67u;       // "glTF"
+constexpr quint32 kChunkJson = 0x4E4F534Au;      // "JSON"
+constexpr quint32 kChunkBin = 0x004E4942u;       // "BIN\0"
+constexpr qint64 kGlbMaxBytes = 0xFFFFFFFFLL;    // uint32 length field
+constexpr qint64 kPieceAlignment = 16;           // Covers every accessor component type
+constexpr qint64 kCopyChunkBytes = 4 * 1024 * 1024;
+
+qint64 alignUp(qint64 value, qint64 alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool fail(QString* error, const QString& message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+/**
+ * @brief Bytes that end up in the packed BIN chunk
+ *
+ * Either inline (decoded data URI) or a range of a file, copied while writing.
+ */
+struct Piece {
+    QByteArray inlineData;
+    QString path;
+    qint64 fileOffset = 0;
+    qint64 length = 0;
+    qint64 packedOffset = 0;
+};
+
+struct GlbSource {
+    QByteArray json;
+    qint64 binOffset = -1;   // -1: no BIN chunk
+    qint64 binLength = 0;
+};
+
+bool readGlb(const QString& path, GlbSource& glb, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(error, file.errorString());
+    }
+
+    const QByteArray header = file.read(20);
+    if (header.size() < 20) {
+        return fail(error, QObject::tr("Truncated GLB header"));
+    }
+    const auto* data = reinterpret_cast<const uchar*>(header.constData());
+    const quint32 jsonLength = qFromLittleEndian<quint32>(data + 12);
+    if (qFromLittleEndian<quint32>(data) != kGlbMagic ||
+        qFromLittleEndian<quint32>(data + 16) != kChunkJson) {
+        return fail(error, QObject::tr("Not a GLB file"));
+    }
+    glb.json = file.read(jsonLength);
+    if (glb.json.size() != static_cast<qsizetype>(jsonLength)) {
+        return fail(error, QObject::tr("Truncated GLB JSON chunk"));
+    }
+
+    const QByteArray binHeader = file.read(8);
+    if (binHeader.size() == 8) {
+        const auto* bin = reinterpret_cast<const uchar*>(binHeader.constData());
+        if (qFromLittleEndian<quint32>(bin + 4) == kChunkBin) {
+            glb.binOffset = 20 + jsonLength + 8;
+            glb.binLength = qFromLittleEndian<quint32>(bin);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode a base64 data URI ("data:<mime>;base64,<payload>")
+ */
+bool decodeDataUri(const QString& uri, QByteArray& data, QString* mimeType) {
+    const qsizetype comma = uri.indexOf(',');
+    if (comma < 0 || !uri.left(comma).endsWith(";base64")) {
+        return false;
+    }
+    if (mimeType) {
+        *mimeType = uri.mid(5, comma - 5).section(';', 0, 0);
+    }
+    data = QByteArray::fromBase64(QStringView(uri).mid(comma + 1).toLatin1());
+    return true;
+}
+
+QString imageMimeType(const QString& path) {
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == "png") {
+        return QStringLiteral("image/png");
+    }
+    if (suffix == "jpg" || suffix == "jpeg") {
+        return QStringLiteral("image/jpeg");
+    }
+    if (suffix == "ktx2") {
+        return QStringLiteral("image/ktx2");
+    }
+    if (suffix == "webp") {
+        return QStringLiteral("image/webp");
+    }
+    return {};
+}
+
+bool writeLittleEndian(QSaveFile& file, quint32 value) {
+    uchar bytes[4];
+    qToLittleEndian(value, bytes);
+    return file.write(reinterpret_cast<const char*>(bytes), 4) == 4;
+}
+
+bool writePadding(QSaveFile& file, qint64 count, char value) {
+    if (count <= 0) {
+        return true;
+    }
+    const QByteArray padding(count, value);
+    return file.write(padding) == count;
+}
+
+bool copyPiece(QSaveFile& out, const Piece& piece, QByteArray& buffer, QString* error) {
+    if (piece.path.isEmpty()) {
+        return out.write(piece.inlineData) == piece.length
+            || fail(error, out.errorString());
+    }
+
+    QFile file(piece.path);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(piece.fileOffset)) {
+        return fail(error, QObject::tr("Cannot read %1: %2").arg(piece.path, file.errorString()));
+    }
+    qint64 remaining = piece.length;
+    while (remaining > 0) {
+        const qint64 n = file.read(buffer.data(), std::min<qint64>(remaining, buffer.size()));
+        if (n <= 0) {
+            return fail(error, QObject::tr("Unexpected end of %1").arg(piece.path));
+        }
+        if (out.write(buffer.constData(), n) != n) {
+            return fail(error, out.errorString());
+        }
+        remaining -= n;
+    }
+    return true;
+}
+
+QString canonicalSource(const QString& scenePath) {
+    const QFileInfo info(scenePath);
+    const QString canonical = info.canonicalFilePath();
+    return canonical.isEmpty() ? info.absoluteFilePath() : canonical;
+}
+
+QJsonObject entryToJson(const SceneCacheEntry& entry) {
+    QJsonArray files;
+    for (const SceneCacheFile& file : entry.files) {
+        files.append(QJsonObject{
+            {"path", file.path},
+            {"size", static_cast<double>(file.size)},
+            {"modifiedMs", static_cast<double>(file.modifiedMs)}
+        });
+    }
+    return QJsonObject{
+        {"version", SceneCache::kFormatVersion},
+        {"source", canonicalSource(entry.files.first().path)},
+        {"files", files},
+        {"contentHash", QString::fromLatin1(entry.contentHash.toHex())},
+        {"packedBytes", static_cast<double>(entry.packedBytes)},
+        {"meshCount", entry.meshCount},
+        {"textureCount", entry.textureCount}
+    };
+}
+
+bool writeEntry(const SceneCacheEntry& entry) {
+    QSaveFile file(SceneCache::baseDirectory() + "/" + entry.key + "/" + SceneCache::kEntryFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(entryToJson(entry)).toJson());
+    return file.commit();
+}
+
+} // namespace
+
+bool SceneCache::isEnabled() {
+    return QSettings().value("scene_cache/enabled", true).toBool();
+}
+
+bool SceneCache::isCacheable(const QString& scenePath, const QStringList& manifestFiles,
+                             bool hasDataUris) {
+    if (scenePath.endsWith(".gltf", Qt::CaseInsensitive)) {
+        return true;
+    }
+    // A GLB is only worth packing if it references files next to it
+    return scenePath.endsWith(".glb", Qt::CaseInsensitive)
+        && (manifestFiles.size() > 1 || hasDataUris);
+}
+
+QString SceneCache::baseDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + "/Quantiloom/scenes";
+}
+
+QString SceneCache::keyFor(const QString& scenePath) {
+    const QByteArray hash = QCryptographicHash::hash(canonicalSource(scenePath).toUtf8(),
+                                                     QCryptographicHash::Sha1);
+    return QString::fromLatin1(hash.toHex().left(16));
+}
+
+QVector<SceneCacheFile> SceneCache::stampFiles(const QStringList& paths) {
+    QVector<SceneCacheFile> stamps;
+    stamps.reserve(paths.size());
+    for (const QString& path : paths) {
+        const QFileInfo info(path);
+        SceneCacheFile stamp;
+        stamp.path = path;
+        if (info.exists()) {
+            stamp.size = info.size();
+            stamp.modifiedMs = info.lastModified().toMSecsSinceEpoch();
+        }
+        stamps.append(stamp);
+    }
+    return stamps;
+}
+
+std::optional<SceneCacheEntry> SceneCache::readEntry(const QString& scenePath) {
+    const QString key = keyFor(scenePath);
+    const QString directory = baseDirectory() + "/" + key;
+
+    QFile file(directory + "/" + kEntryFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+    if (json.value("version").toInt() != kFormatVersion ||
+        json.value("source").toString() != canonicalSource(scenePath)) {
+        return std::nullopt;
+    }
+
+    SceneCacheEntry entry;
+    entry.key = key;
+    entry.packedPath = directory + "/" + kPackedFileName;
+    entry.contentHash = QByteArray::fromHex(json.value("contentHash").toString().toLatin1());
+    entry.packedBytes = static_cast<qint64>(json.value("packedBytes").toDouble());
+    entry.meshCount = json.value("meshCount").toInt(-1);
+    entry.textureCount = json.value("textureCount").toInt(-1);
+    for (const QJsonValue& value : json.value("files").toArray()) {
+        const QJsonObject object = value.toObject();
+        entry.files.append({
+            object.value("path").toString(),
+            static_cast<qint64>(object.value("size").toDouble()),
+            static_cast<qint64>(object.value("modifiedMs").toDouble())
+        });
+    }
+
+    // The packed file is written before the entry, so a mismatch means damage
+    if (entry.files.isEmpty() || QFileInfo(entry.packedPath).size() != entry.packedBytes) {
+        qWarning() << "SceneCache: Damaged entry" << key << "- removing";
+        remove(scenePath);
+        return std::nullopt;
+    }
+    return entry;
+}
+
+bool SceneCache::stampsMatch(const SceneCacheEntry& entry) {
+    QStringList paths;
+    for (const SceneCacheFile& file : entry.files) {
+        paths.append(file.path);
+    }
+    return stampFiles(paths) == entry.files;
+}
+
+void SceneCache::refreshStamps(SceneCacheEntry& entry, const QStringList& paths) {
+    entry.files = stampFiles(paths);
+    if (!entry.files.isEmpty()) {
+        writeEntry(entry);
+    }
+}
+
+void SceneCache::touch(const SceneCacheEntry& entry) {
+    // Pruning orders entries by the entry file's mtime
+    QFile::setFileTime(baseDirectory() + "/" + entry.key + "/" + kEntryFileName,
+                       QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+}
+
+bool SceneCache::store(const QString& scenePath, SceneCacheEntry& entry, QString* error) {
+    entry.key = keyFor(scenePath);
+    const QString directory = baseDirectory() + "/" + entry.key;
+    entry.packedPath = directory + "/" + kPackedFileName;
+
+    if (!QDir().mkpath(directory)) {
+        return fail(error, QObject::tr("Cannot create %1").arg(directory));
+    }
+    // Drop the old entry first so a failure below cannot leave it describing new sources
+    QFile::remove(directory + "/" + kEntryFileName);
+
+    if (!packGltf(scenePath, entry.packedPath, error)) {
+        QDir(directory).removeRecursively();
+        return false;
+    }
+    entry.packedBytes = QFileInfo(entry.packedPath).size();
+
+    if (entry.files.isEmpty() || !writeEntry(entry)) {
+        QDir(directory).removeRecursively();
+        return fail(error, QObject::tr("Cannot write cache entry"));
+    }
+
+    qDebug() << "SceneCache: Stored" << scenePath << "as" << entry.key
+             << "(" << entry.packedBytes << "bytes)";
+    prune(entry.key);
+    return true;
+}
+
+void SceneCache::remove(const QString& scenePath) {
+    QDir(baseDirectory() + "/" + keyFor(scenePath)).removeRecursively();
+}
+
+bool SceneCache::packGltf(const QString& scenePath, const QString& outPath, QString* error) {
+    // Source JSON (and BIN chunk for GLB)
+    GlbSource glb;
+    if (scenePath.endsWith(".glb", Qt::CaseInsensitive)) {
+        if (!readGlb(scenePath, glb, error)) {
+            return false;
+        }
+    } else {
+        QFile file(scenePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return fail(error, file.errorString());
+        }
+        glb.json = file.readAll();
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(glb.json).object();
+    if (root.isEmpty()) {
+        return fail(error, QObject::tr("Invalid glTF JSON"));
+    }
+    // Buffer views of these extensions address buffers directly
+    for (const QJsonValue& extension : root.value("extensionsUsed").toArray()) {
+        if (extension.toString() == "EXT_meshopt_compression" ||
+            extension.toString() == "KHR_meshopt_compression") {
+            return fail(error, QObject::tr("%1 is not supported").arg(extension.toString()));
+        }
+    }
+
+    const QDir baseDir = QFileInfo(scenePath).absoluteDir();
+    const auto resolve = [&baseDir](const QString& uri) {
+        return baseDir.filePath(QUrl::fromPercentEncoding(uri.toUtf8()));
+    };
+
+    QVector<Piece> pieces;
+    qint64 cursor = 0;
+    const auto addPiece = [&pieces, &cursor](Piece piece) {
+        cursor = alignUp(cursor, kPieceAlignment);
+        piece.packedOffset = cursor;
+        cursor += piece.length;
+        pieces.append(std::move(piece));
+        return pieces.last().packedOffset;
+    };
+
+    // Buffers: merged back to back into buffer 0
+    QJsonArray buffers = root.value("buffers").toArray();
+    QVector<qint64> bufferBase(buffers.size(), 0);
+    for (qsizetype i = 0; i < buffers.size(); ++i) {
+        const QJsonObject buffer = buffers[i].toObject();
+        const QString uri = buffer.value("uri").toString();
+        Piece piece;
+        piece.length = static_cast<qint64>(buffer.value("byteLength").toDouble());
+
+        if (uri.isEmpty()) {
+            if (glb.binOffset < 0 || piece.length > glb.binLength) {
+                return fail(error, QObject::tr("Buffer %1 has no data").arg(i));
+            }
+            piece.path = scenePath;
+            piece.fileOffset = glb.binOffset;
+        } else if (uri.startsWith("data:")) {
+            if (!decodeDataUri(uri, piece.inlineData, nullptr) ||
+                piece.inlineData.size() < piece.length) {
+                return fail(error, QObject::tr("Buffer %1 has an invalid data URI").arg(i));
+            }
+            piece.inlineData.truncate(piece.length);
+        } else {
+            piece.path = resolve(uri);
+            if (QFileInfo(piece.path).size() < piece.length) {
+                return fail(error, QObject::tr("Buffer file %1 is missing or short").arg(uri));
+            }
+        }
+        bufferBase[i] = addPiece(std::move(piece));
+    }
+
+    QJsonArray bufferViews = root.value("bufferViews").toArray();
+    for (qsizetype i = 0; i < bufferViews.size(); ++i) {
+        QJsonObject view = bufferViews[i].toObject();
+        const int buffer = view.value("buffer").toInt(-1);
+        if (buffer < 0 || buffer >= bufferBase.size()) {
+            return fail(error, QObject::tr("Buffer view %1 has an invalid buffer").arg(i));
+        }
+        view["buffer"] = 0;
+        view["byteOffset"] = static_cast<double>(bufferBase[buffer]
+            + static_cast<qint64>(view.value("byteOffset").toDouble()));
+        bufferViews[i] = view;
+    }
+
+    // Images: external and data URI images become buffer views
+    QJsonArray images = root.value("images").toArray();
+    for (qsizetype i = 0; i < images.size(); ++i) {
+        QJsonObject image = images[i].toObject();
+        const QString uri = image.value("uri").toString();
+        if (uri.isEmpty()) {
+            continue;  // Already a buffer view
+        }
+
+        Piece piece;
+        QString mimeType;
+        if (uri.startsWith("data:")) {
+            if (!decodeDataUri(uri, piece.inlineData, &mimeType)) {
+                return fail(error, QObject::tr("Image %1 has an invalid data URI").arg(i));
+            }
+            piece.length = piece.inlineData.size();
+        } else {
+            piece.path = resolve(uri);
+            mimeType = imageMimeType(piece.path);
+            piece.length = QFileInfo(piece.path).size();
+            if (mimeType.isEmpty() || !QFileInfo::exists(piece.path)) {
+                return fail(error, QObject::tr("Image %1 cannot be embedded").arg(uri));
+            }
+        }
+
+        const qint64 length = piece.length;
+        const qint64 offset = addPiece(std::move(piece));
+        bufferViews.append(QJsonObject{
+            {"buffer", 0},
+            {"byteOffset", static_cast<double>(offset)},
+            {"byteLength", static_cast<double>(length)}
+        });
+        image.remove("uri");
+        image["bufferView"] = static_cast<int>(bufferViews.size() - 1);
+        image["mimeType"] = mimeType;
+        images[i] = image;
+    }
+
+    const qint64 binLength = alignUp(cursor, 4);
+    if (binLength > 0) {
+        root["buffers"] = QJsonArray{QJsonObject{{"byteLength", static_cast<double>(cursor)}}};
+    } else {
+        root.remove("buffers");
+    }
+    if (!bufferViews.isEmpty()) {
+        root["bufferViews"] = bufferViews;
+    }
+    if (!images.isEmpty()) {
+        root["images"] = images;
+    }
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    const qint64 jsonLength = alignUp(json.size(), 4);
+    const qint64 totalLength = 12 + 8 + jsonLength + (binLength > 0 ? 8 + binLength : 0);
+    if (totalLength > kGlbMaxBytes) {
+        return fail(error, QObject::tr("Scene exceeds the 4 GB GLB limit"));
+    }
+
+    // Header, JSON chunk (space padded), BIN chunk (zero padded)
+    QSaveFile out(outPath);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return fail(error, out.errorString());
+    }
+    bool ok = writeLittleEndian(out, kGlbMagic)
+        && writeLittleEndian(out, 2)
+        && writeLittleEndian(out, static_cast<quint32>(totalLength))
+        && writeLittleEndian(out, static_cast<quint32>(jsonLength))
+        && writeLittleEndian(out, kChunkJson)
+        && out.write(json) == json.size()
+        && writePadding(out, jsonLength - json.size(), ' ');
+
+    if (ok && binLength > 0) {
+        ok = writeLittleEndian(out, static_cast<quint32>(binLength))
+            && writeLittleEndian(out, kChunkBin);
+
+        QByteArray buffer;
+        buffer.resize(kCopyChunkBytes);
+        qint64 written = 0;
+        for (const Piece& piece : pieces) {
+            if (!ok) {
+                break;
+            }
+            ok = writePadding(out, piece.packedOffset - written, '\0')
+                && copyPiece(out, piece, buffer, error);
+            written = piece.packedOffset + piece.length;
+        }
+        ok = ok && writePadding(out, binLength - written, '\0');
+    }
+
+    if (!ok) {
+        out.cancelWriting();
+        if (error && error->isEmpty()) {
+            *error = out.errorString();
+        }
+        return false;
+    }
+    return out.commit() || fail(error, out.errorString());
+}
+
+void SceneCache::prune(const QString& keepKey) {
+    QDir base(baseDirectory());
+    QFileInfoList entries = base.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+
+    // Most recently used first
+    const auto lastUsed = [](const QFileInfo& dir) {
+        return QFileInfo(dir.filePath() + "/" + kEntryFileName).lastModified();
+    };
+    std::sort(entries.begin(), entries.end(), [&](const QFileInfo& a, const QFileInfo& b) {
+        return lastUsed(a) > lastUsed(b);
+    });
+
+    qint64 totalBytes = 0;
+    for (const QFileInfo& dir : entries) {
+        totalBytes += QFileInfo(dir.filePath() + "/" + kPackedFileName).size();
+        if (totalBytes > kMaxCacheBytes && dir.fileName() != keepKey) {
+            qDebug() << "SceneCache: Removing" << dir.fileName() << "(over budget)";
+            totalBytes -= QFileInfo(dir.filePath() + "/" + kPackedFileName).size();
+            QDir(dir.filePath()).removeRecursively();
+        }
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file SceneCache.hpp
+ * @brief On-disk cache of packed glTF scenes for fast reloads
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <optional>
+
+/**
+ * @struct SceneCacheFile
+ * @brief Size and modification time of one source file
+ */
+struct SceneCacheFile {
+    QString path;
+    qint64 size = -1;
+    qint64 modifiedMs = -1;
+
+    bool operator==(const SceneCacheFile&) const = default;
+};
+
+/**
+ * @struct SceneCacheEntry
+ * @brief Cached form of one source scene
+ */
+struct SceneCacheEntry {
+    QString key;
+    QString packedPath;             // Single-file GLB to hand to the SDK
+    QVector<SceneCacheFile> files;  // Scene file first, then its dependencies
+    QByteArray contentHash;         // Over all files, in order
+    qint64 packedBytes = 0;
+    int meshCount = -1;
+    int textureCount = -1;
+};
+
+/**
+ * @class SceneCache
+ * @brief Keyed by source path; validated by file stamps, then content hash
+ *
+ * A glTF scene with external buffers and images (or base64 data URIs) is
+ * rewritten once into a single binary GLB: every buffer is merged into the
+ * BIN chunk and every image is embedded as a buffer view. Reloading the
+ * same scene then maps and pages in one contiguous file instead of opening
+ * and base64-decoding many, and the SDK parses it like any other GLB.
+ *
+ * An entry is used as is when the size and mtime of every source file
+ * match. If only the stamps changed (e.g. the files were touched or copied),
+ * the content hash computed while reading the sources decides. Entries are
+ * written atomically; a damaged entry is removed and the source is loaded.
+ *
+ * Self-contained .glb files and USD stages (already binary crate files)
+ * are not packed. Only the most recently used entries up to kMaxCacheBytes
+ * are kept. All functions are safe to call from the loader thread.
+ */
+class SceneCache {
+public:
+    static constexpr int kFormatVersion = 1;
+    static constexpr qint64 kMaxCacheBytes = 4LL * 1024 * 1024 * 1024;
+    static constexpr const char* kPackedFileName = "scene.glb";
+    static constexpr const char* kEntryFileName = "entry.json";
+
+    /**
+     * @brief Whether the cache is enabled (QSettings "scene_cache/enabled")
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Whether a scene would be packed (glTF with external or embedded URIs)
+     * @param manifestFiles Scene file plus the dependencies it references
+     */
+    static bool isCacheable(const QString& scenePath, const QStringList& manifestFiles,
+                            bool hasDataUris);
+
+    static QString baseDirectory();
+    static QString keyFor(const QString& scenePath);
+
+    /**
+     * @brief Current size and mtime of each file
+     */
+    static QVector<SceneCacheFile> stampFiles(const QStringList& paths);
+
+    /**
+     * @brief Read the entry for a scene (no validation against the sources)
+     */
+    static std::optional<SceneCacheEntry> readEntry(const QString& scenePath);
+
+    /**
+     * @brief Whether an entry's stamps still match its source files
+     */
+    static bool stampsMatch(const SceneCacheEntry& entry);
+
+    /**
+     * @brief Re-stamp an entry whose sources changed stamps but not content
+     */
+    static void refreshStamps(SceneCacheEntry& entry, const QStringList& paths);
+
+    /**
+     * @brief Mark an entry as recently used
+     */
+    static void touch(const SceneCacheEntry& entry);
+
+    /**
+     * @brief Pack a scene and write its entry
+     * @param entry files (scene file first), contentHash and counts set by the caller
+     * @return true if the entry was written
+     */
+    static bool store(const QString& scenePath, SceneCacheEntry& entry, QString* error = nullptr);
+
+    /**
+     * @brief Delete a scene's entry (damaged or unusable)
+     */
+    static void remove(const QString& scenePath);
+
+    /**
+     * @brief Write a glTF / GLB scene as one self-contained GLB
+     * @return true on success; outPath is left untouched on failure
+     */
+    static bool packGltf(const QString& scenePath, const QString& outPath, QString* error = nullptr);
+
+private:
+    static void prune(const QString& keepKey);
+};
@@ -0,0 +1,397 @@
+/**
+ * @file SceneLoader.cpp
+ * @brief Worker-thread scene loading implementation
+ *
+ * @author wtflmao
+ */
+
+#include "SceneLoader.hpp"
+#include "SceneCache.hpp"
+
+#include <scene/Scene.hpp>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QUrl>
+#include <QDebug>
+#include <QtEndian>
+
+#include <algorithm>
+#include <optional>
+
+namespace {
+
+constexpr qint64 kReadChunkBytes = 4 * 1024 * 1024;
+constexpr qint64 kPageBytes = 4096;
+
+// Progress bands (0-100)
+constexpr int kProgressPrefetchEnd = 40;
+constexpr int kProgressContextEnd = 50;
+constexpr int kProgressSceneEnd = 90;
+constexpr int kProgressDone = 100;
+
+/**
+ * @brief Files the SDK will read, plus counts parsed from the glTF JSON
+ */
+struct SceneManifest {
+    QStringList files;
+    int meshCount = -1;     // -1: unknown (USD)
+    int textureCount = -1;
+    bool hasDataUris = false;
+};
+
+QByteArray readGlbJsonChunk(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    // 12-byte header (magic, version, length) + 8-byte chunk header
+    QByteArray header = file.read(20);
+    if (header.size() < 20) {
+        return {};
+    }
+    const auto* data = reinterpret_cast<const uchar*>(header.constData());
+    const quint32 magic = qFromLittleEndian<quint32>(data);
+    const quint32 chunkLength = qFromLittleEndian<quint32>(data + 12);
+    const quint32 chunkType = qFromLittleEndian<quint32>(data + 16);
+    if (magic != 0x46546C67u || chunkType != 0x4E4F534Au) {  // "glTF", "JSON"
+        return {};
+    }
+    return file.read(chunkLength);
+}
+
+SceneManifest buildManifest(const QString& scenePath) {
+    SceneManifest manifest;
+    manifest.files.append(scenePath);
+
+    if (isUsdScenePath(scenePath)) {
+        // Sublayers and references are resolved by USD itself
+        return manifest;
+    }
+
+    QByteArray json;
+    if (scenePath.endsWith(".glb", Qt::CaseInsensitive)) {
+        json = readGlbJsonChunk(scenePath);
+    } else {
+        QFile file(scenePath);
+        if (file.open(QIODevice::ReadOnly)) {
+            json = file.readAll();
+        }
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(json).object();
+    if (root.isEmpty()) {
+        return manifest;
+    }
+
+    manifest.meshCount = root.value("meshes").toArray().size();
+    manifest.textureCount = root.value("images").toArray().size();
+
+    const QDir baseDir = QFileInfo(scenePath).absoluteDir();
+    for (const char* key : {"buffers", "images"}) {
+        for (const QJsonValue& entry : root.value(key).toArray()) {
+            const QString uri = entry.toObject().value("uri").toString();
+            if (uri.startsWith("data:")) {
+                manifest.hasDataUris = true;
+                continue;
+            }
+            if (uri.isEmpty()) {
+                continue;  // GLB binary chunk, or an image in a buffer view
+            }
+            const QString filePath = baseDir.filePath(QUrl::fromPercentEncoding(uri.toUtf8()));
+            if (!manifest.files.contains(filePath)) {
+                manifest.files.append(filePath);
+            }
+        }
+    }
+    return manifest;
+}
+
+/**
+ * @brief Read every manifest file once, reporting byte progress
+ * @param contentHash If set, fed every byte read (SceneCache validation)
+ * @return false if canceled
+ */
+bool prefetchFiles(QPromise<SceneLoadResultPtr>& promise, const SceneLoadRequest& request,
+                   const SceneManifest& manifest, qint64& bytesRead,
+                   QCryptographicHash* contentHash) {
+    qint64 totalBytes = 0;
+    for (const QString& path : manifest.files) {
+        totalBytes += QFileInfo(path).size();
+    }
+    const double totalMB = totalBytes / (1024.0 * 1024.0);
+
+    QByteArray buffer;
+    buffer.resize(kReadChunkBytes);
+    int lastProgress = -1;
+
+    for (int i = 0; i < manifest.files.size(); ++i) {
+        QFile file(manifest.files[i]);
+        if (!file.open(QIODevice::ReadOnly)) {
+            // Missing dependencies are reported by the SDK loader
+            qWarning() << "Scene prefetch: cannot open" << manifest.files[i];
+            continue;
+        }
+
+        qint64 n = 0;
+        while ((n = file.read(buffer.data(), buffer.size())) > 0) {
+            bytesRead += n;
+            if (contentHash) {
+                contentHash->addData(QByteArrayView(buffer.constData(), n));
+            }
+            if (request.isCanceled()) {
+                return false;
+            }
+
+            int progress = totalBytes > 0
+                ? static_cast<int>(kProgressPrefetchEnd * bytesRead / totalBytes)
+                : kProgressPrefetchEnd;
+            if (progress > lastProgress) {
+                lastProgress = progress;
+                promise.setProgressValueAndText(progress,
+                    QObject::tr("Reading scene files (%1/%2): %3 / %4 MB")
+                        .arg(i + 1).arg(manifest.files.size())
+                        .arg(bytesRead / (1024.0 * 1024.0), 0, 'f', 1)
+                        .arg(totalMB, 0, 'f', 1));
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Map a packed cache file and touch every page, reporting byte progress
+ * @return false if canceled
+ */
+bool prefetchMapped(QPromise<SceneLoadResultPtr>& promise, const SceneLoadRequest& request,
+                    const QString& path, qint64& bytesRead) {
+    QFile file(path);
+    const qint64 size = file.size();
+    uchar* data = file.open(QIODevice::ReadOnly) ? file.map(0, size) : nullptr;
+    if (!data) {
+        // The SDK reads it regardless
+        qWarning() << "Scene prefetch: cannot map" << path << "-" << file.errorString();
+        return true;
+    }
+
+    const double totalMB = size / (1024.0 * 1024.0);
+    const auto* pages = static_cast<const volatile uchar*>(data);
+    uchar touched = 0;
+    for (qint64 offset = 0; offset < size; offset += kPageBytes) {
+        touched ^= pages[offset];
+        if ((offset + kPageBytes) % kReadChunkBytes != 0 && offset + kPageBytes < size) {
+            continue;
+        }
+
+        bytesRead = std::min(offset + kPageBytes, size);
+        if (request.isCanceled()) {
+            file.unmap(data);
+            return false;
+        }
+        promise.setProgressValueAndText(
+            static_cast<int>(kProgressPrefetchEnd * bytesRead / std::max<qint64>(size, 1)),
+            QObject::tr("Reading cached scene: %1 / %2 MB")
+                .arg(bytesRead / (1024.0 * 1024.0), 0, 'f', 1)
+                .arg(totalMB, 0, 'f', 1));
+    }
+    Q_UNUSED(touched);
+    file.unmap(data);
+    return true;
+}
+
+quantiloom::Result<void, quantiloom::String> loadSceneFile(quantiloom::ExternalRenderContext* context,
+                                                           const QString& path) {
+    if (isUsdScenePath(path)) {
+        return context->LoadSceneFromUsd(path.toStdString());
+    }
+    return context->LoadSceneFromGltf(path.toStdString());
+}
+
+} // namespace
+
+bool isUsdScenePath(const QString& path) {
+    return path.endsWith(".usd", Qt::CaseInsensitive) ||
+           path.endsWith(".usda", Qt::CaseInsensitive) ||
+           path.endsWith(".usdc", Qt::CaseInsensitive) ||
+           path.endsWith(".usdz", Qt::CaseInsensitive);
+}
+
+void runSceneLoad(QPromise<SceneLoadResultPtr>& promise, const SceneLoadRequest& request) {
+    auto result = std::make_shared<SceneLoadResult>();
+    result->scenePath = request.scenePath;
+    result->queueIndex = request.queueIndex;
+
+    // Cancellation uses the request's flag rather than QFuture::cancel(), so the
+    // result (and any context it owns) always reaches the GUI thread
+    promise.setProgressRange(0, kProgressDone);
+
+    const auto finish = [&]() {
+        promise.addResult(result);
+    };
+    const auto canceled = [&]() {
+        result->canceled = true;
+        result->error = QObject::tr("Scene loading canceled");
+        finish();
+    };
+
+    // Stage 1: read the packed cache entry, or the scene files
+    QString loadPath = request.scenePath;
+    SceneManifest manifest;
+    QVector<SceneCacheFile> sourceStamps;
+    QCryptographicHash contentHash(QCryptographicHash::Sha1);
+    bool fillCache = false;
+
+    std::optional<SceneCacheEntry> cacheEntry;
+    if (request.useSceneCache && !isUsdScenePath(request.scenePath)) {
+        cacheEntry = SceneCache::readEntry(request.scenePath);
+    }
+
+    if (cacheEntry && SceneCache::stampsMatch(*cacheEntry)) {
+        manifest.meshCount = cacheEntry->meshCount;
+        manifest.textureCount = cacheEntry->textureCount;
+        if (!prefetchMapped(promise, request, cacheEntry->packedPath, result->bytesRead)) {
+            canceled();
+            return;
+        }
+        SceneCache::touch(*cacheEntry);
+        loadPath = cacheEntry->packedPath;
+        result->fromCache = true;
+    } else {
+        manifest = buildManifest(request.scenePath);
+        fillCache = request.useSceneCache &&
+            SceneCache::isCacheable(request.scenePath, manifest.files, manifest.hasDataUris);
+        if (fillCache) {
+            // Stamped before reading, so edits made meanwhile invalidate the entry
+            sourceStamps = SceneCache::stampFiles(manifest.files);
+        }
+        if (!prefetchFiles(promise, request, manifest, result->bytesRead,
+                           fillCache ? &contentHash : nullptr)) {
+            canceled();
+            return;
+        }
+
+        // Touched or copied, but the same bytes: keep the packed scene
+        if (fillCache && cacheEntry && cacheEntry->contentHash == contentHash.result()) {
+            SceneCache::refreshStamps(*cacheEntry, manifest.files);
+            SceneCache::touch(*cacheEntry);
+            loadPath = cacheEntry->packedPath;
+            result->fromCache = true;
+            fillCache = false;
+        }
+    }
+    if (manifest.meshCount >= 0) {
+        result->meshCount = static_cast<size_t>(manifest.meshCount);
+        result->textureCount = static_cast<size_t>(manifest.textureCount);
+    }
+
+    // Stage 2: fresh context (swap mode)
+    quantiloom::ExternalRenderContext* context = request.targetContext;
+    if (request.createContext) {
+        promise.setProgressValueAndText(kProgressPrefetchEnd + 1,
+            request.firstRun
+                ? QObject::tr("Compiling shaders (first run, may take a few minutes)...")
+                : QObject::tr("Creating render context..."));
+
+        auto created = quantiloom::ExternalRenderContext::Create(request.createParams);
+        if (!created) {
+            result->error = QObject::tr("Failed to create render context: %1")
+                .arg(QString::fromStdString(created.error()));
+            finish();
+            return;
+        }
+        result->context = std::move(created.value());
+        context = result->context.get();
+    }
+
+    if (!context) {
+        result->error = QObject::tr("Render context not initialized");
+        finish();
+        return;
+    }
+    if (request.isCanceled()) {
+        canceled();
+        return;
+    }
+
+    // Stage 3: decode and upload
+    QString decodeText;
+    if (manifest.meshCount >= 0) {
+        decodeText = QObject::tr("Decoding and uploading %1 meshes, %2 textures...")
+            .arg(manifest.meshCount).arg(manifest.textureCount);
+    } else {
+        decodeText = QObject::tr("Decoding and uploading USD stage...");
+    }
+    if (request.firstRun && !request.createContext) {
+        decodeText += QObject::tr(" (first run: compiling shaders)");
+    }
+    promise.setProgressValueAndText(kProgressContextEnd, decodeText);
+
+    auto loadResult = loadSceneFile(context, loadPath);
+    if (!loadResult && result->fromCache) {
+        // A packed scene the SDK rejects is useless; fall back to the source
+        qWarning() << "Cached scene failed to load, using the source:"
+                   << QString::fromStdString(loadResult.error());
+        SceneCache::remove(request.scenePath);
+        result->fromCache = false;
+        loadResult = loadSceneFile(context, request.scenePath);
+    }
+
+    if (!loadResult) {
+        result->error = QObject::tr("Failed to load scene: %1")
+            .arg(QString::fromStdString(loadResult.error()));
+        finish();
+        return;
+    }
+
+    if (const auto* scene = context->GetScene()) {
+        result->meshCount = scene->meshes.size();
+        result->textureCount = scene->textures.size();
+    }
+
+    // Pack for the next load (not fatal; the scene is already loaded)
+    if (fillCache && !request.isCanceled()) {
+        promise.setProgressValueAndText(kProgressSceneEnd, QObject::tr("Writing scene cache..."));
+
+        SceneCacheEntry entry;
+        entry.files = sourceStamps;
+        entry.contentHash = contentHash.result();
+        entry.meshCount = static_cast<int>(result->meshCount);
+        entry.textureCount = static_cast<int>(result->textureCount);
+        QString error;
+        if (!SceneCache::store(request.scenePath, entry, &error)) {
+            qWarning() << "Scene cache not written:" << error;
+        }
+    }
+
+    // Stage 4: environment map (not fatal, matches the synchronous path)
+    if (!request.environmentMapPath.isEmpty() && !request.isCanceled()) {
+        promise.setProgressValueAndText(kProgressSceneEnd,
+            QObject::tr("Loading environment map..."));
+
+        auto envResult = context->LoadEnvironmentMap(request.environmentMapPath.toStdString());
+        if (envResult.has_value()) {
+            result->environmentMapPath = request.environmentMapPath;
+        } else {
+            qWarning() << "Failed to load environment map:"
+                       << QString::fromStdString(envResult.error());
+        }
+    }
+
+    // A fresh context can still be thrown away; an in-place load has already
+    // replaced the old scene, so report it as loaded.
+    if (request.createContext && request.isCanceled()) {
+        canceled();
+        return;
+    }
+
+    promise.setProgressValueAndText(kProgressDone, QObject::tr("Scene loaded"));
+    result->success = true;
+    finish();
+}
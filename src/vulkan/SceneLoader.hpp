@@ -0,0 +1,89 @@
+/**
+ * @file SceneLoader.hpp
+ * @brief Worker-thread scene loading for QuantiloomVulkanRenderer
+ *
+ * @author wtflmao
+ */
+
+#pragma once
+
+#include <QPromise>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+#include <renderer/ExternalRenderContext.hpp>
+
+/**
+ * @struct SceneLoadRequest
+ * @brief Everything a worker needs to load one scene
+ *
+ * Either targetContext is set (load in place into an idle context that the
+ * GUI thread must not touch until the load finishes), or createContext is
+ * set and a fresh context is built from createParams on a dedicated queue
+ * so the current scene keeps rendering until the swap.
+ */
+struct SceneLoadRequest {
+    QString scenePath;
+    QString environmentMapPath;   // Empty: none
+    bool firstRun = false;        // No pipeline cache yet (slow shader compile)
+    bool useSceneCache = false;   // Load from / fill the packed scene cache (SceneCache)
+
+    quantiloom::ExternalRenderContext* targetContext = nullptr;
+
+    bool createContext = false;
+    quantiloom::ExternalRenderContext::InitParams createParams{};
+    int queueIndex = 0;           // Queue index within the graphics family used by createParams
+
+    // Set from the GUI thread to request cancellation
+    std::shared_ptr<std::atomic_bool> cancelFlag = std::make_shared<std::atomic_bool>(false);
+
+    bool isCanceled() const { return cancelFlag->load(std::memory_order_relaxed); }
+};
+
+/**
+ * @struct SceneLoadResult
+ * @brief Outcome of a worker scene load
+ */
+struct SceneLoadResult {
+    bool success = false;
+    bool canceled = false;
+    QString error;
+
+    QString scenePath;
+    QString environmentMapPath;   // Environment map actually loaded (empty if none)
+    bool fromCache = false;       // Loaded from the packed scene cache
+
+    // Fresh context holding the new scene (swap mode only)
+    std::unique_ptr<quantiloom::ExternalRenderContext> context;
+    int queueIndex = 0;
+
+    // Statistics for status display
+    qint64 bytesRead = 0;
+    size_t meshCount = 0;
+    size_t textureCount = 0;
+};
+
+using SceneLoadResultPtr = std::shared_ptr<SceneLoadResult>;
+
+/**
+ * @brief Load a scene on a worker thread (QtConcurrent::run entry point)
+ *
+ * Stages, each reported through the promise (range 0-100):
+ *   1. Read the scene file and its external buffers/images (glTF) so the
+ *      SDK's decode hits the page cache; progress is real bytes read.
+ *      With a valid SceneCache entry, map and page in the packed GLB instead.
+ *   2. Create a fresh render context (swap mode only).
+ *   3. Decode and upload via LoadSceneFromGltf/LoadSceneFromUsd, then pack
+ *      the scene into the cache if it had no valid entry.
+ *   4. Load the environment map.
+ *
+ * Cancellation is honoured between stages; the SDK calls themselves are
+ * not interruptible.
+ */
+void runSceneLoad(QPromise<SceneLoadResultPtr>& promise, const SceneLoadRequest& request);
+
+/**
+ * @brief Check whether a path names a USD stage (.usd/.usda/.usdc/.usdz)
+ */
+bool isUsdScenePath(const QString& path);